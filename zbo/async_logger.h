@@ -0,0 +1,562 @@
+// MIT License
+//
+// Copyright (c) 2020 Lenzebo
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#pragma once
+
+#include "cache_line.h"
+#include "contracts.h"
+#include "meta_enum.h"
+#include "named_type.h"
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <condition_variable>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <ranges>
+#include <span>
+#include <sstream>
+#include <string_view>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <climits>
+#include <poll.h>
+#include <sys/uio.h>
+
+namespace zbo {
+
+/**
+ * @brief How a type is copied into a log record on the logging thread and formatted on the background thread
+ *
+ * encode() only copies bytes, format() decodes them again and writes them to the stream. Specializations exist for
+ * integers, floating point numbers and enums, NamedTypes of those, strings and ranges of any of them, e.g.
+ * MaxSizeVector, std::array or std::span.
+ */
+template <typename T>
+struct LogArgument;
+
+namespace detail {
+
+/// enums declared with ZBO_ENUM and friends, which are logged by name
+template <typename E>
+concept MetaEnumType = std::is_enum_v<E> && requires
+{
+    metaEnum(meta_enum_internal::Tag<E>());
+};
+
+constexpr size_t countPlaceholders(std::string_view format)
+{
+    size_t count = 0;
+    for (size_t pos = format.find("{}"); pos != std::string_view::npos; pos = format.find("{}", pos + 2))
+    {
+        ++count;
+    }
+    return count;
+}
+
+/// writes format with the placeholders replaced by the encoded arguments, one after the other
+template <typename... Args>
+const std::byte* formatRecord(std::ostream& output, std::string_view format, const std::byte* arguments)
+{
+    size_t pos = 0;
+    [[maybe_unused]] const auto formatNext = [&]<typename Arg>() {
+        const size_t placeholder = format.find("{}", pos);
+        output << format.substr(pos, placeholder - pos);
+        arguments = LogArgument<Arg>::format(output, arguments);
+        pos = placeholder + 2;
+    };
+    (formatNext.template operator()<Args>(), ...);
+    output << format.substr(pos);
+    return arguments;
+}
+
+}  // namespace detail
+
+/// integers, floating point numbers and enums are copied as they are
+template <typename T>
+requires std::is_arithmetic_v<T> || std::is_enum_v<T>
+struct LogArgument<T>
+{
+    static constexpr size_t size(const T& /*value*/) noexcept { return sizeof(T); }
+    static std::byte* encode(std::byte* output, const T& value) noexcept
+    {
+        std::memcpy(output, &value, sizeof(T));
+        return output + sizeof(T);
+    }
+    static const std::byte* format(std::ostream& output, const std::byte* input)
+    {
+        T value;
+        std::memcpy(&value, input, sizeof(T));
+        if constexpr (detail::MetaEnumType<T>)
+        {
+            output << enumToString(value);
+        }
+        else if constexpr (std::is_enum_v<T>)
+        {
+            output << +static_cast<std::underlying_type_t<T>>(value);
+        }
+        else
+        {
+            output << value;
+        }
+        return input + sizeof(T);
+    }
+};
+
+/// NamedTypes are logged as their underlying value
+template <typename T>
+requires requires(const T& value)
+{
+    detail::getUnderlyingType(value);
+}
+struct LogArgument<T>
+{
+    using Underlying = LogArgument<UnderlyingType<T>>;
+    static constexpr size_t size(const T& value) noexcept { return Underlying::size(value.get()); }
+    static std::byte* encode(std::byte* output, const T& value) noexcept
+    {
+        return Underlying::encode(output, value.get());
+    }
+    static const std::byte* format(std::ostream& output, const std::byte* input)
+    {
+        return Underlying::format(output, input);
+    }
+};
+
+/// strings are copied with their length in front
+template <typename T>
+requires std::is_convertible_v<const T&, std::string_view>
+struct LogArgument<T>
+{
+    static constexpr size_t size(const T& value) noexcept { return sizeof(uint32_t) + std::string_view(value).size(); }
+    static std::byte* encode(std::byte* output, const T& value) noexcept
+    {
+        const std::string_view text(value);
+        const auto length = static_cast<uint32_t>(text.size());
+        std::memcpy(output, &length, sizeof(length));
+        std::memcpy(output + sizeof(length), text.data(), text.size());
+        return output + sizeof(length) + text.size();
+    }
+    static const std::byte* format(std::ostream& output, const std::byte* input)
+    {
+        uint32_t length = 0;
+        std::memcpy(&length, input, sizeof(length));
+        // NOLINTNEXTLINE (cppcoreguidelines-pro-type-reinterpret-cast)
+        output << std::string_view(reinterpret_cast<const char*>(input + sizeof(length)), length);
+        return input + sizeof(length) + length;
+    }
+};
+
+/// containers are copied with their size in front and written like streamContainer does
+template <typename T>
+requires std::ranges::sized_range<const T> && (!std::is_convertible_v<const T&, std::string_view>)
+struct LogArgument<T>
+{
+    using Element = LogArgument<std::ranges::range_value_t<T>>;
+    static constexpr size_t size(const T& value) noexcept
+    {
+        size_t bytes = sizeof(uint32_t);
+        for (const auto& elem : value)
+        {
+            bytes += Element::size(elem);
+        }
+        return bytes;
+    }
+    static std::byte* encode(std::byte* output, const T& value) noexcept
+    {
+        const auto count = static_cast<uint32_t>(std::ranges::size(value));
+        std::memcpy(output, &count, sizeof(count));
+        output += sizeof(count);
+        for (const auto& elem : value)
+        {
+            output = Element::encode(output, elem);
+        }
+        return output;
+    }
+    static const std::byte* format(std::ostream& output, const std::byte* input)
+    {
+        uint32_t count = 0;
+        std::memcpy(&count, input, sizeof(count));
+        input += sizeof(count);
+        output << '[';
+        for (uint32_t idx = 0; idx < count; ++idx)
+        {
+            output << (idx > 0 ? ", " : "");
+            input = Element::format(output, input);
+        }
+        output << ']';
+        return input;
+    }
+};
+
+/// a log statement in the code, its address identifies the format and the argument types of a record
+struct LogSite
+{
+    std::string_view format;
+    const std::byte* (*formatArguments)(std::ostream& output, std::string_view format, const std::byte* arguments);
+};
+
+namespace detail {
+
+/// the type an argument is logged as, e.g. const char* for string literals
+template <typename T>
+using LogType = std::decay_t<const T&>;
+
+template <typename Site, typename... Args>
+inline constexpr LogSite LOG_SITE{Site::format(), &formatRecord<Args...>};
+
+}  // namespace detail
+
+/**
+ * @brief Logger that moves formatting and writing off the logging threads
+ *
+ * A log call only copies the address of its LogSite and the raw bytes of its arguments into a ring of the calling
+ * thread, see LogArgument. A background thread formats the records of all rings, i.e. containers and enum names are
+ * only turned into text there, and writes them in batches with one writev() per round, one line per record. Lines of
+ * one thread keep their order, lines of different threads are not ordered among each other.
+ *
+ * Every thread gets a ring of its own with its first log call, which is reused by another thread after it exited.
+ * When a ring is full, e.g. because the background thread does not keep up, the record is dropped and counted.
+ * Records that cannot be written, as writev() fails with an error other than EINTR or EAGAIN, are counted as well.
+ *
+ * Usage:
+ *   AsyncLogger logger(STDERR_FILENO);
+ *   ZBO_LOG(logger, "order {} filled {} at {}", order.id, order.side, fills);
+ *
+ * writes "order 42 filled BUY at [100, 101]" some time later.
+ */
+class AsyncLogger
+{
+  public:
+    /**
+     * @param file file descriptor to write to, which is not closed by the logger
+     * @param bytesPerThread size of the ring of every thread, rounded up to a power of two
+     * @param interval how long the background thread sleeps when there is nothing to write
+     */
+    explicit AsyncLogger(int file, size_t bytesPerThread = size_t{1} << 16U,
+                         std::chrono::microseconds interval = std::chrono::milliseconds(1))
+        : file_(file), bytesPerThread_(std::bit_ceil(std::max(bytesPerThread, RECORD_ALIGNMENT))), interval_(interval)
+    {
+        thread_ = std::thread([this]() { run(); });
+    }
+    AsyncLogger(const AsyncLogger&) = delete;
+    AsyncLogger& operator=(const AsyncLogger&) = delete;
+    AsyncLogger(AsyncLogger&&) = delete;
+    AsyncLogger& operator=(AsyncLogger&&) = delete;
+
+    /// writes all remaining records, records that are logged concurrently may be lost
+    ~AsyncLogger()
+    {
+        {
+            const std::lock_guard lock(mutex_);
+            stop_ = true;
+        }
+        wakeup_.notify_one();
+        thread_.join();
+        for (const auto& ring : rings_)
+        {
+            ring->retired.store(true, std::memory_order_release);
+        }
+    }
+
+    /// prefer ZBO_LOG, which defines the Site for the call
+    template <typename Site, typename... Args>
+    void log(const Args&... args) noexcept
+    {
+        static_assert(detail::countPlaceholders(Site::format()) == sizeof...(Args),
+                      "the number of {} in the format needs to match the number of arguments");
+        write(detail::LOG_SITE<Site, detail::LogType<Args>...>, static_cast<const detail::LogType<Args>&>(args)...);
+    }
+
+    /// returns once everything that has been logged by this thread before is written
+    void flush()
+    {
+        std::unique_lock lock(mutex_);
+        const uint64_t ticket = ++flushRequested_;
+        wakeup_.notify_one();
+        flushed_.wait(lock, [this, ticket]() { return flushedTicket_ >= ticket; });
+    }
+
+    /// number of records that have been dropped, as the ring of their thread was full
+    [[nodiscard]] uint64_t droppedRecords() const noexcept { return dropped_.load(std::memory_order_relaxed); }
+    /// number of records that have been formatted, but could not be written (completely) to the file
+    [[nodiscard]] uint64_t unwrittenRecords() const noexcept { return unwritten_.load(std::memory_order_relaxed); }
+
+  private:
+    struct RecordHeader
+    {
+        uint32_t size = 0;
+        uint32_t reserved = 0;
+        /// nullptr for the padding in front of a record that would wrap around the end of the ring
+        const LogSite* site = nullptr;
+    };
+    static constexpr size_t RECORD_ALIGNMENT = sizeof(RecordHeader);
+
+    /// single producer, single consumer ring of records of one thread
+    struct Ring
+    {
+        explicit Ring(size_t bytes) : capacity(bytes), buffer(std::make_unique<std::byte[]>(bytes)) {}
+
+        alignas(CACHE_LINE_SIZE) std::atomic<uint64_t> tail{0};
+        uint64_t cachedHead = 0;
+        alignas(CACHE_LINE_SIZE) std::atomic<uint64_t> head{0};
+        const size_t capacity;
+        std::unique_ptr<std::byte[]> buffer;
+        std::atomic<bool> taken{true};
+        std::atomic<bool> retired{false};
+    };
+
+    /// the rings of one thread in all loggers, which are given back when the thread exits
+    struct ThreadRings
+    {
+        ThreadRings() = default;
+        ThreadRings(const ThreadRings&) = delete;
+        ThreadRings& operator=(const ThreadRings&) = delete;
+        ~ThreadRings()
+        {
+            for (const auto& [loggerId, ring] : rings)
+            {
+                ring->taken.store(false, std::memory_order_release);
+            }
+        }
+
+        std::vector<std::pair<uint64_t, std::shared_ptr<Ring>>> rings;
+    };
+
+    template <typename... Args>
+    void write(const LogSite& site, const Args&... args) noexcept
+    {
+        const size_t payload = sizeof(RecordHeader) + (LogArgument<Args>::size(args) + ... + 0);
+        const size_t size = (payload + RECORD_ALIGNMENT - 1) & ~(RECORD_ALIGNMENT - 1);
+        Ring& ring = ringOfThisThread();
+        const uint64_t tail = ring.tail.load(std::memory_order_relaxed);
+        const size_t offset = tail & (ring.capacity - 1);
+        const size_t padding = offset + size > ring.capacity ? ring.capacity - offset : 0;
+        if (tail + padding + size - ring.cachedHead > ring.capacity) ZBO_UNLIKELY
+            {
+                ring.cachedHead = ring.head.load(std::memory_order_acquire);
+                if (tail + padding + size - ring.cachedHead > ring.capacity)
+                {
+                    dropped_.fetch_add(1, std::memory_order_relaxed);
+                    return;
+                }
+            }
+        if (padding > 0)
+        {
+            const RecordHeader skip{static_cast<uint32_t>(padding), 0, nullptr};
+            std::memcpy(ring.buffer.get() + offset, &skip, sizeof(skip));
+        }
+        std::byte* record = ring.buffer.get() + ((offset + padding) & (ring.capacity - 1));
+        const RecordHeader header{static_cast<uint32_t>(size), 0, &site};
+        std::memcpy(record, &header, sizeof(header));
+        [[maybe_unused]] std::byte* output = record + sizeof(header);
+        ((output = LogArgument<Args>::encode(output, args)), ...);
+        ring.tail.store(tail + padding + size, std::memory_order_release);
+    }
+
+    Ring& ringOfThisThread()
+    {
+        for (const auto& [loggerId, ring] : threadRings_.rings)
+        {
+            if (loggerId == id_)
+            {
+                return *ring;
+            }
+        }
+        return claimRing();
+    }
+
+    Ring& claimRing()
+    {
+        auto& rings = threadRings_.rings;
+        std::erase_if(rings, [](const auto& entry) { return entry.second->retired.load(std::memory_order_acquire); });
+        const std::lock_guard lock(mutex_);
+        auto it = std::find_if(rings_.begin(), rings_.end(),
+                               [](const auto& ring) { return !ring->taken.exchange(true, std::memory_order_acquire); });
+        if (it == rings_.end())
+        {
+            it = rings_.insert(rings_.end(), std::make_shared<Ring>(bytesPerThread_));
+        }
+        rings.emplace_back(id_, *it);
+        return **it;
+    }
+
+    void run()
+    {
+        std::vector<std::shared_ptr<Ring>> rings;
+        std::vector<std::ostringstream> texts;
+        std::unique_lock lock(mutex_);
+        while (true)
+        {
+            const uint64_t ticket = flushRequested_;
+            const bool stopping = stop_;
+            rings = rings_;
+            lock.unlock();
+
+            texts.resize(rings.size());
+            for (size_t idx = 0; idx < rings.size(); ++idx)
+            {
+                texts[idx].str({});
+                formatRecords(*rings[idx], texts[idx]);
+            }
+            writeTexts(texts);
+
+            lock.lock();
+            flushedTicket_ = ticket;
+            flushed_.notify_all();
+            if (stopping)
+            {
+                return;
+            }
+            wakeup_.wait_for(lock, interval_, [this, ticket]() { return stop_ || flushRequested_ != ticket; });
+        }
+    }
+
+    static void formatRecords(Ring& ring, std::ostream& output)
+    {
+        uint64_t head = ring.head.load(std::memory_order_relaxed);
+        const uint64_t tail = ring.tail.load(std::memory_order_acquire);
+        while (head != tail)
+        {
+            const std::byte* record = ring.buffer.get() + (head & (ring.capacity - 1));
+            RecordHeader header;
+            std::memcpy(&header, record, sizeof(header));
+            if (header.site != nullptr)
+            {
+                header.site->formatArguments(output, header.site->format, record + sizeof(header));
+                output << '\n';
+            }
+            head += header.size;
+        }
+        ring.head.store(head, std::memory_order_release);
+    }
+
+    void writeTexts(const std::vector<std::ostringstream>& texts)
+    {
+        std::vector<iovec> chunks;
+        for (const auto& text : texts)
+        {
+            const std::string_view view = text.view();
+            if (!view.empty())
+            {
+                // NOLINTNEXTLINE (cppcoreguidelines-pro-type-const-cast) writev does not write to the chunks
+                chunks.push_back(iovec{const_cast<char*>(view.data()), view.size()});
+            }
+        }
+        size_t first = 0;
+        while (first < chunks.size())
+        {
+            const int count = static_cast<int>(std::min<size_t>(chunks.size() - first, IOV_MAX));
+            ssize_t written = ::writev(file_, &chunks[first], count);
+            if (written < 0)
+            {
+                if (errno == EINTR || (errno == EAGAIN && waitUntilWritable()))
+                {
+                    continue;
+                }
+                unwritten_.fetch_add(countLines(std::span(chunks).subspan(first)), std::memory_order_relaxed);
+                return;
+            }
+            // continues after a partial write
+            while (first < chunks.size() && static_cast<size_t>(written) >= chunks[first].iov_len)
+            {
+                written -= static_cast<ssize_t>(chunks[first].iov_len);
+                ++first;
+            }
+            if (first < chunks.size())
+            {
+                chunks[first].iov_base = static_cast<char*>(chunks[first].iov_base) + written;
+                chunks[first].iov_len -= static_cast<size_t>(written);
+            }
+        }
+    }
+
+    /// waits for a non-blocking file to accept more data, returns false if it never will
+    [[nodiscard]] bool waitUntilWritable() const noexcept
+    {
+        pollfd request{file_, POLLOUT, 0};
+        int ready = 0;
+        do
+        {
+            ready = ::poll(&request, 1, -1);
+        } while (ready < 0 && errno == EINTR);
+        // NOLINTNEXTLINE (hicpp-signed-bitwise)
+        return ready > 0 && (request.revents & (POLLERR | POLLHUP | POLLNVAL)) == 0;
+    }
+
+    /// lines, i.e. records, in the chunks that are left to write, including a partially written one
+    static uint64_t countLines(std::span<const iovec> chunks) noexcept
+    {
+        uint64_t lines = 0;
+        for (const iovec& chunk : chunks)
+        {
+            const auto* begin = static_cast<const char*>(chunk.iov_base);
+            lines += static_cast<uint64_t>(std::count(begin, begin + chunk.iov_len, '\n'));
+        }
+        return lines;
+    }
+
+    static inline std::atomic<uint64_t> nextId_{0};
+    static inline thread_local ThreadRings threadRings_;
+
+    const int file_;
+    const size_t bytesPerThread_;
+    const std::chrono::microseconds interval_;
+    /// identifies the logger in threadRings_, as the address of a destroyed logger may be reused
+    const uint64_t id_ = nextId_.fetch_add(1, std::memory_order_relaxed);
+    std::atomic<uint64_t> dropped_{0};
+    std::atomic<uint64_t> unwritten_{0};
+
+    std::mutex mutex_;
+    std::condition_variable wakeup_;
+    std::condition_variable flushed_;
+    std::vector<std::shared_ptr<Ring>> rings_;
+    uint64_t flushRequested_ = 0;
+    uint64_t flushedTicket_ = 0;
+    bool stop_ = false;
+    std::thread thread_;
+};
+
+}  // namespace zbo
+
+/// logs the arguments with format, in which every {} is replaced by the next argument, see AsyncLogger
+// NOLINTNEXTLINE (cppcoreguidelines-macro-usage)
+#define ZBO_LOG(logger, formatString, ...)                                             \
+    do                                                                                 \
+    {                                                                                  \
+        struct ZboLogSite                                                              \
+        {                                                                              \
+            static constexpr std::string_view format() { return formatString; }        \
+        };                                                                             \
+        (logger).template log<ZboLogSite>(__VA_ARGS__);                                \
+    } while (false)
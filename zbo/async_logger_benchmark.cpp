@@ -0,0 +1,92 @@
+#include "async_logger.h"
+
+#include "max_size_vector.h"
+#include "stream_container.h"
+
+#include <benchmark/benchmark.h>
+
+#include <fstream>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace zbo::bench {
+
+ZBO_ENUM_CLASS(Side, uint8_t, BUY, SELL)
+using OrderId = NamedType<int64_t, struct OrderIdTag>;
+
+const MaxSizeVector<int, 8> FILLS{100, 101, 102, 103};
+/// the background thread is paused with the timing, so that no record is dropped and all are counted
+constexpr int64_t FLUSH_EVERY = 4096;
+
+void flushUntimed(benchmark::State& state, AsyncLogger& logger, int64_t idx)
+{
+    if (idx % FLUSH_EVERY == 0)
+    {
+        state.PauseTiming();
+        logger.flush();
+        state.ResumeTiming();
+    }
+}
+
+/// how the hot threads log today: formatting inline into a buffered std::ostream
+void syncNumber(benchmark::State& state)
+{
+    std::ofstream output("/dev/null");
+    int64_t idx = 0;
+    for (auto _ : state)
+    {
+        output << "tick " << idx++ << '\n';
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+void syncOrder(benchmark::State& state)
+{
+    std::ofstream output("/dev/null");
+    int64_t idx = 0;
+    for (auto _ : state)
+    {
+        output << "order " << OrderId(idx++).get() << ' ' << zbo::enumToString(Side::SELL) << ' ';
+        streamContainer(output, FILLS) << " at " << 99.5 << '\n';
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+/// only the cost on the logging thread, the background thread formats and writes to /dev/null
+void asyncNumber(benchmark::State& state)
+{
+    static AsyncLogger logger(::open("/dev/null", O_WRONLY), size_t{1} << 20U);
+    const uint64_t dropped = logger.droppedRecords();
+    int64_t idx = 0;
+    for (auto _ : state)
+    {
+        ZBO_LOG(logger, "tick {}", idx++);
+        flushUntimed(state, logger, idx);
+    }
+    state.SetItemsProcessed(state.iterations());
+    state.counters["dropped"] = static_cast<double>(logger.droppedRecords() - dropped);
+}
+
+void asyncOrder(benchmark::State& state)
+{
+    static AsyncLogger logger(::open("/dev/null", O_WRONLY), size_t{1} << 20U);
+    const uint64_t dropped = logger.droppedRecords();
+    int64_t idx = 0;
+    for (auto _ : state)
+    {
+        ZBO_LOG(logger, "order {} {} {} at {}", OrderId(idx++), Side::SELL, FILLS, 99.5);
+        flushUntimed(state, logger, idx);
+    }
+    state.SetItemsProcessed(state.iterations());
+    state.counters["dropped"] = static_cast<double>(logger.droppedRecords() - dropped);
+}
+
+BENCHMARK(syncNumber);
+BENCHMARK(syncOrder);
+BENCHMARK(asyncNumber)->Threads(1)->Threads(4);
+BENCHMARK(asyncOrder)->Threads(1)->Threads(4);
+
+}  // namespace zbo::bench
+
+BENCHMARK_MAIN();
@@ -0,0 +1,181 @@
+#include "async_logger.h"
+
+#include "max_size_vector.h"
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace zbo::test {
+
+ZBO_ENUM_CLASS(Side, uint8_t, BUY, SELL)
+enum class Plain : uint8_t
+{
+    A = 3
+};
+struct Price : NamedType<double, Price>
+{
+    using NamedType::NamedType;
+};
+using OrderId = NamedType<int64_t, struct OrderIdTag>;
+
+/// a file the logger writes to, which is read back by the test
+class LogFile
+{
+  public:
+    explicit LogFile(const std::string& name) : path_(testing::TempDir() + name)
+    {
+        // NOLINTNEXTLINE (hicpp-signed-bitwise)
+        file_ = ::open(path_.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    }
+    LogFile(const LogFile&) = delete;
+    LogFile& operator=(const LogFile&) = delete;
+    ~LogFile() { ::close(file_); }
+
+    [[nodiscard]] int file() const { return file_; }
+    [[nodiscard]] std::vector<std::string> lines() const
+    {
+        std::ifstream input(path_);
+        std::vector<std::string> lines;
+        for (std::string line; std::getline(input, line);)
+        {
+            lines.push_back(line);
+        }
+        return lines;
+    }
+
+  private:
+    std::string path_;
+    int file_ = -1;
+};
+
+TEST(AsyncLogger, FormatsArguments)
+{
+    const LogFile log("async_logger_test_format.log");
+    AsyncLogger logger(log.file());
+    const MaxSizeVector<int, 4> fills{100, 101};
+    const std::array<Side, 2> sides{Side::SELL, Side::BUY};
+    const std::string venue = "XETRA";
+
+    ZBO_LOG(logger, "no arguments");
+    ZBO_LOG(logger, "order {} {} {} at {} on {}", OrderId(42), Side::BUY, fills, Price(99.5), venue);
+    ZBO_LOG(logger, "{}{}", "literal", -7);
+    ZBO_LOG(logger, "{} {} {} {}", sides, Plain::A, std::vector<int>{}, true);
+    logger.flush();
+
+    const std::vector<std::string> expected{"no arguments", "order 42 BUY [100, 101] at 99.5 on XETRA", "literal-7",
+                                            "[SELL, BUY] 3 [] 1"};
+    ASSERT_EQ(log.lines(), expected);
+    ASSERT_EQ(logger.droppedRecords(), 0);
+}
+
+TEST(AsyncLogger, KeepsTheOrderOfEveryThread)
+{
+    constexpr int NUM_THREADS = 4;
+    constexpr int NUM_LINES = 2000;
+    const LogFile log("async_logger_test_threads.log");
+    {
+        // small rings that wrap many times
+        AsyncLogger logger(log.file(), 1024, std::chrono::microseconds(10));
+        std::vector<std::thread> threads;
+        for (int thread = 0; thread < NUM_THREADS; ++thread)
+        {
+            threads.emplace_back([&logger, thread]() {
+                for (int line = 0; line < NUM_LINES; ++line)
+                {
+                    ZBO_LOG(logger, "{} {}", thread, line);
+                    if (line % 16 == 0)
+                    {
+                        logger.flush();
+                    }
+                }
+            });
+        }
+        for (auto& thread : threads)
+        {
+            thread.join();
+        }
+        logger.flush();
+        ASSERT_EQ(logger.droppedRecords(), 0);
+    }
+
+    std::map<int, int> nextLine;
+    for (const auto& text : log.lines())
+    {
+        std::istringstream stream(text);
+        int thread = 0;
+        int line = 0;
+        stream >> thread >> line;
+        ASSERT_EQ(line, nextLine[thread]++) << text;
+    }
+    for (int thread = 0; thread < NUM_THREADS; ++thread)
+    {
+        ASSERT_EQ(nextLine[thread], NUM_LINES);
+    }
+}
+
+TEST(AsyncLogger, DropsRecordsWhenTheRingIsFull)
+{
+    constexpr int NUM_LINES = 100;
+    const LogFile log("async_logger_test_dropped.log");
+    AsyncLogger logger(log.file(), 256, std::chrono::hours(1));
+    for (int line = 0; line < NUM_LINES; ++line)
+    {
+        ZBO_LOG(logger, "line {}", line);
+    }
+    ASSERT_GT(logger.droppedRecords(), 0);
+    logger.flush();
+    ASSERT_EQ(log.lines().size() + logger.droppedRecords(), NUM_LINES);
+    ASSERT_EQ(log.lines().front(), "line 0");
+
+    // the ring is empty again after writing
+    ZBO_LOG(logger, "line {}", NUM_LINES);
+    logger.flush();
+    ASSERT_EQ(log.lines().back(), "line 100");
+}
+
+TEST(AsyncLogger, CountsRecordsThatCannotBeWritten)
+{
+    constexpr int NUM_LINES = 10;
+    const LogFile log("async_logger_test_unwritten.log");
+    // writing to a file that is only open for reading fails
+    const std::string path = testing::TempDir() + "async_logger_test_unwritten.log";
+    const int readOnly = ::open(path.c_str(), O_RDONLY);
+    ASSERT_GE(readOnly, 0);
+    {
+        AsyncLogger logger(readOnly, 4096, std::chrono::hours(1));
+        for (int line = 0; line < NUM_LINES; ++line)
+        {
+            ZBO_LOG(logger, "line {}", line);
+        }
+        logger.flush();
+        ASSERT_EQ(logger.droppedRecords(), 0);
+        ASSERT_EQ(logger.unwrittenRecords(), NUM_LINES);
+    }
+    ::close(readOnly);
+    ASSERT_TRUE(log.lines().empty());
+}
+
+TEST(AsyncLogger, WritesRemainingRecordsWhenDestroyed)
+{
+    const LogFile log("async_logger_test_destroyed.log");
+    {
+        AsyncLogger logger(log.file(), 4096, std::chrono::hours(1));
+        std::thread([&logger]() { ZBO_LOG(logger, "from a thread that exited"); }).join();
+        // takes over the ring of the exited thread
+        std::thread([&logger]() { ZBO_LOG(logger, "from the next thread"); }).join();
+    }
+    const std::vector<std::string> expected{"from a thread that exited", "from the next thread"};
+    ASSERT_EQ(log.lines(), expected);
+}
+
+}  // namespace zbo::test
@@ -0,0 +1,429 @@
+// MIT License
+//
+// Copyright (c) 2020 Lenzebo
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include "contracts.h"
+
+#include <array>
+#include <bit>
+#include <chrono>
+#include <cstdint>
+#include <iterator>
+#include <type_traits>
+#include <vector>
+
+namespace zbo {
+
+namespace detail {
+/// appends bit fields most significant bit first to zero initialized words
+class BitWriter
+{
+  public:
+    BitWriter(uint64_t* words, uint32_t& bits) : words_(words), bits_(bits) {}
+
+    /// writes the lowest numBits (1 to 64) bits of value
+    void write(uint64_t value, unsigned numBits) noexcept
+    {
+        const unsigned offset = bits_ % 64;
+        uint64_t* word = words_ + bits_ / 64;
+        *word |= (value << (64 - numBits)) >> offset;
+        if (offset + numBits > 64)
+        {
+            *(word + 1) |= value << (128 - offset - numBits);
+        }
+        bits_ += numBits;
+    }
+
+  private:
+    uint64_t* words_;
+    uint32_t& bits_;
+};
+
+/// reads the bit fields written by BitWriter
+class BitReader
+{
+  public:
+    BitReader() = default;
+    explicit BitReader(const uint64_t* words) : words_(words) {}
+
+    /// reads numBits (1 to 64) bits
+    uint64_t read(unsigned numBits) noexcept
+    {
+        const unsigned offset = position_ % 64;
+        const uint64_t* word = words_ + position_ / 64;
+        uint64_t result = *word << offset;
+        if (offset + numBits > 64)
+        {
+            result |= *(word + 1) >> (64 - offset);
+        }
+        position_ += numBits;
+        return result >> (64 - numBits);
+    }
+
+    bool readBit() noexcept { return read(1) != 0; }
+
+  private:
+    const uint64_t* words_ = nullptr;
+    uint64_t position_ = 0;
+};
+
+// timestamps are subtracted and added with wrap around, so deltas between extreme time points are not undefined
+[[nodiscard]] constexpr int64_t wrappingSub(int64_t lhs, int64_t rhs) noexcept
+{
+    return static_cast<int64_t>(static_cast<uint64_t>(lhs) - static_cast<uint64_t>(rhs));
+}
+[[nodiscard]] constexpr int64_t wrappingAdd(int64_t lhs, int64_t rhs) noexcept
+{
+    return static_cast<int64_t>(static_cast<uint64_t>(lhs) + static_cast<uint64_t>(rhs));
+}
+
+[[nodiscard]] constexpr uint64_t zigZagEncode(int64_t value) noexcept
+{
+    return (static_cast<uint64_t>(value) << 1U) ^ static_cast<uint64_t>(value >> 63);
+}
+[[nodiscard]] constexpr int64_t zigZagDecode(uint64_t value) noexcept
+{
+    return static_cast<int64_t>(value >> 1U) ^ -static_cast<int64_t>(value & 1U);
+}
+}  // namespace detail
+
+/**
+ * @brief Ring of (timestamp, value) samples compressed with the Gorilla encoding into fixed size blocks, the oldest
+ *        block is overwritten once all blocks are used.
+ *
+ * Timestamps are stored as the difference of consecutive deltas (delta-of-delta), which is 0 or small for regularly
+ * sampled data and takes a single bit in the best case. Values are XORed with the previous value and only the bits in
+ * between the leading and trailing zeros of the result are stored, which takes a single bit for repeated values. The
+ * first sample of every block is stored uncompressed, so every block can be decoded on its own. The compression ratio
+ * depends on the data: regular timestamps and values with few significant bits compress best (40x and more), while
+ * jittered timestamps with latencies in full double precision only shrink to about 10 bytes per sample (1.6x).
+ *
+ * Samples are decoded block by block while iterating from the oldest to the newest one. Appending invalidates
+ * iterators, as it may overwrite the oldest block.
+ *
+ * Usage:
+ *   CompressedTimeSeries<> latencies(1024);  // 1024 blocks of 4 kB
+ *   latencies.append(Clock::now(), watch.stop().count());
+ *   for (const auto& sample : latencies) { ... }
+ *   latencies.compressionRatio();
+ *
+ * @tparam Clock clock whose time_points are stored, e.g. any clock usable with StopWatchT
+ * @tparam blockBytes size of a block including its header
+ */
+template <typename Clock = std::chrono::steady_clock, size_t blockBytes = 4096>
+class CompressedTimeSeries
+{
+  public:
+    using TimePoint = typename Clock::time_point;
+    using Duration = typename TimePoint::duration;
+
+    struct Sample
+    {
+        TimePoint time;
+        double value = 0.0;
+    };
+
+    class Iterator;
+
+    /// @param numBlocks number of blocks allocated up front
+    explicit CompressedTimeSeries(size_t numBlocks) : blocks_(numBlocks) { ZBO_PRECONDITION(numBlocks > 0) }
+
+    /// number of samples stored
+    [[nodiscard]] size_t size() const noexcept { return size_; }
+    [[nodiscard]] bool empty() const noexcept { return size_ == 0; }
+    /// number of blocks holding samples
+    [[nodiscard]] size_t usedBlocks() const noexcept { return usedBlocks_; }
+    [[nodiscard]] size_t capacityBlocks() const noexcept { return blocks_.size(); }
+
+    /// bytes of the used blocks that hold encoded samples, including the block headers
+    [[nodiscard]] size_t compressedBytes() const noexcept
+    {
+        size_t bytes = 0;
+        for (size_t idx = 0; idx < usedBlocks_; ++idx)
+        {
+            bytes += HEADER_BYTES + (block(idx).bits + 7) / 8;
+        }
+        return bytes;
+    }
+
+    /// size of the stored samples as an array of Sample divided by their compressed size
+    [[nodiscard]] double compressionRatio() const noexcept
+    {
+        return empty() ? 0.0 : static_cast<double>(size_ * sizeof(Sample)) / static_cast<double>(compressedBytes());
+    }
+
+    void append(TimePoint time, double value)
+    {
+        const int64_t timestamp = time.time_since_epoch().count();
+        const auto valueBits = std::bit_cast<uint64_t>(value);
+        if (usedBlocks_ == 0 || block(usedBlocks_ - 1).bits + MAX_SAMPLE_BITS > DATA_BITS)
+        {
+            startBlock(timestamp, valueBits);
+            return;
+        }
+
+        Block& current = block(usedBlocks_ - 1);
+        detail::BitWriter writer(current.words.data(), current.bits);
+        const int64_t delta = detail::wrappingSub(timestamp, previousTime_);
+        writeTimestamp(writer, detail::wrappingSub(delta, previousDelta_));
+        writeValue(writer, valueBits ^ previousValue_);
+        previousTime_ = timestamp;
+        previousDelta_ = delta;
+        previousValue_ = valueBits;
+        ++current.count;
+        ++size_;
+    }
+
+    void clear() noexcept
+    {
+        usedBlocks_ = 0;
+        size_ = 0;
+    }
+
+    [[nodiscard]] Iterator begin() const { return Iterator(this, 0); }
+    [[nodiscard]] Iterator end() const { return Iterator(this, usedBlocks_); }
+
+    /// decodes the samples of one block after the other from the oldest to the newest sample
+    class Iterator
+    {
+      public:
+        using iterator_category = std::input_iterator_tag;  // NOLINT (readability-identifier-naming)
+        using value_type = Sample;                          // NOLINT (readability-identifier-naming)
+        using difference_type = std::ptrdiff_t;             // NOLINT (readability-identifier-naming)
+        using pointer = const Sample*;                      // NOLINT (readability-identifier-naming)
+        using reference = const Sample&;                    // NOLINT (readability-identifier-naming)
+
+        Iterator() = default;
+
+        [[nodiscard]] const Sample& operator*() const noexcept { return current_; }
+        [[nodiscard]] const Sample* operator->() const noexcept { return &current_; }
+
+        Iterator& operator++()
+        {
+            if (++sampleIdx_ < series_->block(blockIdx_).count)
+            {
+                decodeNext();
+            }
+            else
+            {
+                startBlock(blockIdx_ + 1);
+            }
+            return *this;
+        }
+        Iterator operator++(int)
+        {
+            Iterator it = *this;
+            ++(*this);
+            return it;
+        }
+
+        [[nodiscard]] bool operator==(const Iterator& other) const noexcept
+        {
+            return blockIdx_ == other.blockIdx_ && sampleIdx_ == other.sampleIdx_;
+        }
+
+      private:
+        friend class CompressedTimeSeries;
+
+        Iterator(const CompressedTimeSeries* series, size_t blockIdx) : series_(series) { startBlock(blockIdx); }
+
+        void startBlock(size_t blockIdx)
+        {
+            blockIdx_ = blockIdx;
+            sampleIdx_ = 0;
+            if (blockIdx_ == series_->usedBlocks_)
+            {
+                return;
+            }
+            reader_ = detail::BitReader(series_->block(blockIdx_).words.data());
+            time_ = static_cast<int64_t>(reader_.read(64));
+            delta_ = 0;
+            value_ = reader_.read(64);
+            leading_ = 0;
+            meaningful_ = 0;
+            setCurrent();
+        }
+
+        void decodeNext()
+        {
+            delta_ = detail::wrappingAdd(delta_, readTimestamp());
+            time_ = detail::wrappingAdd(time_, delta_);
+            if (reader_.readBit())
+            {
+                if (reader_.readBit())
+                {
+                    leading_ = static_cast<unsigned>(reader_.read(LEADING_BITS));
+                    meaningful_ = static_cast<unsigned>(reader_.read(LENGTH_BITS)) + 1;
+                }
+                value_ ^= reader_.read(meaningful_) << (64 - leading_ - meaningful_);
+            }
+            setCurrent();
+        }
+
+        int64_t readTimestamp()
+        {
+            for (const auto& bucket : TIMESTAMP_BUCKETS)
+            {
+                if (!reader_.readBit())
+                {
+                    return bucket == 0 ? 0 : detail::zigZagDecode(reader_.read(bucket));
+                }
+            }
+            return detail::zigZagDecode(reader_.read(64));
+        }
+
+        void setCurrent()
+        {
+            current_ = Sample{TimePoint(Duration(time_)), std::bit_cast<double>(value_)};
+        }
+
+        const CompressedTimeSeries* series_ = nullptr;
+        size_t blockIdx_ = 0;
+        size_t sampleIdx_ = 0;
+        detail::BitReader reader_;
+        int64_t time_ = 0;
+        int64_t delta_ = 0;
+        uint64_t value_ = 0;
+        unsigned leading_ = 0;
+        unsigned meaningful_ = 0;
+        Sample current_;
+    };
+
+  private:
+    static constexpr size_t HEADER_BYTES = 2 * sizeof(uint32_t);
+    static_assert(blockBytes % sizeof(uint64_t) == 0 && blockBytes >= 64, "blocks consist of at least 7 words");
+    static_assert(std::is_integral_v<typename TimePoint::rep> && sizeof(typename TimePoint::rep) <= sizeof(int64_t),
+                  "timestamps are stored as int64_t, so the clock needs an integral representation of at most 64 bits");
+    // the last word is not used for data, so reading and writing fields that end at a word boundary stays in bounds
+    static constexpr size_t NUM_WORDS = (blockBytes - HEADER_BYTES) / sizeof(uint64_t);
+    static constexpr uint32_t DATA_BITS = (NUM_WORDS - 1) * 64;
+
+    /// number of bits of the zigzag encoded delta-of-delta for prefixes 0, 10, 110, 1110, 11110, 11111 uses 64 bits
+    static constexpr std::array<unsigned, 5> TIMESTAMP_BUCKETS{0, 7, 12, 20, 32};
+    static constexpr unsigned LEADING_BITS = 6;
+    static constexpr unsigned LENGTH_BITS = 6;
+    static constexpr uint32_t MAX_SAMPLE_BITS =
+        TIMESTAMP_BUCKETS.size() + 64 + 2 + LEADING_BITS + LENGTH_BITS + 64;
+
+    struct Block
+    {
+        uint32_t count = 0;
+        uint32_t bits = 0;
+        std::array<uint64_t, NUM_WORDS> words{};
+    };
+    static_assert(sizeof(Block) <= blockBytes);
+
+    /// block at position idx counted from the oldest one
+    [[nodiscard]] Block& block(size_t idx) noexcept { return blocks_[(oldest_ + idx) % blocks_.size()]; }
+    [[nodiscard]] const Block& block(size_t idx) const noexcept { return blocks_[(oldest_ + idx) % blocks_.size()]; }
+
+    void startBlock(int64_t timestamp, uint64_t valueBits)
+    {
+        if (usedBlocks_ == blocks_.size())
+        {
+            // evict the oldest block
+            size_ -= blocks_[oldest_].count;
+            oldest_ = (oldest_ + 1) % blocks_.size();
+            --usedBlocks_;
+        }
+        ++usedBlocks_;
+        Block& current = block(usedBlocks_ - 1);
+        current.words.fill(0);
+        current.bits = 0;
+        current.count = 1;
+
+        detail::BitWriter writer(current.words.data(), current.bits);
+        writer.write(static_cast<uint64_t>(timestamp), 64);
+        writer.write(valueBits, 64);
+        previousTime_ = timestamp;
+        previousDelta_ = 0;
+        previousValue_ = valueBits;
+        previousLeading_ = 0;
+        previousTrailing_ = 0;
+        hasWindow_ = false;
+        ++size_;
+    }
+
+    static void writeTimestamp(detail::BitWriter& writer, int64_t deltaOfDelta)
+    {
+        const uint64_t encoded = detail::zigZagEncode(deltaOfDelta);
+        unsigned prefix = 0;
+        for (const auto& bucket : TIMESTAMP_BUCKETS)
+        {
+            if (bucket == 0 ? encoded == 0 : encoded < (uint64_t{1} << bucket))
+            {
+                // prefix ones followed by a zero
+                writer.write(((uint64_t{1} << prefix) - 1) << 1U, prefix + 1);
+                if (bucket > 0)
+                {
+                    writer.write(encoded, bucket);
+                }
+                return;
+            }
+            ++prefix;
+        }
+        writer.write(0b11111, TIMESTAMP_BUCKETS.size());
+        writer.write(encoded, 64);
+    }
+
+    void writeValue(detail::BitWriter& writer, uint64_t xored)
+    {
+        if (xored == 0)
+        {
+            writer.write(0, 1);
+            return;
+        }
+        const auto leading = std::min<unsigned>(std::countl_zero(xored), (1U << LEADING_BITS) - 1);
+        const auto trailing = static_cast<unsigned>(std::countr_zero(xored));
+        if (hasWindow_ && leading >= previousLeading_ && trailing >= previousTrailing_)
+        {
+            // the meaningful bits fit into the window of the previous value
+            writer.write(0b10, 2);
+            writer.write(xored >> previousTrailing_, 64 - previousLeading_ - previousTrailing_);
+            return;
+        }
+        const unsigned meaningful = 64 - leading - trailing;
+        writer.write(0b11, 2);
+        writer.write(leading, LEADING_BITS);
+        writer.write(meaningful - 1, LENGTH_BITS);
+        writer.write(xored >> trailing, meaningful);
+        previousLeading_ = leading;
+        previousTrailing_ = trailing;
+        hasWindow_ = true;
+    }
+
+    std::vector<Block> blocks_;
+    size_t oldest_ = 0;
+    size_t usedBlocks_ = 0;
+    size_t size_ = 0;
+
+    // state of the encoder for the newest block
+    int64_t previousTime_ = 0;
+    int64_t previousDelta_ = 0;
+    uint64_t previousValue_ = 0;
+    unsigned previousLeading_ = 0;
+    unsigned previousTrailing_ = 0;
+    bool hasWindow_ = false;
+};
+
+}  // namespace zbo
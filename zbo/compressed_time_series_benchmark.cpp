@@ -0,0 +1,165 @@
+#include "compressed_time_series.h"
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+namespace zbo::bench {
+
+using Clock = std::chrono::steady_clock;
+using Series = CompressedTimeSeries<Clock>;
+using Sample = Series::Sample;
+
+constexpr size_t NUM_SAMPLES = 1 << 20;
+constexpr size_t NUM_BLOCKS = 2048;
+
+/**
+ * requests arriving randomly with 20k requests per second on average and log-normal latencies as they come out of
+ * StopWatch::stop().count(), i.e. seconds as double
+ */
+std::vector<Sample> requestLatencies()
+{
+    std::mt19937_64 gen{42};
+    std::exponential_distribution<double> interArrival(1.0 / 50'000.0);
+    std::lognormal_distribution<double> latency(std::log(200e-6), 0.5);
+    std::vector<Sample> samples(NUM_SAMPLES);
+    auto time = Clock::time_point{} + std::chrono::hours(100);
+    for (auto& sample : samples)
+    {
+        time += std::chrono::nanoseconds(static_cast<int64_t>(interArrival(gen)));
+        sample = Sample{time, latency(gen)};
+    }
+    return samples;
+}
+
+/// a metric sampled every 100ms, that only changes now and then
+std::vector<Sample> periodicGauge()
+{
+    std::mt19937_64 gen{42};
+    std::vector<Sample> samples(NUM_SAMPLES);
+    auto time = Clock::time_point{};
+    double value = 100.0;
+    for (auto& sample : samples)
+    {
+        time += std::chrono::milliseconds(100);
+        value += gen() % 10 == 0 ? 1.0 : 0.0;
+        sample = Sample{time, value};
+    }
+    return samples;
+}
+
+/// the uncompressed alternative, a circular buffer of samples
+class SampleRing
+{
+  public:
+    explicit SampleRing(size_t capacity) : samples_(capacity) {}
+
+    void append(Clock::time_point time, double value)
+    {
+        samples_[next_] = Sample{time, value};
+        next_ = (next_ + 1) % samples_.size();
+        size_ = std::min(size_ + 1, samples_.size());
+    }
+
+    template <typename Callback>
+    void forEach(Callback&& callback) const
+    {
+        const size_t oldest = size_ == samples_.size() ? next_ : 0;
+        for (size_t idx = 0; idx < size_; ++idx)
+        {
+            callback(samples_[(oldest + idx) % samples_.size()]);
+        }
+    }
+
+  private:
+    std::vector<Sample> samples_;
+    size_t next_ = 0;
+    size_t size_ = 0;
+};
+
+template <std::vector<Sample> (*generate)()>
+void appendCompressed(benchmark::State& state)
+{
+    const auto samples = generate();
+    Series series(NUM_BLOCKS);
+    size_t idx = 0;
+    for (auto _ : state)
+    {
+        const Sample& sample = samples[idx++ % samples.size()];
+        series.append(sample.time, sample.value);
+    }
+    state.SetItemsProcessed(state.iterations());
+    state.counters["ratio"] = series.compressionRatio();
+    state.counters["bytesPerSample"] = static_cast<double>(series.compressedBytes()) / series.size();
+}
+
+template <std::vector<Sample> (*generate)()>
+void appendUncompressed(benchmark::State& state)
+{
+    const auto samples = generate();
+    SampleRing ring(NUM_SAMPLES);
+    size_t idx = 0;
+    for (auto _ : state)
+    {
+        const Sample& sample = samples[idx++ % samples.size()];
+        ring.append(sample.time, sample.value);
+    }
+    benchmark::DoNotOptimize(ring);
+    state.SetItemsProcessed(state.iterations());
+    state.counters["bytesPerSample"] = sizeof(Sample);
+}
+
+template <std::vector<Sample> (*generate)()>
+void scanCompressed(benchmark::State& state)
+{
+    Series series(NUM_BLOCKS);
+    for (const auto& sample : generate())
+    {
+        series.append(sample.time, sample.value);
+    }
+    for (auto _ : state)
+    {
+        double sum = 0.0;
+        for (const auto& sample : series)
+        {
+            sum += sample.value;
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * series.size());
+    state.counters["samples"] = static_cast<double>(series.size());
+}
+
+template <std::vector<Sample> (*generate)()>
+void scanUncompressed(benchmark::State& state)
+{
+    SampleRing ring(NUM_SAMPLES);
+    for (const auto& sample : generate())
+    {
+        ring.append(sample.time, sample.value);
+    }
+    for (auto _ : state)
+    {
+        double sum = 0.0;
+        ring.forEach([&](const Sample& sample) { sum += sample.value; });
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * NUM_SAMPLES);
+}
+
+BENCHMARK_TEMPLATE(appendCompressed, requestLatencies);
+BENCHMARK_TEMPLATE(appendUncompressed, requestLatencies);
+BENCHMARK_TEMPLATE(scanCompressed, requestLatencies);
+BENCHMARK_TEMPLATE(scanUncompressed, requestLatencies);
+
+BENCHMARK_TEMPLATE(appendCompressed, periodicGauge);
+BENCHMARK_TEMPLATE(appendUncompressed, periodicGauge);
+BENCHMARK_TEMPLATE(scanCompressed, periodicGauge);
+BENCHMARK_TEMPLATE(scanUncompressed, periodicGauge);
+
+}  // namespace zbo::bench
+
+BENCHMARK_MAIN();
@@ -0,0 +1,126 @@
+#include "compressed_time_series.h"
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <limits>
+#include <random>
+#include <vector>
+
+namespace zbo::test {
+
+using Clock = std::chrono::steady_clock;
+using std::chrono::nanoseconds;
+using Series = CompressedTimeSeries<Clock>;
+
+std::vector<Series::Sample> decode(const Series& series)
+{
+    return {series.begin(), series.end()};
+}
+
+void expectEqual(const std::vector<Series::Sample>& decoded, const std::vector<Series::Sample>& expected)
+{
+    ASSERT_EQ(decoded.size(), expected.size());
+    for (size_t idx = 0; idx < expected.size(); ++idx)
+    {
+        ASSERT_EQ(decoded[idx].time, expected[idx].time) << idx;
+        // compares the bits, so NaNs and signed zeros need to be restored exactly
+        ASSERT_EQ(std::bit_cast<uint64_t>(decoded[idx].value), std::bit_cast<uint64_t>(expected[idx].value)) << idx;
+    }
+}
+
+TEST(CompressedTimeSeries, Empty)
+{
+    const Series series(4);
+    ASSERT_TRUE(series.empty());
+    ASSERT_EQ(series.begin(), series.end());
+    ASSERT_EQ(series.compressionRatio(), 0.0);
+}
+
+TEST(CompressedTimeSeries, RoundTripsAllKindsOfSamples)
+{
+    const auto start = Clock::time_point{} + std::chrono::hours(1000);
+    const std::vector<Series::Sample> samples{
+        {start, 1.5},
+        {start + nanoseconds(1000), 1.5},
+        {start + nanoseconds(2000), 1.25},
+        {start + nanoseconds(2000), -0.0},
+        {start - nanoseconds(5), std::numeric_limits<double>::quiet_NaN()},
+        {start + nanoseconds(1'000'000'000'000), std::numeric_limits<double>::infinity()},
+        {Clock::time_point::min(), std::numeric_limits<double>::max()},
+        {Clock::time_point::max(), std::numeric_limits<double>::denorm_min()},
+        {start, 0.001},
+    };
+    Series series(4);
+    for (const auto& sample : samples)
+    {
+        series.append(sample.time, sample.value);
+    }
+    ASSERT_EQ(series.size(), samples.size());
+    ASSERT_EQ(series.usedBlocks(), 1);
+    expectEqual(decode(series), samples);
+}
+
+TEST(CompressedTimeSeries, RegularSamplesCompressWell)
+{
+    Series series(16);
+    const auto start = Clock::now();
+    for (int idx = 0; idx < 10'000; ++idx)
+    {
+        series.append(start + std::chrono::milliseconds(idx), idx % 100 == 0 ? 1.0 : 2.0);
+    }
+    // mostly one bit for the timestamp and one for the value
+    ASSERT_GT(series.compressionRatio(), 40.0);
+    ASSERT_EQ(decode(series).size(), 10'000);
+}
+
+TEST(CompressedTimeSeries, EvictsOldestBlocks)
+{
+    // blocks of 64 bytes hold few samples, so the ring wraps around a couple of times
+    CompressedTimeSeries<Clock, 64> series(3);
+    std::mt19937_64 rng(42);  // NOLINT (cert-msc51-cpp) deterministic on purpose
+    std::uniform_int_distribution<int64_t> jitter(0, 1'000'000);
+    std::uniform_real_distribution<double> latency(1e-5, 1e-3);
+
+    std::vector<CompressedTimeSeries<Clock, 64>::Sample> samples;
+    auto time = Clock::time_point{};
+    for (int idx = 0; idx < 500; ++idx)
+    {
+        time += nanoseconds(jitter(rng));
+        samples.push_back({time, latency(rng)});
+        series.append(time, samples.back().value);
+
+        ASSERT_LE(series.usedBlocks(), 3);
+        const std::vector<CompressedTimeSeries<Clock, 64>::Sample> decoded(series.begin(), series.end());
+        ASSERT_EQ(decoded.size(), series.size());
+        // the newest samples are kept
+        for (size_t offset = 1; offset <= decoded.size(); ++offset)
+        {
+            ASSERT_EQ(decoded[decoded.size() - offset].time, samples[samples.size() - offset].time);
+            ASSERT_EQ(decoded[decoded.size() - offset].value, samples[samples.size() - offset].value);
+        }
+    }
+    ASSERT_EQ(series.usedBlocks(), 3);
+    ASSERT_LT(series.size(), samples.size());
+
+    series.clear();
+    ASSERT_TRUE(series.empty());
+    ASSERT_EQ(series.begin(), series.end());
+}
+
+TEST(CompressedTimeSeries, RandomData)
+{
+    Series series(1000);
+    std::mt19937_64 rng(42);  // NOLINT (cert-msc51-cpp) deterministic on purpose
+    std::vector<Series::Sample> samples;
+    auto time = Clock::time_point{};
+    for (int idx = 0; idx < 100'000; ++idx)
+    {
+        time += nanoseconds(static_cast<int64_t>(rng() % (uint64_t{1} << (rng() % 40))));
+        samples.push_back({time, std::bit_cast<double>(rng() >> (rng() % 64))});
+        series.append(samples.back().time, samples.back().value);
+    }
+    expectEqual(decode(series), samples);
+}
+
+}  // namespace zbo::test
@@ -22,17 +22,57 @@
 
 #pragma once
 
+#include <atomic>
+#include <exception>
+
 #if __has_cpp_attribute(unlikely)
 #define ZBO_UNLIKELY [[unlikely]]
 #else
 #define ZBO_UNLIKELY
 #endif
 
+namespace zbo {
+
+/// describes a failed contract check
+struct ContractViolation
+{
+    const char* type;       ///< "Pre", "Post", "Check", "Unreachable" or "Assert"
+    const char* condition;  ///< the condition as written in the source
+    const char* file;
+    int line;
+};
+
+/// called on a contract violation right before std::terminate(), e.g. to write diagnostics
+using ContractViolationHandler = void (*)(const ContractViolation&) noexcept;
+
+namespace detail {
+
+inline std::atomic<ContractViolationHandler> contractViolationHandler{nullptr};
+
+[[noreturn]] inline void contractViolated(const char* type, const char* condition, const char* file, int line) noexcept
+{
+    if (const ContractViolationHandler handler = contractViolationHandler.load(std::memory_order_acquire))
+    {
+        handler(ContractViolation{type, condition, file, line});
+    }
+    std::terminate();
+}
+
+}  // namespace detail
+
+/// installs handler for all following contract violations and returns the previous handler
+inline ContractViolationHandler setContractViolationHandler(ContractViolationHandler handler) noexcept
+{
+    return detail::contractViolationHandler.exchange(handler, std::memory_order_acq_rel);
+}
+
+}  // namespace zbo
+
 // NOLINTNEXTLINE (cppcoreguidelines-macro-usage)
-#define ZBO_CONTRACT_CHECK(type, condition) \
-    if (!(condition)) ZBO_UNLIKELY          \
-        {                                   \
-            std::terminate();               \
+#define ZBO_CONTRACT_CHECK(type, condition)                                        \
+    if (!(condition)) ZBO_UNLIKELY                                                 \
+        {                                                                          \
+            ::zbo::detail::contractViolated(type, #condition, __FILE__, __LINE__); \
         }
 
 #define ZBO_PRECONDITION(condition) ZBO_CONTRACT_CHECK("Pre", condition)    // NOLINT (cppcoreguidelines-macro-usage)
@@ -27,60 +27,68 @@ struct Tag
 {
 };
 
-constexpr bool isNested(size_t brackets, bool quote)
-{
-    return brackets != 0 || quote;
-}
-
+/**
+ * @brief returns the position of the next comma separating two members (i.e. not within brackets or quotes) in the
+ *        stringified member list, or its size if there is none.
+ *
+ * This runs for every character of the member list at compile time, so the common case of a plain character only
+ * takes a few constexpr operations. '<' and '>' count as brackets unless they are part of a shift.
+ */
 constexpr size_t nextEnumCommaOrEnd(size_t start, std::string_view enumString)
 {
-    size_t brackets = 0;  //()[]{}
+    size_t brackets = 0;  //()<>{}
     bool quote = false;   //""
     char lastChar = '\0';
-    char nextChar = '\0';
 
-    auto feedCounters = [&brackets, &quote, &lastChar, &nextChar](char c) {
+    const char* data = enumString.data();
+    const size_t size = enumString.size();
+    for (size_t current = start; current < size; ++current)
+    {
+        const char c = data[current];  // NOLINT (cppcoreguidelines-pro-bounds-pointer-arithmetic)
         if (quote)
         {
-            if (lastChar != '\\' && c == '"')  // ignore " if they are backslashed
-                quote = false;
-            return;
-        }
-
-        switch (c)
-        {
-            case '"':
-                if (lastChar != '\\')  // ignore " if they are backslashed
-                    quote = true;
-                break;
-            case '(':
-            case '<':
-                if (lastChar == '<' || nextChar == '<') break;
-                [[fallthrough]];
-            case '{':
-                ++brackets;
-                break;
-            case ')':
-            case '>':
-                if (lastChar == '>' || nextChar == '>') break;
-                [[fallthrough]];
-            case '}':
-                --brackets;
-                break;
-            default:
-                break;
-        }
-    };
-
-    size_t current = start;
-    for (; current < enumString.size() && (isNested(brackets, quote) || (enumString[current] != ',')); ++current)
-    {
-        feedCounters(enumString[current]);
-        lastChar = enumString[current];
-        nextChar = current + 2 < enumString.size() ? enumString[current + 2] : '\0';
-    }
-
-    return current;
+            quote = c != '"' || lastChar == '\\';  // ignore " if they are backslashed
+        }
+        else
+        {
+            switch (c)
+            {
+                case ',':
+                    if (brackets == 0)
+                    {
+                        return current;
+                    }
+                    break;
+                case '"':
+                    quote = lastChar != '\\';  // ignore " if they are backslashed
+                    break;
+                case '(':
+                case '<':
+                    if (lastChar == '<' || (current > start && current + 1 < size && enumString[current + 1] == '<'))
+                    {
+                        break;
+                    }
+                    [[fallthrough]];
+                case '{':
+                    ++brackets;
+                    break;
+                case ')':
+                case '>':
+                    if (lastChar == '>' || (current > start && current + 1 < size && enumString[current + 1] == '>'))
+                    {
+                        break;
+                    }
+                    [[fallthrough]];
+                case '}':
+                    --brackets;
+                    break;
+                default:
+                    break;
+            }
+        }
+        lastChar = c;
+    }
+    return size;
 }
 
 constexpr bool isAllowedIdentifierChar(char c)
@@ -106,19 +114,39 @@ constexpr std::string_view parseEnumMemberName(std::string_view memberString)
     return std::string_view(memberString.data() + nameStart, nameSize);
 }
 
-template <typename EnumType, typename UnderlyingType, size_t size>
-constexpr MetaEnum<EnumType, UnderlyingType, size> parseMetaEnum(std::string_view in,
-                                                                 const std::array<EnumType, size>& values)
+template <typename EnumUnderlyingType>
+struct IntWrapper
+{
+    constexpr IntWrapper() : value(0) {}
+    constexpr IntWrapper(EnumUnderlyingType in) : value(in), empty(false) {}
+    constexpr IntWrapper& operator=(EnumUnderlyingType in)
+    {
+        value = in;
+        empty = false;
+        return *this;
+    }
+    EnumUnderlyingType value;
+    bool empty{true};
+};
+
+/**
+ * @brief Creates the MetaEnum from the stringified member list and the values of all members in one linear pass.
+ * @param literal stringified member list
+ * @param values members as IntWrapper, members without initializer are empty and continue from the previous value
+ */
+template <typename EnumType, typename UnderlyingType, size_t size, size_t length>
+// NOLINTNEXTLINE (cppcoreguidelines-avoid-c-arrays)
+constexpr MetaEnum<EnumType, UnderlyingType, size> parseMetaEnum(const char (&literal)[length],
+                                                                 const IntWrapper<UnderlyingType> (&values)[size])
 {
+    // taking the length from the literal type avoids a constexpr strlen over the whole member list
+    const std::string_view in(literal, length - 1);
     MetaEnum<EnumType, UnderlyingType, size> result;
     result.string = in;
 
-    std::array<std::string_view, size> memberStrings;
-    size_t amountFilled = 0;
-
     size_t currentStringStart = 0;
-
-    while (amountFilled < size)
+    UnderlyingType nextValue = 0;
+    for (size_t i = 0; i < size; ++i)
     {
         size_t currentStringEnd = nextEnumCommaOrEnd(currentStringStart + 1, in);
         size_t currentStringSize = currentStringEnd - currentStringStart;
@@ -129,56 +157,363 @@ constexpr MetaEnum<EnumType, UnderlyingType, size> parseMetaEnum(std::string_vie
             --currentStringSize;
         }
 
-        memberStrings.at(amountFilled) = std::string_view(in.data() + currentStringStart, currentStringSize);
-        ++amountFilled;
+        const std::string_view memberString(in.data() + currentStringStart, currentStringSize);
+        result.strings[i] = memberString;
+        result.names[i] = parseEnumMemberName(memberString);
         currentStringStart = currentStringEnd;
+
+        const auto& wrapper = values[i];  // NOLINT (cppcoreguidelines-pro-bounds-constant-array-index)
+        const UnderlyingType value = wrapper.empty ? nextValue : wrapper.value;
+        result.values[i] = static_cast<EnumType>(value);
+        nextValue = static_cast<UnderlyingType>(value + 1);
+    }
+
+    return result;
+}
+
+constexpr char toLowerAscii(char c)
+{
+    return (c >= 'A' && c <= 'Z') ? static_cast<char>(c - 'A' + 'a') : c;
+}
+
+template <bool caseInsensitive>
+constexpr bool namesEqual(std::string_view lhs, std::string_view rhs)
+{
+    if constexpr (caseInsensitive)
+    {
+        if (lhs.size() != rhs.size())
+        {
+            return false;
+        }
+        for (size_t i = 0; i < lhs.size(); ++i)
+        {
+            if (toLowerAscii(lhs[i]) != toLowerAscii(rhs[i]))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+    else
+    {
+        return lhs == rhs;
+    }
+}
+
+/// reads up to 8 chars of str starting at pos as little endian word, the compiler turns this into a single load
+constexpr uint64_t loadWord(std::string_view str, size_t pos, size_t count)
+{
+    uint64_t word = 0;
+    for (size_t i = 0; i < count; ++i)
+    {
+        word |= static_cast<uint64_t>(static_cast<uint8_t>(str[pos + i])) << (8U * i);
     }
+    return word;
+}
+
+/**
+ * @brief Hashes a member name word by word. The case insensitive variant sets the 0x20 bit of all chars which maps
+ *        upper to lower case letters and keeps all identifier chars distinct.
+ */
+template <bool caseInsensitive>
+constexpr uint64_t hashName(std::string_view name)
+{
+    constexpr uint64_t WORD_SIZE = sizeof(uint64_t);
+    constexpr uint64_t CASE_BITS = caseInsensitive ? 0x2020202020202020ULL : 0;
+    constexpr uint64_t MUL = 0x9E3779B97F4A7C15ULL;
+    constexpr uint64_t FINAL_MUL = 0xFF51AFD7ED558CCDULL;
 
-    for (size_t i = 0; i < memberStrings.size(); ++i)
+    uint64_t hash = name.size();
+    size_t pos = 0;
+    for (; pos + WORD_SIZE <= name.size(); pos += WORD_SIZE)
+    {
+        hash = (hash ^ (loadWord(name, pos, WORD_SIZE) | CASE_BITS)) * MUL;
+        hash ^= hash >> 29U;
+    }
+    if (pos < name.size())
     {
-        auto& member = result.members.at(i);
-        member.name = parseEnumMemberName(memberStrings.at(i));
-        member.string = memberStrings.at(i);
-        member.value = values.at(i);
-        member.index = i;
+        hash = (hash ^ (loadWord(name, pos, name.size() - pos) | CASE_BITS)) * MUL;
     }
+    hash ^= hash >> 32U;
+    hash *= FINAL_MUL;
+    return hash ^ (hash >> 29U);
+}
 
+constexpr size_t bitCeil(size_t value)
+{
+    size_t result = 1;
+    while (result < value)
+    {
+        result *= 2;
+    }
     return result;
 }
 
-template <typename EnumUnderlyingType>
-struct IntWrapper
+/**
+ * @brief Perfect hash table from member names to enum values that is generated at compile time (hash and displace).
+ *
+ * The name hash selects a bucket, the per bucket seed moves all names of that bucket to distinct slots. A lookup is
+ * therefore one hash, two array reads and a single string compare. Empty slots point to member 0, which is correct
+ * when the name is the one of member 0 and fails the compare otherwise.
+ */
+template <typename EnumType, size_t numEnums, bool caseInsensitive>
+class NameLookup
 {
-    constexpr IntWrapper() : value(0) {}
-    constexpr IntWrapper(EnumUnderlyingType in) : value(in), empty(false) {}
-    constexpr IntWrapper& operator=(EnumUnderlyingType in)
+    static_assert(numEnums < std::numeric_limits<uint16_t>::max(), "Member indices are stored as uint16_t");
+
+    static constexpr size_t NUM_BUCKETS = bitCeil(numEnums);
+    static constexpr size_t NUM_SLOTS = 2 * NUM_BUCKETS;
+    static constexpr size_t MAX_SEED = std::numeric_limits<uint16_t>::max();
+
+  public:
+    template <typename MetaEnumType>
+    constexpr explicit NameLookup(const MetaEnumType& meta)
     {
-        value = in;
-        empty = false;
-        return *this;
+        std::array<uint64_t, numEnums> hashes{};
+        std::array<size_t, NUM_BUCKETS + 1> bucketStart{};
+        for (size_t i = 0; i < numEnums; ++i)
+        {
+            names_.at(i) = meta.names.at(i);
+            values_.at(i) = meta.values.at(i);
+            hashes.at(i) = hashName<caseInsensitive>(names_.at(i));
+            ++bucketStart.at(bucketOf(hashes.at(i)) + 1);
+        }
+
+        // sort the members by bucket and place the largest buckets first while the table is still empty
+        size_t maxBucketSize = 0;
+        for (size_t bucket = 0; bucket < NUM_BUCKETS; ++bucket)
+        {
+            maxBucketSize = std::max(maxBucketSize, bucketStart.at(bucket + 1));
+            bucketStart.at(bucket + 1) += bucketStart.at(bucket);
+        }
+        std::array<uint16_t, numEnums> byBucket{};
+        std::array<size_t, NUM_BUCKETS> filled{};
+        for (size_t i = 0; i < numEnums; ++i)
+        {
+            const size_t bucket = bucketOf(hashes.at(i));
+            byBucket.at(bucketStart.at(bucket) + filled.at(bucket)++) = static_cast<uint16_t>(i);
+        }
+
+        std::array<bool, NUM_SLOTS> used{};
+        for (size_t bucketSize = maxBucketSize; bucketSize > 0; --bucketSize)
+        {
+            for (size_t bucket = 0; bucket < NUM_BUCKETS; ++bucket)
+            {
+                const size_t begin = bucketStart.at(bucket);
+                if (bucketStart.at(bucket + 1) - begin != bucketSize)
+                {
+                    continue;
+                }
+                for (size_t i = begin; i < begin + bucketSize; ++i)
+                {
+                    for (size_t j = begin; j < i; ++j)
+                    {
+                        // names only differing in case can not be told apart by the case insensitive lookup
+                        ZBO_PRECONDITION(hashes.at(byBucket.at(i)) != hashes.at(byBucket.at(j)))
+                    }
+                }
+                placeBucket(bucket, {byBucket.data() + begin, bucketSize}, hashes, used);
+            }
+        }
     }
-    EnumUnderlyingType value;
-    bool empty{true};
+
+    [[nodiscard]] constexpr std::optional<EnumType> find(std::string_view name) const
+    {
+        const uint64_t hash = hashName<caseInsensitive>(name);
+        const uint16_t idx = slots_[slotOf(hash, seeds_[bucketOf(hash)])];
+        if (namesEqual<caseInsensitive>(names_[idx], name))
+        {
+            return values_[idx];
+        }
+        return std::nullopt;
+    }
+
+  private:
+    [[nodiscard]] static constexpr size_t bucketOf(uint64_t hash) { return hash & (NUM_BUCKETS - 1); }
+
+    [[nodiscard]] static constexpr size_t slotOf(uint64_t hash, uint16_t seed)
+    {
+        constexpr uint64_t GOLDEN_RATIO = 0x9E3779B97F4A7C15ULL;
+        constexpr uint64_t MIX = 0xBF58476D1CE4E5B9ULL;
+        return static_cast<size_t>(((hash ^ (seed * GOLDEN_RATIO)) * MIX) >> 32U) & (NUM_SLOTS - 1);
+    }
+
+    constexpr void placeBucket(size_t bucket, std::span<const uint16_t> members,
+                               const std::array<uint64_t, numEnums>& hashes, std::array<bool, NUM_SLOTS>& used)
+    {
+        for (size_t seed = 0; seed < MAX_SEED; ++seed)
+        {
+            bool fits = true;
+            for (size_t i = 0; i < members.size() && fits; ++i)
+            {
+                const size_t slot = slotOf(hashes.at(members[i]), static_cast<uint16_t>(seed));
+                fits = !used.at(slot);
+                for (size_t j = 0; j < i && fits; ++j)
+                {
+                    fits = slot != slotOf(hashes.at(members[j]), static_cast<uint16_t>(seed));
+                }
+            }
+            if (fits)
+            {
+                seeds_.at(bucket) = static_cast<uint16_t>(seed);
+                for (uint16_t member : members)
+                {
+                    const size_t slot = slotOf(hashes.at(member), static_cast<uint16_t>(seed));
+                    used.at(slot) = true;
+                    slots_.at(slot) = member;
+                }
+                return;
+            }
+        }
+        ZBO_UNREACHABLE()
+    }
+
+    std::array<std::string_view, numEnums> names_{};
+    std::array<EnumType, numEnums> values_{};
+    std::array<uint16_t, NUM_BUCKETS> seeds_{};
+    std::array<uint16_t, NUM_SLOTS> slots_{};
 };
 
-template <typename EnumType, typename EnumUnderlyingType, size_t size>
-constexpr std::array<EnumType, size> resolveEnumValuesArray(
-    const std::initializer_list<IntWrapper<EnumUnderlyingType>>& in)
+/**
+ * @brief Table from enum values to member indices and names that is generated at compile time.
+ *
+ * If the values of the enum span a small range, the index is read directly from a table indexed by the offset to the
+ * smallest value. Otherwise the values are sorted and searched with a branchless binary search. Values that are not a
+ * member map to the index numEnums, which holds the name for invalid values. If several members share a value, the
+ * first one is returned.
+ *
+ * @tparam denseSize size of the direct table (range of the values) or 0 to use the sorted table
+ */
+template <typename EnumType, typename UnderlyingType, size_t numEnums, size_t denseSize>
+class ValueLookup
 {
-    std::array<EnumType, size> result{};
+    static_assert(numEnums < std::numeric_limits<uint16_t>::max(), "Member indices are stored as uint16_t");
 
-    EnumUnderlyingType nextValue = 0;
-    for (size_t i = 0; i < size; ++i)
+    using Unsigned = std::make_unsigned_t<UnderlyingType>;
+    static constexpr bool DENSE = denseSize > 0;
+    static constexpr size_t MAX_COUNTING_SEARCH = 16;
+
+  public:
+    template <typename MetaEnumType>
+    constexpr explicit ValueLookup(const MetaEnumType& meta)
     {
-        auto wrapper = *std::next(in.begin(), i);
-        EnumUnderlyingType newValue = wrapper.empty ? nextValue : wrapper.value;
-        nextValue = newValue + 1;
-        result.at(i) = static_cast<EnumType>(newValue);
+        for (size_t i = 0; i < numEnums; ++i)
+        {
+            names_.at(i) = meta.names.at(i);
+        }
+        names_.back() = "__INVALID_ENUM_VAL__";
+
+        if constexpr (DENSE)
+        {
+            min_ = static_cast<UnderlyingType>(meta.values.at(0));
+            for (const auto value : meta.values)
+            {
+                min_ = std::min(min_, static_cast<UnderlyingType>(value));
+            }
+            indices_.fill(static_cast<uint16_t>(numEnums));
+            for (size_t i = numEnums; i-- > 0;)
+            {
+                indices_.at(offsetOf(meta.values.at(i))) = static_cast<uint16_t>(i);
+            }
+        }
+        else
+        {
+            // insertion sort keeps members with equal values in their order, so the search finds the first one
+            for (size_t i = 0; i < numEnums; ++i)
+            {
+                const auto value = static_cast<UnderlyingType>(meta.values.at(i));
+                size_t pos = i;
+                for (; pos > 0 && value < sortedValues_.at(pos - 1); --pos)
+                {
+                    sortedValues_.at(pos) = sortedValues_.at(pos - 1);
+                    sortedIndices_.at(pos) = sortedIndices_.at(pos - 1);
+                }
+                sortedValues_.at(pos) = value;
+                sortedIndices_.at(pos) = static_cast<uint16_t>(i);
+            }
+        }
     }
 
-    return result;
+    /// index of e in MetaEnum::values or numEnums if e is not a member
+    [[nodiscard]] constexpr size_t index(EnumType e) const noexcept
+    {
+        if constexpr (DENSE)
+        {
+            const size_t offset = offsetOf(e);
+            return offset < denseSize ? indices_[offset] : numEnums;
+        }
+        else
+        {
+            const auto value = static_cast<UnderlyingType>(e);
+            size_t pos = 0;
+            if constexpr (numEnums <= MAX_COUNTING_SEARCH)
+            {
+                // counting the smaller values can be vectorized and beats the dependent loads of a binary search
+                for (size_t i = 0; i < numEnums; ++i)
+                {
+                    pos += static_cast<size_t>(sortedValues_[i] < value);
+                }
+            }
+            else
+            {
+                for (size_t size = numEnums; size > 1; size -= size / 2)
+                {
+                    pos += static_cast<size_t>(sortedValues_[pos + size / 2 - 1] < value) * (size / 2);
+                }
+            }
+            return pos < numEnums && sortedValues_[pos] == value ? sortedIndices_[pos] : numEnums;
+        }
+    }
+
+    [[nodiscard]] constexpr std::string_view name(EnumType e) const noexcept { return names_[index(e)]; }
+
+  private:
+    [[nodiscard]] constexpr size_t offsetOf(EnumType e) const noexcept
+    {
+        return static_cast<Unsigned>(static_cast<Unsigned>(e) - static_cast<Unsigned>(min_));
+    }
+
+    std::array<std::string_view, numEnums + 1> names_{};
+    UnderlyingType min_{};
+    std::array<uint16_t, denseSize> indices_{};
+    std::array<UnderlyingType, DENSE ? 0 : numEnums> sortedValues_{};
+    std::array<uint16_t, DENSE ? 0 : numEnums> sortedIndices_{};
+};
+
+/// returns the size of the direct table for ValueLookup, or 0 if the values are too sparse
+template <typename MetaEnumType>
+constexpr size_t denseTableSize(const MetaEnumType& meta)
+{
+    using Unsigned = std::make_unsigned_t<typename MetaEnumType::UnderlyingType>;
+    constexpr size_t MIN_DENSE_SIZE = 64;
+    constexpr size_t ENTRIES_PER_MEMBER = 4;
+
+    auto min = static_cast<typename MetaEnumType::UnderlyingType>(meta.values.at(0));
+    auto max = min;
+    for (const auto value : meta.values)
+    {
+        min = std::min(min, static_cast<typename MetaEnumType::UnderlyingType>(value));
+        max = std::max(max, static_cast<typename MetaEnumType::UnderlyingType>(value));
+    }
+    const auto maxOffset = static_cast<Unsigned>(static_cast<Unsigned>(max) - static_cast<Unsigned>(min));
+    const size_t limit = std::max(MIN_DENSE_SIZE, ENTRIES_PER_MEMBER * meta.size());
+    return static_cast<uint64_t>(maxOffset) < limit ? static_cast<size_t>(maxOffset) + 1 : 0;
 }
 
+/**
+ * @brief All lookup tables of one enum, generated at compile time from the constexpr factory of its MetaEnum. Each
+ *        table is only instantiated if the corresponding function is used, which requires the functions generated by
+ *        ZBO_ENUM_IMPL to name the tables through their (dependent) template parameter.
+ */
+template <typename EnumType, typename UnderlyingType, typename MetaFactory>
+struct MetaEnumTables
+{
+    static constexpr auto META = MetaFactory{}();
+    static constexpr ValueLookup<EnumType, UnderlyingType, META.size(), denseTableSize(META)> VALUES{META};
+    static constexpr NameLookup<EnumType, META.size(), false> NAMES{META};
+    static constexpr NameLookup<EnumType, META.size(), true> NAMES_CASE_INSENSITIVE{META};
+};
+
 }  // namespace meta_enum_internal
 
 // NOLINTNEXTLINE (cppcoreguidelines-macro-usage)
@@ -187,59 +522,48 @@ constexpr std::array<EnumType, size> resolveEnumValuesArray(
     {                                                                                                            \
         __VA_ARGS__                                                                                              \
     };                                                                                                           \
-    constexpr static auto Type##_internal_size = []() constexpr                                                  \
+    constexpr static auto Type##_internal_meta = []() constexpr                                                  \
     {                                                                                                            \
+        /* the wrappers evaluate the initializers, members without one stay empty */                             \
         using IntWrapperType = ::zbo::meta_enum_internal::IntWrapper<UnderlyingType>;                            \
         IntWrapperType __VA_ARGS__;                                                                              \
-        return std::initializer_list<IntWrapperType>{__VA_ARGS__}.size();                                        \
+        /* the list is passed directly, a local would clash with a member of the same name */                    \
+        return ::zbo::meta_enum_internal::parseMetaEnum<Type, UnderlyingType>(#__VA_ARGS__, {__VA_ARGS__});      \
     };                                                                                                           \
-    inline Friend const auto& metaEnum(::zbo::meta_enum_internal::Tag<Type>)                                     \
+    template <class E = Type>                                                                                    \
+    constexpr Friend const auto& metaEnum(::zbo::meta_enum_internal::Tag<Type>)                                  \
+    {                                                                                                            \
+        using Tables = ::zbo::meta_enum_internal::MetaEnumTables<E, UnderlyingType,                              \
+                                                                 decltype(Type##_internal_meta)>;                \
+        return Tables::META;                                                                                     \
+    }                                                                                                            \
+    template <class E>                                                                                           \
+    constexpr Friend std::string_view enumToString(E e, ::zbo::meta_enum_internal::Tag<Type>)                    \
     {                                                                                                            \
-        static auto m = ::zbo::meta_enum_internal::parseMetaEnum<Type, UnderlyingType, Type##_internal_size()>(  \
-            #__VA_ARGS__, []() {                                                                                 \
-                using IntWrapperType = ::zbo::meta_enum_internal::IntWrapper<UnderlyingType>;                    \
-                IntWrapperType __VA_ARGS__;                                                                      \
-                return ::zbo::meta_enum_internal::resolveEnumValuesArray<Type, UnderlyingType,                   \
-                                                                         Type##_internal_size()>({__VA_ARGS__}); \
-            }());                                                                                                \
-        return m;                                                                                                \
+        using Tables = ::zbo::meta_enum_internal::MetaEnumTables<E, UnderlyingType,                              \
+                                                                 decltype(Type##_internal_meta)>;                \
+        return Tables::VALUES.name(e);                                                                           \
     }                                                                                                            \
     template <class E>                                                                                           \
-    Friend std::string_view enumToString(E e, ::zbo::meta_enum_internal::Tag<Type> tag)                          \
+    constexpr Friend size_t enumToIndex(E e, ::zbo::meta_enum_internal::Tag<Type>)                               \
     {                                                                                                            \
-        const auto& m = metaEnum(tag);                                                                           \
-        for (const auto& member : m.members)                                                                     \
-        {                                                                                                        \
-            if (member.value == e)                                                                               \
-            {                                                                                                    \
-                return member.name;                                                                              \
-            }                                                                                                    \
-        }                                                                                                        \
-        return std::string_view("__INVALID_ENUM_VAL__");                                                         \
+        using Tables = ::zbo::meta_enum_internal::MetaEnumTables<E, UnderlyingType,                              \
+                                                                 decltype(Type##_internal_meta)>;                \
+        return Tables::VALUES.index(e);                                                                          \
     }                                                                                                            \
     template <class E>                                                                                           \
-    Friend size_t enumToIndex(E e, ::zbo::meta_enum_internal::Tag<Type> tag)                                     \
+    constexpr Friend std::optional<Type> stringToEnum(std::string_view str,                                      \
+                                                      ::zbo::meta_enum_internal::Tag<Type>)                      \
     {                                                                                                            \
-        const auto& m = metaEnum(tag);                                                                           \
-        for (size_t i = 0; i < m.members.size(); ++i)                                                            \
-        {                                                                                                        \
-            if (m.members.at(i).value == e)                                                                      \
-            {                                                                                                    \
-                return i;                                                                                        \
-            }                                                                                                    \
-        }                                                                                                        \
-        return m.members.size();                                                                                 \
+        using Tables = ::zbo::meta_enum_internal::MetaEnumTables<E, UnderlyingType,                              \
+                                                                 decltype(Type##_internal_meta)>;                \
+        return Tables::NAMES.find(str);                                                                          \
     }                                                                                                            \
     template <class E>                                                                                           \
-    Friend std::optional<Type> stringToEnum(std::string_view str, ::zbo::meta_enum_internal::Tag<Type> tag)      \
+    constexpr Friend std::optional<Type> stringToEnumCaseInsensitive(std::string_view str,                       \
+                                                                     ::zbo::meta_enum_internal::Tag<Type>)       \
     {                                                                                                            \
-        const auto& m = metaEnum(tag);                                                                           \
-        for (const auto& member : m.members)                                                                     \
-        {                                                                                                        \
-            if (member.name == str)                                                                              \
-            {                                                                                                    \
-                return member.value;                                                                             \
-            }                                                                                                    \
-        }                                                                                                        \
-        return std::nullopt;                                                                                     \
+        using Tables = ::zbo::meta_enum_internal::MetaEnumTables<E, UnderlyingType,                              \
+                                                                 decltype(Type##_internal_meta)>;                \
+        return Tables::NAMES_CASE_INSENSITIVE.find(str);                                                         \
     }
@@ -0,0 +1,537 @@
+// MIT License
+//
+// Copyright (c) 2020 Lenzebo
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include "contracts.h"
+#include "meta_enum.h"
+#include "meta_enum_iterator.h"
+
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <initializer_list>
+#include <iterator>
+#include <optional>
+#include <utility>
+
+namespace zbo {
+
+namespace detail {
+template <typename E>
+constexpr size_t enumSize()
+{
+    return metaEnum<E>().size();
+}
+
+/// index of e in the members of E, values that are no member of E are a contract violation
+template <typename E>
+constexpr size_t checkedEnumIndex(E e)
+{
+    const size_t idx = enumToIndex(e);
+    ZBO_PRECONDITION(idx < enumSize<E>())
+    return idx;
+}
+
+/// number of distinct values of E, i.e. members that are no alias of an earlier member
+template <typename E>
+constexpr size_t uniqueEnumSize()
+{
+    const auto& meta = metaEnum<E>();
+    size_t count = 0;
+    for (size_t idx = 0; idx < meta.size(); ++idx)
+    {
+        count += enumToIndex(meta.values[idx]) == idx ? 1 : 0;
+    }
+    return count;
+}
+
+/// dense indices of the distinct values of E in declaration order, aliases share the index of their first member
+template <typename E>
+struct UniqueEnumIndices
+{
+    constexpr UniqueEnumIndices()
+    {
+        const auto& meta = metaEnum<E>();
+        size_t unique = 0;
+        for (size_t idx = 0; idx < meta.size(); ++idx)
+        {
+            const size_t first = enumToIndex(meta.values[idx]);
+            if (first == idx)
+            {
+                values[unique] = meta.values[idx];
+                indices[idx] = unique++;
+            }
+            else
+            {
+                indices[idx] = indices[first];
+            }
+        }
+    }
+
+    std::array<size_t, enumSize<E>()> indices{};
+    std::array<E, uniqueEnumSize<E>()> values{};
+};
+
+template <typename E>
+inline constexpr UniqueEnumIndices<E> UNIQUE_ENUM_INDICES{};
+
+/// index of the value of e in the distinct values of E, which is checkedEnumIndex if E has no aliases
+template <typename E>
+constexpr size_t uniqueEnumIndex(E e)
+{
+    const size_t idx = checkedEnumIndex(e);
+    if constexpr (uniqueEnumSize<E>() == enumSize<E>())
+    {
+        return idx;
+    }
+    else
+    {
+        return UNIQUE_ENUM_INDICES<E>.indices[idx];
+    }
+}
+}  // namespace detail
+
+/**
+ * @brief Fixed size array with one element per member of a ZBO_ENUM, indexed by the enum value. Aliases share the
+ *        element of the first member with their value.
+ *
+ * Usage:
+ *   EnumArray<Side, int64_t> volume{};
+ *   volume[Side::BUY] += 10;
+ *   for (auto side : MetaEnumRange<Side>()) { std::cout << enumToString(side) << volume[side]; }
+ *
+ * @tparam E enum registered with ZBO_ENUM
+ * @tparam T The value type within the container
+ */
+template <typename E, typename T>
+class EnumArray
+{
+    using Storage = std::array<T, detail::uniqueEnumSize<E>()>;
+
+  public:
+    using key_type = E;                                       // NOLINT (readability-identifier-naming)
+    using value_type = T;                                     // NOLINT (readability-identifier-naming)
+    using iterator = typename Storage::iterator;              // NOLINT (readability-identifier-naming)
+    using const_iterator = typename Storage::const_iterator;  // NOLINT (readability-identifier-naming)
+
+    constexpr EnumArray() = default;
+    explicit constexpr EnumArray(const T& value) { data_.fill(value); }
+
+    /// iterates the values in declaration order of the enum members
+    [[nodiscard]] constexpr iterator begin() noexcept { return data_.begin(); }
+    [[nodiscard]] constexpr iterator end() noexcept { return data_.end(); }
+    [[nodiscard]] constexpr const_iterator begin() const noexcept { return data_.begin(); }
+    [[nodiscard]] constexpr const_iterator end() const noexcept { return data_.end(); }
+
+    [[nodiscard]] constexpr size_t size() const noexcept { return data_.size(); }
+    [[nodiscard]] constexpr T* data() noexcept { return data_.data(); }
+    [[nodiscard]] constexpr const T* data() const noexcept { return data_.data(); }
+
+    constexpr void fill(const T& value) { data_.fill(value); }
+
+    [[nodiscard]] constexpr T& operator[](E e) { return data_[detail::uniqueEnumIndex(e)]; }
+    [[nodiscard]] constexpr const T& operator[](E e) const { return data_[detail::uniqueEnumIndex(e)]; }
+
+    [[nodiscard]] constexpr bool operator==(const EnumArray& other) const = default;
+
+  private:
+    Storage data_{};
+};
+
+/**
+ * @brief Set of members of a ZBO_ENUM stored as bitset with one bit per member. Aliases share the bit of the first
+ *        member with their value, so iteration and all() only yield that member.
+ *
+ * size() is a popcount and iteration scans for set bits, so both touch one word per 64 members. Iteration yields the
+ * members in declaration order. Set operations work on whole words.
+ *
+ * Usage:
+ *   EnumSet<Feature> enabled{Feature::LOGGING, Feature::METRICS};
+ *   enabled |= EnumSet<Feature>{Feature::TRACING};
+ *   for (Feature f : enabled) { ... }
+ *
+ * @tparam E enum registered with ZBO_ENUM
+ */
+template <typename E>
+class EnumSet
+{
+    static constexpr size_t NUM_ENUMS = detail::uniqueEnumSize<E>();
+    static constexpr size_t BITS_PER_WORD = 64;
+    static constexpr size_t NUM_WORDS = (NUM_ENUMS + BITS_PER_WORD - 1) / BITS_PER_WORD;
+    using Words = std::array<uint64_t, NUM_WORDS>;
+
+  public:
+    class Iterator
+    {
+      public:
+        using value_type = E;                                 // NOLINT (readability-identifier-naming)
+        using difference_type = std::ptrdiff_t;               // NOLINT (readability-identifier-naming)
+        using iterator_category = std::forward_iterator_tag;  // NOLINT (readability-identifier-naming)
+
+        constexpr Iterator() = default;
+        constexpr Iterator(const Words* words, size_t idx) : words_(words), idx_(nextSetBit(*words, idx)) {}
+
+        [[nodiscard]] constexpr E operator*() const { return detail::UNIQUE_ENUM_INDICES<E>.values[idx_]; }
+        constexpr Iterator& operator++()
+        {
+            idx_ = nextSetBit(*words_, idx_ + 1);
+            return *this;
+        }
+        constexpr Iterator operator++(int)
+        {
+            Iterator it = *this;
+            ++(*this);
+            return it;
+        }
+        [[nodiscard]] constexpr bool operator==(const Iterator& other) const noexcept { return idx_ == other.idx_; }
+        [[nodiscard]] constexpr bool operator!=(const Iterator& other) const noexcept { return !((*this) == other); }
+
+      private:
+        const Words* words_ = nullptr;
+        size_t idx_ = NUM_ENUMS;
+    };
+
+    using key_type = E;               // NOLINT (readability-identifier-naming)
+    using value_type = E;             // NOLINT (readability-identifier-naming)
+    using iterator = Iterator;        // NOLINT (readability-identifier-naming)
+    using const_iterator = Iterator;  // NOLINT (readability-identifier-naming)
+
+    constexpr EnumSet() = default;
+    constexpr EnumSet(std::initializer_list<E> values)
+    {
+        for (E e : values)
+        {
+            insert(e);
+        }
+    }
+
+    /// set containing all members of E
+    [[nodiscard]] static constexpr EnumSet all()
+    {
+        EnumSet set;
+        set.words_.fill(~uint64_t{0});
+        set.clearUnusedBits();
+        return set;
+    }
+
+    [[nodiscard]] constexpr Iterator begin() const noexcept { return {&words_, 0}; }
+    [[nodiscard]] constexpr Iterator end() const noexcept { return {&words_, NUM_ENUMS}; }
+
+    [[nodiscard]] constexpr size_t size() const noexcept
+    {
+        size_t count = 0;
+        for (uint64_t word : words_)
+        {
+            count += static_cast<size_t>(std::popcount(word));
+        }
+        return count;
+    }
+    [[nodiscard]] constexpr bool empty() const noexcept { return words_ == Words{}; }
+    [[nodiscard]] static constexpr size_t capacity() noexcept { return NUM_ENUMS; }
+    constexpr void clear() noexcept { words_ = Words{}; }
+
+    [[nodiscard]] constexpr bool contains(E e) const
+    {
+        const size_t idx = detail::uniqueEnumIndex(e);
+        return (words_[idx / BITS_PER_WORD] & bit(idx)) != 0;
+    }
+
+    /// adds e and returns whether it was not yet part of the set
+    constexpr bool insert(E e)
+    {
+        const size_t idx = detail::uniqueEnumIndex(e);
+        const bool inserted = (words_[idx / BITS_PER_WORD] & bit(idx)) == 0;
+        words_[idx / BITS_PER_WORD] |= bit(idx);
+        return inserted;
+    }
+
+    /// removes e and returns the number of removed elements (0 or 1)
+    constexpr size_t erase(E e)
+    {
+        const size_t idx = detail::uniqueEnumIndex(e);
+        const bool contained = (words_[idx / BITS_PER_WORD] & bit(idx)) != 0;
+        words_[idx / BITS_PER_WORD] &= ~bit(idx);
+        return contained ? 1 : 0;
+    }
+
+    [[nodiscard]] constexpr bool isSubsetOf(const EnumSet& other) const noexcept
+    {
+        for (size_t i = 0; i < NUM_WORDS; ++i)
+        {
+            if ((words_[i] & ~other.words_[i]) != 0)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    constexpr EnumSet& operator|=(const EnumSet& other) noexcept
+    {
+        for (size_t i = 0; i < NUM_WORDS; ++i)
+        {
+            words_[i] |= other.words_[i];
+        }
+        return *this;
+    }
+    constexpr EnumSet& operator&=(const EnumSet& other) noexcept
+    {
+        for (size_t i = 0; i < NUM_WORDS; ++i)
+        {
+            words_[i] &= other.words_[i];
+        }
+        return *this;
+    }
+    constexpr EnumSet& operator^=(const EnumSet& other) noexcept
+    {
+        for (size_t i = 0; i < NUM_WORDS; ++i)
+        {
+            words_[i] ^= other.words_[i];
+        }
+        return *this;
+    }
+    /// removes all elements of other from this set
+    constexpr EnumSet& operator-=(const EnumSet& other) noexcept
+    {
+        for (size_t i = 0; i < NUM_WORDS; ++i)
+        {
+            words_[i] &= ~other.words_[i];
+        }
+        return *this;
+    }
+
+    [[nodiscard]] friend constexpr EnumSet operator|(EnumSet lhs, const EnumSet& rhs) noexcept { return lhs |= rhs; }
+    [[nodiscard]] friend constexpr EnumSet operator&(EnumSet lhs, const EnumSet& rhs) noexcept { return lhs &= rhs; }
+    [[nodiscard]] friend constexpr EnumSet operator^(EnumSet lhs, const EnumSet& rhs) noexcept { return lhs ^= rhs; }
+    [[nodiscard]] friend constexpr EnumSet operator-(EnumSet lhs, const EnumSet& rhs) noexcept { return lhs -= rhs; }
+    /// complement with respect to all members of E
+    [[nodiscard]] constexpr EnumSet operator~() const noexcept { return all() - *this; }
+
+    [[nodiscard]] constexpr bool operator==(const EnumSet& other) const = default;
+
+  private:
+    [[nodiscard]] static constexpr uint64_t bit(size_t idx) noexcept { return uint64_t{1} << (idx % BITS_PER_WORD); }
+
+    /// returns the first set bit at or after idx or NUM_ENUMS if there is none
+    [[nodiscard]] static constexpr size_t nextSetBit(const Words& words, size_t idx) noexcept
+    {
+        size_t word = idx / BITS_PER_WORD;
+        if (word >= NUM_WORDS)
+        {
+            return NUM_ENUMS;
+        }
+        uint64_t remaining = words[word] & (~uint64_t{0} << (idx % BITS_PER_WORD));
+        while (remaining == 0)
+        {
+            if (++word == NUM_WORDS)
+            {
+                return NUM_ENUMS;
+            }
+            remaining = words[word];
+        }
+        return word * BITS_PER_WORD + static_cast<size_t>(std::countr_zero(remaining));
+    }
+
+    constexpr void clearUnusedBits() noexcept
+    {
+        if constexpr (NUM_ENUMS % BITS_PER_WORD != 0)
+        {
+            words_.back() &= (uint64_t{1} << (NUM_ENUMS % BITS_PER_WORD)) - 1;
+        }
+    }
+
+    Words words_{};
+};
+
+/**
+ * @brief Map from the members of a ZBO_ENUM to T, with one optional slot per member. Lookups are a direct index, no
+ *        hashing or comparisons involved. Use EnumArray instead if all members have a value anyway. Aliases share the
+ *        slot of the first member with their value.
+ *
+ * Usage:
+ *   EnumMap<MessageType, Handler> handlers;
+ *   handlers.insert(MessageType::ORDER, Handler{...});
+ *   if (Handler* handler = handlers.find(type)) { ... }
+ *   for (auto [type, handler] : handlers) { ... }
+ *
+ * @tparam E enum registered with ZBO_ENUM
+ * @tparam T The mapped type
+ */
+template <typename E, typename T>
+class EnumMap
+{
+    static constexpr size_t NUM_ENUMS = detail::uniqueEnumSize<E>();
+    using Slots = std::array<std::optional<T>, NUM_ENUMS>;
+
+    template <bool isConst>
+    class Iterator
+    {
+        using SlotsType = std::conditional_t<isConst, const Slots, Slots>;
+        using ValueRef = std::conditional_t<isConst, const T&, T&>;
+
+      public:
+        using value_type = std::pair<E, ValueRef>;            // NOLINT (readability-identifier-naming)
+        using difference_type = std::ptrdiff_t;               // NOLINT (readability-identifier-naming)
+        using iterator_category = std::forward_iterator_tag;  // NOLINT (readability-identifier-naming)
+
+        Iterator() = default;
+        Iterator(SlotsType* slots, size_t idx) : slots_(slots), idx_(idx) { skipEmpty(); }
+
+        [[nodiscard]] value_type operator*() const
+        {
+            return {detail::UNIQUE_ENUM_INDICES<E>.values[idx_], *(*slots_)[idx_]};
+        }
+        Iterator& operator++()
+        {
+            ++idx_;
+            skipEmpty();
+            return *this;
+        }
+        Iterator operator++(int)
+        {
+            Iterator it = *this;
+            ++(*this);
+            return it;
+        }
+        [[nodiscard]] bool operator==(const Iterator& other) const noexcept { return idx_ == other.idx_; }
+        [[nodiscard]] bool operator!=(const Iterator& other) const noexcept { return !((*this) == other); }
+
+      private:
+        void skipEmpty()
+        {
+            while (idx_ < NUM_ENUMS && !(*slots_)[idx_].has_value())
+            {
+                ++idx_;
+            }
+        }
+
+        SlotsType* slots_ = nullptr;
+        size_t idx_ = NUM_ENUMS;
+    };
+
+  public:
+    using key_type = E;                     // NOLINT (readability-identifier-naming)
+    using mapped_type = T;                  // NOLINT (readability-identifier-naming)
+    using iterator = Iterator<false>;       // NOLINT (readability-identifier-naming)
+    using const_iterator = Iterator<true>;  // NOLINT (readability-identifier-naming)
+
+    EnumMap() = default;
+
+    /// iterates the entries in declaration order of the enum members
+    [[nodiscard]] iterator begin() noexcept { return {&slots_, 0}; }
+    [[nodiscard]] iterator end() noexcept { return {&slots_, NUM_ENUMS}; }
+    [[nodiscard]] const_iterator begin() const noexcept { return {&slots_, 0}; }
+    [[nodiscard]] const_iterator end() const noexcept { return {&slots_, NUM_ENUMS}; }
+
+    [[nodiscard]] bool empty() const noexcept { return size_ == 0; }
+    [[nodiscard]] size_t size() const noexcept { return size_; }
+
+    void clear()
+    {
+        for (auto& slot : slots_)
+        {
+            slot.reset();
+        }
+        size_ = 0;
+    }
+
+    /**
+     * @brief inserts value under the given key if the key is not yet part of the map
+     * @return pointer to the value stored under key and whether the insertion took place
+     */
+    template <typename... Args>
+    std::pair<T*, bool> emplace(E key, Args&&... args)
+    {
+        auto& slot = slots_[detail::uniqueEnumIndex(key)];
+        if (slot.has_value())
+        {
+            return {&*slot, false};
+        }
+        slot.emplace(std::forward<Args>(args)...);
+        ++size_;
+        return {&*slot, true};
+    }
+
+    std::pair<T*, bool> insert(E key, const T& value) { return emplace(key, value); }
+    std::pair<T*, bool> insert(E key, T&& value) { return emplace(key, std::move(value)); }
+
+    /// returns the value stored under key, inserting a default constructed one if it does not exist yet
+    T& operator[](E key) { return *emplace(key).first; }
+
+    /// returns a pointer to the value stored under key or nullptr if the map does not contain key
+    [[nodiscard]] T* find(E key) noexcept
+    {
+        auto& slot = slots_[detail::uniqueEnumIndex(key)];
+        return slot.has_value() ? &*slot : nullptr;
+    }
+    [[nodiscard]] const T* find(E key) const noexcept
+    {
+        const auto& slot = slots_[detail::uniqueEnumIndex(key)];
+        return slot.has_value() ? &*slot : nullptr;
+    }
+
+    [[nodiscard]] bool contains(E key) const noexcept { return slots_[detail::uniqueEnumIndex(key)].has_value(); }
+
+    [[nodiscard]] T& at(E key)
+    {
+        T* value = find(key);
+        ZBO_PRECONDITION(value != nullptr)
+        return *value;
+    }
+    [[nodiscard]] const T& at(E key) const
+    {
+        const T* value = find(key);
+        ZBO_PRECONDITION(value != nullptr)
+        return *value;
+    }
+
+    /// removes key from the map and returns the number of removed elements (0 or 1)
+    size_t erase(E key)
+    {
+        auto& slot = slots_[detail::uniqueEnumIndex(key)];
+        if (!slot.has_value())
+        {
+            return 0;
+        }
+        slot.reset();
+        --size_;
+        return 1;
+    }
+
+    /// returns the set of keys that have a value
+    [[nodiscard]] EnumSet<E> keys() const
+    {
+        EnumSet<E> result;
+        for (auto entry : *this)
+        {
+            result.insert(entry.first);
+        }
+        return result;
+    }
+
+  private:
+    Slots slots_{};
+    size_t size_ = 0;
+};
+
+}  // namespace zbo
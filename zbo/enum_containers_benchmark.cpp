@@ -0,0 +1,200 @@
+#include "enum_containers.h"
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <iterator>
+#include <map>
+#include <random>
+#include <set>
+#include <unordered_map>
+#include <vector>
+
+// NOLINTNEXTLINE (cppcoreguidelines-macro-usage)
+#define ZBO_BENCH_EIGHT(P) P##_NEW, P##_ACK, P##_FILL, P##_PARTIAL, P##_CANCEL, P##_REPLACE, P##_REJECT, P##_EXPIRE
+
+ZBO_ENUM_CLASS(Event, uint16_t, ZBO_BENCH_EIGHT(ORDER), ZBO_BENCH_EIGHT(QUOTE), ZBO_BENCH_EIGHT(TRADE),
+               ZBO_BENCH_EIGHT(AUCTION), ZBO_BENCH_EIGHT(MARKET), ZBO_BENCH_EIGHT(SESSION))
+
+namespace zbo::bench {
+
+constexpr size_t NUM_EVENTS = 4096;
+
+std::vector<Event> randomEvents()
+{
+    std::mt19937 gen{42};
+    const auto& values = metaEnum<Event>().values;
+    std::uniform_int_distribution<size_t> dist{0, values.size() - 1};
+    std::vector<Event> events(NUM_EVENTS);
+    for (auto& event : events)
+    {
+        event = values.at(dist(gen));
+    }
+    return events;
+}
+
+template <typename Counters>
+void countEvents(benchmark::State& state)
+{
+    const auto events = randomEvents();
+    Counters counters{};
+    for (auto _ : state)
+    {
+        for (const auto event : events)
+        {
+            ++counters[event];
+        }
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(events.size()));
+}
+
+template <typename Map>
+void lookupHalfFilledMap(benchmark::State& state)
+{
+    const auto events = randomEvents();
+    Map map;
+    for (auto event : MetaEnumRange<Event>())
+    {
+        if (enumToIndex(event) % 2 == 0)
+        {
+            map[event] = static_cast<int64_t>(event);
+        }
+    }
+    for (auto _ : state)
+    {
+        int64_t sum = 0;
+        for (const auto event : events)
+        {
+            if constexpr (std::is_same_v<Map, EnumMap<Event, int64_t>>)
+            {
+                const int64_t* value = map.find(event);
+                sum += value != nullptr ? *value : 0;
+            }
+            else
+            {
+                const auto it = map.find(event);
+                sum += it != map.end() ? it->second : 0;
+            }
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(events.size()));
+}
+
+template <typename Set>
+Set randomSet(std::mt19937& gen)
+{
+    Set set;
+    for (auto event : MetaEnumRange<Event>())
+    {
+        if (gen() % 2 == 0)
+        {
+            set.insert(event);
+        }
+    }
+    return set;
+}
+
+void enumSetUnion(benchmark::State& state)
+{
+    std::mt19937 gen{42};
+    const auto lhs = randomSet<EnumSet<Event>>(gen);
+    const auto rhs = randomSet<EnumSet<Event>>(gen);
+    for (auto _ : state)
+    {
+        const auto result = lhs | rhs;
+        benchmark::DoNotOptimize(result.size());
+    }
+}
+
+void stdSetUnion(benchmark::State& state)
+{
+    std::mt19937 gen{42};
+    const auto lhs = randomSet<std::set<Event>>(gen);
+    const auto rhs = randomSet<std::set<Event>>(gen);
+    for (auto _ : state)
+    {
+        std::set<Event> result = lhs;
+        result.insert(rhs.begin(), rhs.end());
+        benchmark::DoNotOptimize(result.size());
+    }
+}
+
+void enumSetIntersection(benchmark::State& state)
+{
+    std::mt19937 gen{42};
+    const auto lhs = randomSet<EnumSet<Event>>(gen);
+    const auto rhs = randomSet<EnumSet<Event>>(gen);
+    for (auto _ : state)
+    {
+        const auto result = lhs & rhs;
+        benchmark::DoNotOptimize(result.size());
+    }
+}
+
+void stdSetIntersection(benchmark::State& state)
+{
+    std::mt19937 gen{42};
+    const auto lhs = randomSet<std::set<Event>>(gen);
+    const auto rhs = randomSet<std::set<Event>>(gen);
+    for (auto _ : state)
+    {
+        std::set<Event> result;
+        std::set_intersection(lhs.begin(), lhs.end(), rhs.begin(), rhs.end(), std::inserter(result, result.end()));
+        benchmark::DoNotOptimize(result.size());
+    }
+}
+
+template <typename Set>
+void setContains(benchmark::State& state)
+{
+    std::mt19937 gen{42};
+    const auto set = randomSet<Set>(gen);
+    const auto events = randomEvents();
+    for (auto _ : state)
+    {
+        size_t count = 0;
+        for (const auto event : events)
+        {
+            count += set.contains(event) ? 1 : 0;
+        }
+        benchmark::DoNotOptimize(count);
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(events.size()));
+}
+
+template <typename Set>
+void setIterate(benchmark::State& state)
+{
+    std::mt19937 gen{42};
+    const auto set = randomSet<Set>(gen);
+    for (auto _ : state)
+    {
+        int64_t sum = 0;
+        for (const auto event : set)
+        {
+            sum += static_cast<int64_t>(event);
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+}
+
+BENCHMARK_TEMPLATE(countEvents, EnumArray<Event, int64_t>);
+BENCHMARK_TEMPLATE(countEvents, std::map<Event, int64_t>);
+BENCHMARK_TEMPLATE(countEvents, std::unordered_map<Event, int64_t>);
+BENCHMARK_TEMPLATE(lookupHalfFilledMap, EnumMap<Event, int64_t>);
+BENCHMARK_TEMPLATE(lookupHalfFilledMap, std::map<Event, int64_t>);
+BENCHMARK_TEMPLATE(lookupHalfFilledMap, std::unordered_map<Event, int64_t>);
+BENCHMARK(enumSetUnion);
+BENCHMARK(stdSetUnion);
+BENCHMARK(enumSetIntersection);
+BENCHMARK(stdSetIntersection);
+BENCHMARK_TEMPLATE(setContains, EnumSet<Event>);
+BENCHMARK_TEMPLATE(setContains, std::set<Event>);
+BENCHMARK_TEMPLATE(setIterate, EnumSet<Event>);
+BENCHMARK_TEMPLATE(setIterate, std::set<Event>);
+
+}  // namespace zbo::bench
+
+BENCHMARK_MAIN();
@@ -0,0 +1,198 @@
+#include "enum_containers.h"
+#include "meta_enum_iterator.h"
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+namespace zbo::test {
+
+ZBO_ENUM_CLASS(Side, uint8_t, BUY, SELL)
+ZBO_ENUM_CLASS(Sparse, int, A = 100, B = -3, C = 2000, ALIAS_A = 100, D = 7)
+ZBO_ENUM_CLASS(Aliased, int, A = 1, B = 2, B2 = 2, C = 3)
+
+// NOLINTNEXTLINE (cppcoreguidelines-macro-usage)
+#define ZBO_TEST_TEN(P) P##0, P##1, P##2, P##3, P##4, P##5, P##6, P##7, P##8, P##9
+ZBO_ENUM_CLASS(Wide, uint16_t, ZBO_TEST_TEN(A), ZBO_TEST_TEN(B), ZBO_TEST_TEN(C), ZBO_TEST_TEN(D), ZBO_TEST_TEN(E),
+               ZBO_TEST_TEN(F), ZBO_TEST_TEN(G), ZBO_TEST_TEN(H), LAST)
+
+static_assert(sizeof(EnumSet<Side>) == sizeof(uint64_t));
+static_assert(sizeof(EnumSet<Wide>) == 2 * sizeof(uint64_t));
+static_assert(EnumSet<Wide>::all().size() == 81);
+static_assert(EnumSet<Sparse>{Sparse::B, Sparse::D}.contains(Sparse::D));
+
+TEST(EnumArray, IndexByEnum)
+{
+    EnumArray<Sparse, int> counters{};
+    ASSERT_EQ(counters.size(), 4);
+    counters[Sparse::C] += 2;
+    counters[Sparse::D] += 3;
+    counters[Sparse::ALIAS_A] += 1;
+    ASSERT_EQ(counters[Sparse::A], 1);
+
+    std::vector<int> inOrder;
+    for (auto e : MetaEnumRange<Sparse>())
+    {
+        inOrder.push_back(counters[e]);
+    }
+    ASSERT_EQ(inOrder, (std::vector<int>{1, 0, 2, 1, 3}));
+    ASSERT_EQ(std::vector<int>(counters.begin(), counters.end()), (std::vector<int>{1, 0, 2, 3}));
+
+    const EnumArray<Side, std::string> names{"n/a"};
+    ASSERT_EQ(names[Side::SELL], "n/a");
+}
+
+TEST(EnumArray, InvalidValueDeath)
+{
+    EnumArray<Sparse, int> counters{};
+    ASSERT_DEATH(counters[static_cast<Sparse>(5)]++, "");
+}
+
+TEST(EnumSet, InsertErase)
+{
+    EnumSet<Sparse> set;
+    ASSERT_TRUE(set.empty());
+    ASSERT_TRUE(set.insert(Sparse::C));
+    ASSERT_FALSE(set.insert(Sparse::C));
+    ASSERT_TRUE(set.insert(Sparse::A));
+    ASSERT_TRUE(set.contains(Sparse::ALIAS_A));
+    ASSERT_FALSE(set.contains(Sparse::D));
+    ASSERT_EQ(set.size(), 2);
+
+    ASSERT_EQ(set.erase(Sparse::D), 0);
+    ASSERT_EQ(set.erase(Sparse::A), 1);
+    ASSERT_EQ(set.size(), 1);
+    set.clear();
+    ASSERT_TRUE(set.empty());
+}
+
+TEST(EnumSet, IterationInDeclarationOrder)
+{
+    const EnumSet<Sparse> set{Sparse::D, Sparse::A, Sparse::C};
+    ASSERT_EQ(std::vector<Sparse>(set.begin(), set.end()), (std::vector<Sparse>{Sparse::A, Sparse::C, Sparse::D}));
+
+    const EnumSet<Wide> wide{Wide::LAST, Wide::A3, Wide::G9, Wide::G0};
+    const std::vector<Wide> expectedWide{Wide::A3, Wide::G0, Wide::G9, Wide::LAST};
+    ASSERT_EQ(std::vector<Wide>(wide.begin(), wide.end()), expectedWide);
+
+    const auto all = EnumSet<Wide>::all();
+    size_t count = 0;
+    auto range = MetaEnumRange<Wide>();
+    auto expected = range.begin();
+    for (Wide w : all)
+    {
+        ASSERT_EQ(w, *expected++);
+        ++count;
+    }
+    ASSERT_EQ(count, 81);
+    ASSERT_TRUE(EnumSet<Wide>{}.begin() == EnumSet<Wide>{}.end());
+}
+
+TEST(EnumSet, SetOperations)
+{
+    const EnumSet<Wide> lhs{Wide::A0, Wide::D5, Wide::LAST};
+    const EnumSet<Wide> rhs{Wide::D5, Wide::H9};
+
+    ASSERT_EQ(lhs | rhs, (EnumSet<Wide>{Wide::A0, Wide::D5, Wide::H9, Wide::LAST}));
+    ASSERT_EQ(lhs & rhs, (EnumSet<Wide>{Wide::D5}));
+    ASSERT_EQ(lhs ^ rhs, (EnumSet<Wide>{Wide::A0, Wide::H9, Wide::LAST}));
+    ASSERT_EQ(lhs - rhs, (EnumSet<Wide>{Wide::A0, Wide::LAST}));
+    ASSERT_EQ((~lhs).size(), 78);
+    ASSERT_FALSE((~lhs).contains(Wide::LAST));
+    ASSERT_TRUE((lhs & rhs).isSubsetOf(lhs));
+    ASSERT_FALSE(lhs.isSubsetOf(rhs));
+    ASSERT_EQ(~EnumSet<Wide>::all(), EnumSet<Wide>{});
+}
+
+TEST(EnumSet, AliasesShareTheBitOfTheirFirstMember)
+{
+    static_assert(EnumSet<Aliased>::capacity() == 3);
+    const auto all = EnumSet<Aliased>::all();
+    ASSERT_EQ(all.size(), 3);
+    ASSERT_EQ(std::vector<Aliased>(all.begin(), all.end()), (std::vector<Aliased>{Aliased::A, Aliased::B, Aliased::C}));
+    ASSERT_TRUE(all.contains(Aliased::B2));
+
+    const auto complement = ~EnumSet<Aliased>{Aliased::B};
+    ASSERT_EQ(complement.size(), 2);
+    ASSERT_FALSE(complement.contains(Aliased::B2));
+    ASSERT_EQ(complement, (EnumSet<Aliased>{Aliased::A, Aliased::C}));
+    ASSERT_EQ(~EnumSet<Aliased>{Aliased::B2}, complement);
+
+    EnumSet<Aliased> set{Aliased::B2};
+    ASSERT_FALSE(set.insert(Aliased::B));
+    ASSERT_EQ(set.size(), 1);
+    ASSERT_EQ(*set.begin(), Aliased::B);
+    ASSERT_EQ(set.erase(Aliased::B), 1);
+    ASSERT_TRUE(set.empty());
+}
+
+TEST(EnumArray, AliasesShareTheElementOfTheirFirstMember)
+{
+    EnumArray<Aliased, int> counters{};
+    ASSERT_EQ(counters.size(), 3);
+    counters[Aliased::B2] = 5;
+    ASSERT_EQ(counters[Aliased::B], 5);
+    ASSERT_EQ(std::vector<int>(counters.begin(), counters.end()), (std::vector<int>{0, 5, 0}));
+}
+
+TEST(EnumMap, AliasesShareTheSlotOfTheirFirstMember)
+{
+    EnumMap<Aliased, std::string> map;
+    map[Aliased::B2] = "b";
+    ASSERT_EQ(map.at(Aliased::B), "b");
+    ASSERT_FALSE(map.insert(Aliased::B, "other").second);
+    map[Aliased::C] = "c";
+    std::vector<Aliased> keys;
+    for (const auto& entry : map)
+    {
+        keys.push_back(entry.first);
+    }
+    ASSERT_EQ(keys, (std::vector<Aliased>{Aliased::B, Aliased::C}));
+    ASSERT_EQ(map.keys(), (EnumSet<Aliased>{Aliased::B, Aliased::C}));
+}
+
+TEST(EnumMap, InsertFindErase)
+{
+    EnumMap<Sparse, std::string> map;
+    ASSERT_TRUE(map.empty());
+    ASSERT_TRUE(map.insert(Sparse::C, "c").second);
+    ASSERT_FALSE(map.insert(Sparse::C, "other").second);
+    ASSERT_EQ(map.at(Sparse::C), "c");
+    map[Sparse::B] = "b";
+    ASSERT_EQ(map.size(), 2);
+    ASSERT_EQ(map.find(Sparse::D), nullptr);
+    ASSERT_EQ(*map.find(Sparse::B), "b");
+    ASSERT_TRUE(map.contains(Sparse::B));
+
+    ASSERT_EQ(map.erase(Sparse::D), 0);
+    ASSERT_EQ(map.erase(Sparse::B), 1);
+    ASSERT_FALSE(map.contains(Sparse::B));
+    ASSERT_EQ(map.size(), 1);
+    map.clear();
+    ASSERT_TRUE(map.empty());
+    ASSERT_DEATH((void)map.at(Sparse::C), "");
+}
+
+TEST(EnumMap, Iteration)
+{
+    EnumMap<Wide, int> map;
+    map[Wide::LAST] = 3;
+    map[Wide::B1] = 1;
+    map[Wide::F2] = 2;
+
+    std::vector<std::pair<Wide, int>> entries;
+    for (auto [key, value] : map)
+    {
+        entries.emplace_back(key, value);
+        ++value;
+    }
+    ASSERT_EQ(entries, (std::vector<std::pair<Wide, int>>{{Wide::B1, 1}, {Wide::F2, 2}, {Wide::LAST, 3}}));
+    ASSERT_EQ(map.at(Wide::F2), 3);
+    ASSERT_EQ(map.keys(), (EnumSet<Wide>{Wide::B1, Wide::F2, Wide::LAST}));
+
+    const auto& constMap = map;
+    ASSERT_EQ(std::distance(constMap.begin(), constMap.end()), 3);
+}
+
+}  // namespace zbo::test
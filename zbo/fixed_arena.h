@@ -0,0 +1,197 @@
+// MIT License
+//
+// Copyright (c) 2020 Lenzebo
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#pragma once
+
+#include "contracts.h"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory_resource>
+#include <new>
+
+namespace zbo {
+
+/**
+ * @brief Monotonic memory resource with an inline buffer of a fixed size, for scratch memory that is released all at
+ *        once, e.g. per tick or per request.
+ *
+ * Allocations bump a pointer through the buffer, deallocations are no-ops and reset() releases everything in O(1).
+ * This makes allocations as cheap and deterministic as a MaxSizeVector, while any std::pmr container can live in the
+ * arena. Once the buffer is exhausted, allocations are forwarded to the optional upstream resource and counted, so the
+ * size of the arena can be tuned for the workload. Memory of the upstream is kept until the next reset() or rollback(),
+ * just like the buffer. Without an upstream, exhausting the buffer is a contract violation.
+ *
+ * A checkpoint marks the current state of the arena and rollback() releases everything allocated after it, which
+ * allows nesting short-lived scratch memory into a longer living one.
+ *
+ * Usage:
+ *   FixedArena<64 * 1024> arena(std::pmr::new_delete_resource());
+ *   while (running)
+ *   {
+ *       std::pmr::vector<Order> orders(&arena);
+ *       {
+ *           const auto scope = arena.scopedCheckpoint();
+ *           std::pmr::unordered_map<OrderId, Fill> fills(&arena);
+ *           ...  // fills is released when scope goes out of scope
+ *       }
+ *       arena.reset();  // all containers of the arena need to be destroyed before
+ *   }
+ *
+ * @tparam bytes size of the inline buffer
+ */
+template <size_t bytes>
+class FixedArena : public std::pmr::memory_resource
+{
+    struct UpstreamBlock;
+
+  public:
+    /// state of the arena that can be restored with rollback()
+    struct Checkpoint
+    {
+        size_t used = 0;
+        UpstreamBlock* upstreamBlocks = nullptr;
+    };
+
+    /// rolls the arena back to the state of its construction when going out of scope
+    class ScopedCheckpoint
+    {
+      public:
+        explicit ScopedCheckpoint(FixedArena& arena) : arena_(arena), checkpoint_(arena.checkpoint()) {}
+        ScopedCheckpoint(const ScopedCheckpoint&) = delete;
+        ScopedCheckpoint& operator=(const ScopedCheckpoint&) = delete;
+        ~ScopedCheckpoint() { arena_.rollback(checkpoint_); }
+
+      private:
+        FixedArena& arena_;
+        Checkpoint checkpoint_;
+    };
+
+    /// an arena without upstream, exhausting the buffer is a contract violation
+    FixedArena() = default;
+    explicit FixedArena(std::pmr::memory_resource* upstream) : upstream_(upstream) {}
+    FixedArena(const FixedArena&) = delete;
+    FixedArena& operator=(const FixedArena&) = delete;
+    ~FixedArena() override { releaseUpstream(nullptr); }
+
+    /// releases all memory, containers allocated from the arena must not be used anymore
+    void reset() noexcept { rollback(Checkpoint{}); }
+
+    [[nodiscard]] Checkpoint checkpoint() const noexcept { return Checkpoint{used_, upstreamBlocks_}; }
+    [[nodiscard]] ScopedCheckpoint scopedCheckpoint() { return ScopedCheckpoint(*this); }
+
+    /**
+     * @brief releases all memory allocated after checkpoint was taken
+     *
+     * Checkpoints taken after the given one become invalid, as well as all checkpoints when calling reset().
+     */
+    void rollback(const Checkpoint& checkpoint) noexcept
+    {
+        ZBO_PRECONDITION(checkpoint.used <= used_)
+        releaseUpstream(checkpoint.upstreamBlocks);
+        used_ = checkpoint.used;
+    }
+
+    [[nodiscard]] static constexpr size_t capacity() noexcept { return bytes; }
+    /// bytes of the inline buffer in use, including padding for alignment
+    [[nodiscard]] size_t used() const noexcept { return used_; }
+    [[nodiscard]] size_t remaining() const noexcept { return bytes - used_; }
+    [[nodiscard]] std::pmr::memory_resource* upstream() const noexcept { return upstream_; }
+
+    /// number of allocations forwarded to the upstream since construction
+    [[nodiscard]] size_t upstreamAllocations() const noexcept { return upstreamAllocations_; }
+    /// bytes requested from the upstream since construction
+    [[nodiscard]] size_t upstreamBytes() const noexcept { return upstreamBytes_; }
+
+  private:
+    /// header in front of every allocation of the upstream, to release them on reset() or rollback()
+    struct UpstreamBlock
+    {
+        UpstreamBlock* next = nullptr;
+        size_t size = 0;
+        size_t alignment = 0;
+    };
+
+    void* do_allocate(size_t size, size_t alignment) override
+    {
+        // aligns the address instead of the offset, as alignment may exceed the alignment of the buffer
+        const auto begin = reinterpret_cast<std::uintptr_t>(buffer_.data());  // NOLINT (cppcoreguidelines-pro-type-*)
+        const std::uintptr_t aligned = (begin + used_ + alignment - 1) & ~(alignment - 1);
+        // compares without adding size, which would wrap for huge requests and hand out memory that is in use
+        if (aligned > begin + bytes || size > begin + bytes - aligned) ZBO_UNLIKELY
+            {
+                return allocateUpstream(size, alignment);
+            }
+        used_ = aligned + size - begin;
+        return buffer_.data() + (aligned - begin);
+    }
+
+    void do_deallocate(void* /*pointer*/, size_t /*size*/, size_t /*alignment*/) override {}
+
+    [[nodiscard]] bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override
+    {
+        return this == &other;
+    }
+
+    void* allocateUpstream(size_t size, size_t alignment)
+    {
+        ZBO_PRECONDITION(upstream_ != nullptr)
+        // the header goes in front of the allocation, padded so that the allocation keeps its alignment
+        const size_t blockAlignment = std::max(alignment, alignof(UpstreamBlock));
+        const size_t headerSize = (sizeof(UpstreamBlock) + blockAlignment - 1) & ~(blockAlignment - 1);
+        if (size > std::numeric_limits<size_t>::max() - headerSize) ZBO_UNLIKELY
+            {
+                throw std::bad_alloc();
+            }
+        const size_t blockSize = headerSize + size;
+        auto* memory = static_cast<std::byte*>(upstream_->allocate(blockSize, blockAlignment));
+
+        upstreamBlocks_ = new (memory) UpstreamBlock{upstreamBlocks_, blockSize, blockAlignment};
+        ++upstreamAllocations_;
+        upstreamBytes_ += size;
+        return memory + headerSize;
+    }
+
+    /// releases all blocks of the upstream that have been allocated after last
+    void releaseUpstream(UpstreamBlock* last) noexcept
+    {
+        while (upstreamBlocks_ != last)
+        {
+            UpstreamBlock* block = upstreamBlocks_;
+            upstreamBlocks_ = block->next;
+            upstream_->deallocate(block, block->size, block->alignment);
+        }
+    }
+
+    alignas(std::max_align_t) std::array<std::byte, bytes> buffer_;
+    size_t used_ = 0;
+    std::pmr::memory_resource* upstream_ = nullptr;
+    UpstreamBlock* upstreamBlocks_ = nullptr;
+    size_t upstreamAllocations_ = 0;
+    size_t upstreamBytes_ = 0;
+};
+
+}  // namespace zbo
@@ -0,0 +1,82 @@
+#include "fixed_arena.h"
+
+#include <benchmark/benchmark.h>
+
+#include <memory>
+#include <memory_resource>
+#include <unordered_map>
+#include <vector>
+
+namespace zbo::bench {
+
+constexpr size_t ARENA_BYTES = 4 * 1024 * 1024;
+
+/// a tick that collects values in a vector
+void fillVector(std::pmr::memory_resource* resource, int count)
+{
+    std::pmr::vector<int> values(resource);
+    for (int idx = 0; idx < count; ++idx)
+    {
+        values.push_back(idx);
+    }
+    benchmark::DoNotOptimize(values.data());
+}
+
+/// a tick that aggregates values by key, every node is a separate allocation
+void fillMap(std::pmr::memory_resource* resource, int count)
+{
+    std::pmr::unordered_map<int, int> values(resource);
+    for (int idx = 0; idx < count; ++idx)
+    {
+        values[idx * 7] += idx;
+    }
+    benchmark::DoNotOptimize(values.size());
+}
+
+template <void (*workload)(std::pmr::memory_resource*, int)>
+void defaultAllocator(benchmark::State& state)
+{
+    for (auto _ : state)
+    {
+        workload(std::pmr::get_default_resource(), static_cast<int>(state.range(0)));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+/// the closest alternative of the standard library, which allocates its buffer upfront as well
+template <void (*workload)(std::pmr::memory_resource*, int)>
+void monotonicBuffer(benchmark::State& state)
+{
+    auto buffer = std::make_unique<std::byte[]>(ARENA_BYTES);
+    for (auto _ : state)
+    {
+        std::pmr::monotonic_buffer_resource resource(buffer.get(), ARENA_BYTES);
+        workload(&resource, static_cast<int>(state.range(0)));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template <void (*workload)(std::pmr::memory_resource*, int)>
+void fixedArena(benchmark::State& state)
+{
+    auto arena = std::make_unique<FixedArena<ARENA_BYTES>>(std::pmr::new_delete_resource());
+    for (auto _ : state)
+    {
+        workload(arena.get(), static_cast<int>(state.range(0)));
+        arena->reset();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    state.counters["upstreamAllocations"] = static_cast<double>(arena->upstreamAllocations());
+}
+
+BENCHMARK_TEMPLATE(defaultAllocator, fillVector)->RangeMultiplier(8)->Range(8, 32768);
+BENCHMARK_TEMPLATE(monotonicBuffer, fillVector)->RangeMultiplier(8)->Range(8, 32768);
+BENCHMARK_TEMPLATE(fixedArena, fillVector)->RangeMultiplier(8)->Range(8, 32768);
+
+BENCHMARK_TEMPLATE(defaultAllocator, fillMap)->RangeMultiplier(8)->Range(8, 32768);
+BENCHMARK_TEMPLATE(monotonicBuffer, fillMap)->RangeMultiplier(8)->Range(8, 32768);
+BENCHMARK_TEMPLATE(fixedArena, fillMap)->RangeMultiplier(8)->Range(8, 32768);
+
+}  // namespace zbo::bench
+
+BENCHMARK_MAIN();
@@ -0,0 +1,183 @@
+#include "fixed_arena.h"
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <limits>
+#include <memory_resource>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace zbo::test {
+
+/// counts the outstanding allocations to check that the arena releases everything it got from its upstream
+class CountingResource : public std::pmr::memory_resource
+{
+  public:
+    int outstanding = 0;
+
+  private:
+    void* do_allocate(size_t size, size_t alignment) override
+    {
+        ++outstanding;
+        return std::pmr::new_delete_resource()->allocate(size, alignment);
+    }
+    void do_deallocate(void* pointer, size_t size, size_t alignment) override
+    {
+        --outstanding;
+        std::pmr::new_delete_resource()->deallocate(pointer, size, alignment);
+    }
+    [[nodiscard]] bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override
+    {
+        return this == &other;
+    }
+};
+
+bool isAligned(const void* pointer, size_t alignment)
+{
+    return reinterpret_cast<std::uintptr_t>(pointer) % alignment == 0;  // NOLINT (cppcoreguidelines-pro-type-*)
+}
+
+TEST(FixedArena, BumpAllocatesAligned)
+{
+    FixedArena<1024> arena;
+    void* first = arena.allocate(3, 1);
+    ASSERT_EQ(arena.used(), 3);
+    void* second = arena.allocate(8, 8);
+    ASSERT_TRUE(isAligned(second, 8));
+    ASSERT_EQ(static_cast<std::byte*>(second) - static_cast<std::byte*>(first), 8);
+    void* third = arena.allocate(64, 256);
+    ASSERT_TRUE(isAligned(third, 256));
+    ASSERT_LE(arena.used(), 256 + 64);
+    ASSERT_EQ(arena.remaining(), arena.capacity() - arena.used());
+
+    // deallocating does not give the memory back
+    arena.deallocate(third, 64, 256);
+    ASSERT_LE(arena.used(), 256 + 64);
+
+    arena.reset();
+    ASSERT_EQ(arena.used(), 0);
+    ASSERT_EQ(arena.allocate(3, 1), first);
+}
+
+TEST(FixedArena, HoldsStlContainers)
+{
+    FixedArena<16 * 1024> arena;
+    std::pmr::vector<int> vector(&arena);
+    std::pmr::unordered_map<int, std::pmr::string> map(&arena);
+    for (int idx = 0; idx < 100; ++idx)
+    {
+        vector.push_back(idx);
+        map.emplace(idx, std::to_string(idx) + " is a long string that does not fit into the small buffer");
+    }
+    ASSERT_EQ(vector.size(), 100);
+    ASSERT_EQ(map.at(42).substr(0, 5), "42 is");
+    ASSERT_EQ(map.at(42).get_allocator().resource(), &arena);
+    ASSERT_EQ(arena.upstreamAllocations(), 0);
+}
+
+TEST(FixedArena, FallsBackToUpstream)
+{
+    CountingResource upstream;
+    FixedArena<64> arena(&upstream);
+    (void)arena.allocate(48, 8);
+    ASSERT_EQ(arena.upstreamAllocations(), 0);
+
+    void* fallback = arena.allocate(32, 64);
+    ASSERT_TRUE(isAligned(fallback, 64));
+    (void)arena.allocate(1000, 8);
+    ASSERT_EQ(arena.upstreamAllocations(), 2);
+    ASSERT_EQ(arena.upstreamBytes(), 1032);
+    ASSERT_EQ(upstream.outstanding, 2);
+
+    // small allocations still go to the buffer
+    void* small = arena.allocate(8, 8);
+    ASSERT_TRUE(isAligned(small, 8));
+    ASSERT_EQ(arena.upstreamAllocations(), 2);
+    ASSERT_EQ(arena.used(), 56);
+
+    arena.reset();
+    ASSERT_EQ(upstream.outstanding, 0);
+    // the counters are kept to tune the size of the arena
+    ASSERT_EQ(arena.upstreamAllocations(), 2);
+
+    (void)arena.allocate(100, 8);
+    ASSERT_EQ(upstream.outstanding, 1);
+}
+
+TEST(FixedArena, DestructorReleasesUpstream)
+{
+    CountingResource upstream;
+    {
+        FixedArena<16> arena(&upstream);
+        (void)arena.allocate(100, 8);
+        ASSERT_EQ(upstream.outstanding, 1);
+    }
+    ASSERT_EQ(upstream.outstanding, 0);
+}
+
+TEST(FixedArena, RollbackToCheckpoint)
+{
+    CountingResource upstream;
+    FixedArena<128> arena(&upstream);
+    (void)arena.allocate(16, 8);
+    (void)arena.allocate(200, 8);
+    const auto checkpoint = arena.checkpoint();
+
+    void* afterCheckpoint = arena.allocate(32, 8);
+    (void)arena.allocate(300, 8);
+    ASSERT_EQ(arena.used(), 48);
+    ASSERT_EQ(upstream.outstanding, 2);
+
+    arena.rollback(checkpoint);
+    ASSERT_EQ(arena.used(), 16);
+    ASSERT_EQ(upstream.outstanding, 1);
+    // the buffer behind the checkpoint is handed out again
+    ASSERT_EQ(arena.allocate(32, 8), afterCheckpoint);
+}
+
+TEST(FixedArena, ScopedCheckpoint)
+{
+    CountingResource upstream;
+    FixedArena<1024> arena(&upstream);
+    std::pmr::vector<int> outer({1, 2, 3}, &arena);
+    const size_t used = arena.used();
+    {
+        const auto scope = arena.scopedCheckpoint();
+        std::pmr::vector<int> inner(100, 0, &arena);
+        std::pmr::vector<int> large(1000, 0, &arena);
+        ASSERT_GT(arena.used(), used);
+        ASSERT_EQ(upstream.outstanding, 1);
+    }
+    ASSERT_EQ(arena.used(), used);
+    ASSERT_EQ(upstream.outstanding, 0);
+    ASSERT_EQ(outer, (std::pmr::vector<int>{1, 2, 3}));
+}
+
+TEST(FixedArena, HugeAllocationThrows)
+{
+    FixedArena<256> arena(std::pmr::new_delete_resource());
+    (void)arena.allocate(16, 8);
+    ASSERT_THROW((void)arena.allocate(std::numeric_limits<size_t>::max() - 64, 8), std::bad_alloc);
+    ASSERT_EQ(arena.used(), 16);
+    ASSERT_EQ(arena.remaining(), 240);
+    ASSERT_EQ(arena.upstreamAllocations(), 0);
+}
+
+TEST(FixedArenaDeathTest, HugeAllocationWithoutUpstream)
+{
+    FixedArena<256> arena;
+    (void)arena.allocate(16, 8);
+    ASSERT_DEATH((void)arena.allocate(std::numeric_limits<size_t>::max() - 64, 8), "");
+    ASSERT_EQ(arena.used(), 16);
+}
+
+TEST(FixedArenaDeathTest, ExhaustedWithoutUpstream)
+{
+    FixedArena<64> arena;
+    (void)arena.allocate(64, 1);
+    ASSERT_DEATH((void)arena.allocate(1, 1), "");
+}
+
+}  // namespace zbo::test
@@ -0,0 +1,428 @@
+// MIT License
+//
+// Copyright (c) 2020 Lenzebo
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include "contracts.h"
+
+#include <array>
+#include <charconv>
+#include <compare>
+#include <concepts>
+#include <cstdint>
+#include <limits>
+#include <ostream>
+#include <system_error>
+#include <type_traits>
+
+namespace zbo {
+
+namespace detail {
+/// integer type that can hold the product of two integers of the given size
+template <size_t size>
+struct WiderInt;
+template <>
+struct WiderInt<1>
+{
+    using Type = int16_t;
+};
+template <>
+struct WiderInt<2>
+{
+    using Type = int32_t;
+};
+template <>
+struct WiderInt<4>
+{
+    using Type = int64_t;
+};
+template <>
+struct WiderInt<8>
+{
+    __extension__ typedef __int128 Type;  // NOLINT(modernize-use-using)
+};
+
+constexpr bool isPowerOfTen(int64_t value)
+{
+    while (value > 1 && value % 10 == 0)
+    {
+        value /= 10;
+    }
+    return value == 1;
+}
+
+constexpr size_t numDecimals(int64_t scale)
+{
+    size_t decimals = 0;
+    for (; scale > 1; scale /= 10)
+    {
+        ++decimals;
+    }
+    return decimals;
+}
+
+/// divides and rounds half away from zero
+template <typename Wide>
+constexpr Wide roundedDivide(Wide numerator, Wide denominator)
+{
+    const Wide quotient = numerator / denominator;
+    const Wide remainder = numerator % denominator;
+    const Wide absRemainder = remainder < 0 ? -remainder : remainder;
+    const Wide absDenominator = denominator < 0 ? -denominator : denominator;
+    if (absRemainder >= absDenominator - absRemainder)
+    {
+        return quotient + (((numerator < 0) != (denominator < 0)) ? -1 : 1);
+    }
+    return quotient;
+}
+}  // namespace detail
+
+/// Overflow policy: overflowing operations are a contract violation (std::terminate)
+struct CheckedOverflow
+{
+    template <typename Int>
+    [[nodiscard]] static constexpr Int add(Int lhs, Int rhs)
+    {
+        Int result{};
+        ZBO_PRECONDITION(!__builtin_add_overflow(lhs, rhs, &result))
+        return result;
+    }
+    template <typename Int>
+    [[nodiscard]] static constexpr Int subtract(Int lhs, Int rhs)
+    {
+        Int result{};
+        ZBO_PRECONDITION(!__builtin_sub_overflow(lhs, rhs, &result))
+        return result;
+    }
+    template <typename Int, typename Wide>
+    [[nodiscard]] static constexpr Int narrow(Wide value)
+    {
+        ZBO_PRECONDITION(value >= std::numeric_limits<Int>::min() && value <= std::numeric_limits<Int>::max())
+        return static_cast<Int>(value);
+    }
+};
+
+/// Overflow policy: overflowing operations clamp to the smallest/largest representable value
+struct SaturatingOverflow
+{
+    template <typename Int>
+    [[nodiscard]] static constexpr Int add(Int lhs, Int rhs)
+    {
+        Int result{};
+        if (__builtin_add_overflow(lhs, rhs, &result))
+        {
+            return rhs > 0 ? std::numeric_limits<Int>::max() : std::numeric_limits<Int>::min();
+        }
+        return result;
+    }
+    template <typename Int>
+    [[nodiscard]] static constexpr Int subtract(Int lhs, Int rhs)
+    {
+        Int result{};
+        if (__builtin_sub_overflow(lhs, rhs, &result))
+        {
+            return rhs < 0 ? std::numeric_limits<Int>::max() : std::numeric_limits<Int>::min();
+        }
+        return result;
+    }
+    template <typename Int, typename Wide>
+    [[nodiscard]] static constexpr Int narrow(Wide value)
+    {
+        if (value > std::numeric_limits<Int>::max()) return std::numeric_limits<Int>::max();
+        if (value < std::numeric_limits<Int>::min()) return std::numeric_limits<Int>::min();
+        return static_cast<Int>(value);
+    }
+};
+
+/// Overflow policy: no checks, overflowing operations wrap around
+struct WrappingOverflow
+{
+    template <typename Int>
+    [[nodiscard]] static constexpr Int add(Int lhs, Int rhs)
+    {
+        Int result{};
+        __builtin_add_overflow(lhs, rhs, &result);
+        return result;
+    }
+    template <typename Int>
+    [[nodiscard]] static constexpr Int subtract(Int lhs, Int rhs)
+    {
+        Int result{};
+        __builtin_sub_overflow(lhs, rhs, &result);
+        return result;
+    }
+    template <typename Int, typename Wide>
+    [[nodiscard]] static constexpr Int narrow(Wide value)
+    {
+        return static_cast<Int>(value);
+    }
+};
+
+/**
+ * @brief A decimal fixed point number that stores value * Scale as integer. All operations are exact or rounded
+ *        half away from zero, so results are bit-reproducible and do not use any floating point instructions.
+ *
+ * It is meant to be used as underlying type of a NamedType together with the Addition, Subtraction, Multiplication,
+ * Division and Comparable behaviors:
+ *
+ *  using Decimal = FixedPoint<int64_t, 10'000>;  // 4 decimal places
+ *  struct Price : public NamedType<Decimal, Price>, Arithmetic<Price>, Comparable<Price>
+ *  {
+ *      using NamedType::NamedType;
+ *  };
+ *  constexpr Price TICK{std::in_place, 0.0025};  // converted at compile time
+ *  Price total = TICK * 3 + Price{Decimal(10)};
+ *
+ * Multiplication and division by another FixedPoint compute in a wider integer type and round the result.
+ *
+ * @tparam Int signed integer type to store the scaled value in
+ * @tparam Scale power of ten, the number of representable values between two integers
+ * @tparam OverflowPolicy CheckedOverflow (default), SaturatingOverflow or WrappingOverflow
+ */
+template <typename Int, int64_t Scale, typename OverflowPolicy = CheckedOverflow>
+class FixedPoint
+{
+    static_assert(std::is_signed_v<Int> && std::is_integral_v<Int>, "Int needs to be a signed integer type");
+    static_assert(Scale > 0 && detail::isPowerOfTen(Scale), "Scale needs to be a power of ten");
+    static_assert(Scale <= std::numeric_limits<Int>::max(), "Scale needs to be representable in Int");
+
+    using Wide = typename detail::WiderInt<sizeof(Int)>::Type;
+
+  public:
+    using RawType = Int;
+    static constexpr Int SCALE = static_cast<Int>(Scale);
+    static constexpr size_t DECIMALS = detail::numDecimals(Scale);
+
+    constexpr FixedPoint() = default;
+
+    /// converts an integer value, e.g. FixedPoint(5) == 5.0
+    template <std::integral I>
+    constexpr explicit FixedPoint(I value) : raw_(OverflowPolicy::template narrow<Int>(Wide(value) * SCALE))
+    {
+    }
+
+    /// converts a floating point value rounding to the nearest representable value. Use for literals (constexpr)
+    template <std::floating_point F>
+    constexpr explicit FixedPoint(F value) : raw_(fromFloating(value))
+    {
+    }
+
+    /// creates a FixedPoint from its scaled integer representation, i.e. the result has the value raw / Scale
+    [[nodiscard]] static constexpr FixedPoint fromRaw(Int raw) noexcept
+    {
+        FixedPoint result;
+        result.raw_ = raw;
+        return result;
+    }
+
+    [[nodiscard]] constexpr Int raw() const noexcept { return raw_; }
+
+    /// the conversion to double is only meant for display or interfacing with floating point code
+    [[nodiscard]] constexpr double toDouble() const noexcept
+    {
+        return static_cast<double>(raw_) / static_cast<double>(SCALE);
+    }
+
+    constexpr FixedPoint& operator+=(const FixedPoint& rhs)
+    {
+        raw_ = OverflowPolicy::add(raw_, rhs.raw_);
+        return *this;
+    }
+    constexpr FixedPoint& operator-=(const FixedPoint& rhs)
+    {
+        raw_ = OverflowPolicy::subtract(raw_, rhs.raw_);
+        return *this;
+    }
+    constexpr FixedPoint& operator*=(const FixedPoint& rhs)
+    {
+        raw_ = OverflowPolicy::template narrow<Int>(detail::roundedDivide(Wide(raw_) * Wide(rhs.raw_), Wide(SCALE)));
+        return *this;
+    }
+    template <std::integral I>
+    constexpr FixedPoint& operator*=(I rhs)
+    {
+        raw_ = OverflowPolicy::template narrow<Int>(Wide(raw_) * Wide(rhs));
+        return *this;
+    }
+    constexpr FixedPoint& operator/=(const FixedPoint& rhs)
+    {
+        ZBO_PRECONDITION(rhs.raw_ != 0)
+        raw_ = OverflowPolicy::template narrow<Int>(detail::roundedDivide(Wide(raw_) * Wide(SCALE), Wide(rhs.raw_)));
+        return *this;
+    }
+    template <std::integral I>
+    constexpr FixedPoint& operator/=(I rhs)
+    {
+        ZBO_PRECONDITION(rhs != 0)
+        raw_ = OverflowPolicy::template narrow<Int>(detail::roundedDivide(Wide(raw_), Wide(rhs)));
+        return *this;
+    }
+
+    [[nodiscard]] friend constexpr FixedPoint operator+(FixedPoint lhs, const FixedPoint& rhs) { return lhs += rhs; }
+    [[nodiscard]] friend constexpr FixedPoint operator-(FixedPoint lhs, const FixedPoint& rhs) { return lhs -= rhs; }
+    [[nodiscard]] friend constexpr FixedPoint operator*(FixedPoint lhs, const FixedPoint& rhs) { return lhs *= rhs; }
+    [[nodiscard]] friend constexpr FixedPoint operator/(FixedPoint lhs, const FixedPoint& rhs) { return lhs /= rhs; }
+    template <std::integral I>
+    [[nodiscard]] friend constexpr FixedPoint operator*(FixedPoint lhs, I rhs)
+    {
+        return lhs *= rhs;
+    }
+    template <std::integral I>
+    [[nodiscard]] friend constexpr FixedPoint operator*(I lhs, FixedPoint rhs)
+    {
+        return rhs *= lhs;
+    }
+    template <std::integral I>
+    [[nodiscard]] friend constexpr FixedPoint operator/(FixedPoint lhs, I rhs)
+    {
+        return lhs /= rhs;
+    }
+    [[nodiscard]] constexpr FixedPoint operator-() const { return FixedPoint() - *this; }
+
+    [[nodiscard]] friend constexpr auto operator<=>(const FixedPoint& lhs, const FixedPoint& rhs) = default;
+    [[nodiscard]] friend constexpr bool operator==(const FixedPoint& lhs, const FixedPoint& rhs) = default;
+
+    /**
+     * @brief Writes the value with all DECIMALS decimal places into [first, last) without allocating
+     * @return same semantics as std::to_chars
+     */
+    std::to_chars_result toChars(char* first, char* last) const noexcept
+    {
+        using Unsigned = std::make_unsigned_t<Int>;
+        const Unsigned magnitude = raw_ < 0 ? Unsigned(0) - Unsigned(raw_) : Unsigned(raw_);
+        const Unsigned integerPart = magnitude / Unsigned(SCALE);
+        Unsigned fractionalPart = magnitude % Unsigned(SCALE);
+
+        if (raw_ < 0)
+        {
+            if (first == last) return {last, std::errc::value_too_large};
+            *first++ = '-';
+        }
+        auto result = std::to_chars(first, last, integerPart);
+        if (result.ec != std::errc{} || DECIMALS == 0)
+        {
+            return result;
+        }
+        if (last - result.ptr < static_cast<std::ptrdiff_t>(DECIMALS + 1))
+        {
+            return {last, std::errc::value_too_large};
+        }
+        *result.ptr = '.';
+        char* const fractionEnd = result.ptr + 1 + DECIMALS;
+        for (char* digit = fractionEnd - 1; digit > result.ptr; --digit)
+        {
+            *digit = static_cast<char>('0' + fractionalPart % 10);
+            fractionalPart /= 10;
+        }
+        return {fractionEnd, std::errc{}};
+    }
+
+    /**
+     * @brief Parses a decimal number ("-12.345") from [first, last) without using floating point.
+     *        More decimal places than DECIMALS are rounded half away from zero
+     * @return same semantics as std::from_chars
+     */
+    static constexpr std::from_chars_result fromChars(const char* first, const char* last, FixedPoint& value)
+    {
+        const char* current = first;
+        const bool negative = current != last && *current == '-';
+        if (negative) ++current;
+
+        Wide raw = 0;
+        constexpr Wide LIMIT = Wide(std::numeric_limits<Int>::max()) + 1;
+        bool anyDigit = false;
+        auto isDigit = [](char c) { return c >= '0' && c <= '9'; };
+
+        for (; current != last && isDigit(*current); ++current)
+        {
+            raw = raw * 10 + (*current - '0');
+            anyDigit = true;
+            if (raw * SCALE > LIMIT) return {current, std::errc::result_out_of_range};
+        }
+        raw *= SCALE;
+
+        if (current != last && *current == '.')
+        {
+            ++current;
+            Wide digitValue = SCALE;
+            for (size_t decimals = 0; current != last && isDigit(*current); ++current, ++decimals)
+            {
+                anyDigit = true;
+                const int digit = *current - '0';
+                if (decimals < DECIMALS)
+                {
+                    digitValue /= 10;
+                    raw += digitValue * digit;
+                }
+                else if (decimals == DECIMALS && digit >= 5)
+                {
+                    // the first dropped digit decides about rounding, all following are ignored
+                    raw += 1;
+                }
+            }
+        }
+        if (!anyDigit) return {first, std::errc::invalid_argument};
+
+        raw = negative ? -raw : raw;
+        if (raw > std::numeric_limits<Int>::max() || raw < std::numeric_limits<Int>::min())
+        {
+            return {current, std::errc::result_out_of_range};
+        }
+        value.raw_ = static_cast<Int>(raw);
+        return {current, std::errc{}};
+    }
+
+    // NOLINTNEXTLINE(readability-identifier-naming)
+    friend std::to_chars_result to_chars(char* first, char* last, const FixedPoint& value) noexcept
+    {
+        return value.toChars(first, last);
+    }
+
+    // NOLINTNEXTLINE(readability-identifier-naming)
+    friend constexpr std::from_chars_result from_chars(const char* first, const char* last, FixedPoint& value)
+    {
+        return fromChars(first, last, value);
+    }
+
+    friend std::ostream& operator<<(std::ostream& stream, const FixedPoint& value)
+    {
+        constexpr size_t BUFFER_SIZE = std::numeric_limits<Int>::digits10 + 4;
+        std::array<char, BUFFER_SIZE> buffer{};
+        const auto result = value.toChars(buffer.data(), buffer.data() + buffer.size());
+        return stream.write(buffer.data(), result.ptr - buffer.data());
+    }
+
+  private:
+    template <typename F>
+    [[nodiscard]] static constexpr Int fromFloating(F value)
+    {
+        const F scaled = value * static_cast<F>(SCALE);
+        const F rounded = scaled < 0 ? scaled - F(0.5) : scaled + F(0.5);
+        ZBO_PRECONDITION(rounded > static_cast<F>(std::numeric_limits<Int>::min()) - F(1) &&
+                         rounded < static_cast<F>(std::numeric_limits<Int>::max()) + F(1))
+        return static_cast<Int>(rounded);
+    }
+
+    Int raw_{};
+};
+
+}  // namespace zbo
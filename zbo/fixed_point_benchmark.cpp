@@ -0,0 +1,137 @@
+#include "fixed_point.h"
+#include "named_type.h"
+
+#include <benchmark/benchmark.h>
+
+#include <random>
+#include <vector>
+
+namespace zbo::bench {
+
+using Decimal = FixedPoint<int64_t, 10'000>;
+
+template <typename T>
+struct Price : public NamedType<T, Price<T>>, Arithmetic<Price<T>>, Comparable<Price<T>>
+{
+    using NamedType<T, Price<T>>::NamedType;
+};
+
+using DoublePrice = Price<double>;
+using FixedPrice = Price<Decimal>;
+
+constexpr int64_t SIZE = 1 << 14;
+
+template <typename PriceT>
+std::vector<PriceT> randomPrices()
+{
+    std::mt19937 gen{42};
+    std::uniform_int_distribution<int64_t> ticks{1, 1'000'000};
+    std::vector<PriceT> prices;
+    for (int64_t i = 0; i < SIZE; ++i)
+    {
+        // prices on a 0.0025 tick grid as they come from the exchange
+        prices.emplace_back(std::in_place, static_cast<double>(ticks(gen)) * 0.0025);
+    }
+    return prices;
+}
+
+template <typename PriceT>
+void accumulate(benchmark::State& state)
+{
+    const auto prices = randomPrices<PriceT>();
+    for (auto _ : state)
+    {
+        PriceT total{};
+        for (const auto& price : prices)
+        {
+            total += price;
+        }
+        benchmark::DoNotOptimize(total);
+    }
+    state.SetItemsProcessed(state.iterations() * SIZE);
+}
+
+template <typename PriceT>
+void multiplyByQuantity(benchmark::State& state)
+{
+    const auto prices = randomPrices<PriceT>();
+    std::vector<PriceT> notional(prices.size());
+    for (auto _ : state)
+    {
+        for (size_t i = 0; i < prices.size(); ++i)
+        {
+            notional[i] = prices[i] * static_cast<int>(i % 100 + 1);
+        }
+        benchmark::DoNotOptimize(notional.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * SIZE);
+}
+
+template <typename PriceT>
+void multiplyByFactor(benchmark::State& state)
+{
+    using T = UnderlyingType<PriceT>;
+    const auto prices = randomPrices<PriceT>();
+    std::vector<PriceT> scaled(prices.size());
+    const T factor{1.0025};
+    for (auto _ : state)
+    {
+        for (size_t i = 0; i < prices.size(); ++i)
+        {
+            scaled[i] = prices[i] * factor;
+        }
+        benchmark::DoNotOptimize(scaled.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * SIZE);
+}
+
+template <typename PriceT>
+void divide(benchmark::State& state)
+{
+    const auto prices = randomPrices<PriceT>();
+    const PriceT tick{std::in_place, 0.0025};
+    for (auto _ : state)
+    {
+        UnderlyingType<PriceT> ticks{};
+        for (const auto& price : prices)
+        {
+            ticks += price / tick;
+        }
+        benchmark::DoNotOptimize(ticks);
+    }
+    state.SetItemsProcessed(state.iterations() * SIZE);
+}
+
+template <typename PriceT>
+void compare(benchmark::State& state)
+{
+    const auto prices = randomPrices<PriceT>();
+    const PriceT limit{std::in_place, 1250.0};
+    for (auto _ : state)
+    {
+        size_t below = 0;
+        for (const auto& price : prices)
+        {
+            below += price < limit ? 1 : 0;
+        }
+        benchmark::DoNotOptimize(below);
+    }
+    state.SetItemsProcessed(state.iterations() * SIZE);
+}
+
+BENCHMARK_TEMPLATE(accumulate, DoublePrice);
+BENCHMARK_TEMPLATE(accumulate, FixedPrice);
+BENCHMARK_TEMPLATE(multiplyByQuantity, DoublePrice);
+BENCHMARK_TEMPLATE(multiplyByQuantity, FixedPrice);
+BENCHMARK_TEMPLATE(multiplyByFactor, DoublePrice);
+BENCHMARK_TEMPLATE(multiplyByFactor, FixedPrice);
+BENCHMARK_TEMPLATE(divide, DoublePrice);
+BENCHMARK_TEMPLATE(divide, FixedPrice);
+BENCHMARK_TEMPLATE(compare, DoublePrice);
+BENCHMARK_TEMPLATE(compare, FixedPrice);
+
+}  // namespace zbo::bench
+
+BENCHMARK_MAIN();
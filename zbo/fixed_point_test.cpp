@@ -0,0 +1,138 @@
+#include "fixed_point.h"
+#include "named_type.h"
+
+#include <gtest/gtest.h>
+
+#include <sstream>
+#include <string_view>
+
+namespace zbo::test {
+
+using Decimal = FixedPoint<int64_t, 10'000>;
+
+struct Price : public NamedType<Decimal, Price>, Arithmetic<Price>, Comparable<Price>, Streamable<Price>
+{
+    using NamedType::NamedType;
+};
+
+constexpr Price TICK{std::in_place, 0.0025};
+static_assert(TICK.get().raw() == 25, "Literals are converted at compile time");
+static_assert(Decimal(1.23456) == Decimal::fromRaw(12346), "Conversion rounds to the nearest value");
+static_assert(Decimal(-1.23456) == Decimal::fromRaw(-12346), "Conversion rounds half away from zero");
+static_assert(Decimal(3) == Decimal(3.0));
+static_assert(TICK * 4 == Price{Decimal(0.01)});
+static_assert(std::is_trivially_copyable_v<Price>);
+
+template <typename FixedPointT>
+std::string toString(const FixedPointT& value)
+{
+    std::array<char, 32> buffer{};
+    const auto result = to_chars(buffer.data(), buffer.data() + buffer.size(), value);
+    EXPECT_EQ(result.ec, std::errc{});
+    return std::string(buffer.data(), result.ptr);
+}
+
+Decimal fromString(std::string_view string)
+{
+    Decimal value;
+    const auto result = from_chars(string.data(), string.data() + string.size(), value);
+    EXPECT_EQ(result.ec, std::errc{});
+    EXPECT_EQ(result.ptr, string.data() + string.size());
+    return value;
+}
+
+TEST(FixedPoint, NamedTypeArithmetic)
+{
+    const Price price{std::in_place, 10.5};
+    auto total = price * 3 + TICK - Price{std::in_place, 0.5};
+    ASSERT_EQ(total, Price{Decimal(31.0025)});
+    total /= 2;
+    ASSERT_EQ(total, Price{Decimal(15.50125)});  // rounded from 15.500125
+    ASSERT_EQ(total.get().raw(), 155013);
+
+    const Decimal ratio = price / TICK;
+    ASSERT_EQ(ratio, Decimal(4200));
+    ASSERT_TRUE(TICK < price);
+    ASSERT_TRUE(price >= price);
+}
+
+TEST(FixedPoint, MultiplicationAndDivisionRound)
+{
+    ASSERT_EQ(Decimal(1.5) * Decimal(1.5), Decimal(2.25));
+    ASSERT_EQ(Decimal(0.0001) * Decimal(0.5), Decimal(0.0001));    // 0.00005 rounds away from zero
+    ASSERT_EQ(Decimal(-0.0001) * Decimal(0.5), Decimal(-0.0001));  // -0.00005 rounds away from zero
+    ASSERT_EQ(Decimal(0.0001) * Decimal(0.4), Decimal(0.0));
+    ASSERT_EQ(Decimal(1) / Decimal(3), Decimal(0.3333));
+    ASSERT_EQ(Decimal(2) / Decimal(3), Decimal(0.6667));
+    ASSERT_EQ(-Decimal(2) / 3, Decimal(-0.6667));
+}
+
+TEST(FixedPoint, Saturation)
+{
+    using Saturating = FixedPoint<int32_t, 100, SaturatingOverflow>;
+    constexpr auto MAX = Saturating::fromRaw(std::numeric_limits<int32_t>::max());
+    constexpr auto MIN = Saturating::fromRaw(std::numeric_limits<int32_t>::min());
+    ASSERT_EQ(MAX + Saturating(1), MAX);
+    ASSERT_EQ(MIN - Saturating(1), MIN);
+    ASSERT_EQ(MAX * 2, MAX);
+    ASSERT_EQ(MIN * Saturating(2), MIN);
+    ASSERT_EQ(Saturating(1'000'000) * Saturating(-1'000'000), MIN);
+}
+
+TEST(FixedPoint, Wrapping)
+{
+    using Wrapping = FixedPoint<int32_t, 1, WrappingOverflow>;
+    constexpr auto MAX = Wrapping::fromRaw(std::numeric_limits<int32_t>::max());
+    ASSERT_EQ((MAX + Wrapping(1)).raw(), std::numeric_limits<int32_t>::min());
+}
+
+TEST(FixedPointDeathTest, CheckedOverflowTerminates)
+{
+    using Checked = FixedPoint<int32_t, 100>;
+    const auto max = Checked::fromRaw(std::numeric_limits<int32_t>::max());
+    ASSERT_DEATH((void)(max + Checked(1)), "");
+    ASSERT_DEATH((void)(max * 2), "");
+    ASSERT_DEATH((void)(Checked(1) / Checked(0)), "");
+}
+
+TEST(FixedPoint, ToChars)
+{
+    ASSERT_EQ(toString(Decimal(0)), "0.0000");
+    ASSERT_EQ(toString(Decimal(12.5)), "12.5000");
+    ASSERT_EQ(toString(Decimal(-0.0025)), "-0.0025");
+    ASSERT_EQ(toString(Decimal::fromRaw(std::numeric_limits<int64_t>::min())), "-922337203685477.5808");
+    ASSERT_EQ(toString(FixedPoint<int32_t, 1>(42)), "42");
+
+    std::array<char, 4> small{};
+    ASSERT_EQ(Decimal(12.5).toChars(small.data(), small.data() + small.size()).ec, std::errc::value_too_large);
+
+    std::stringstream stream;
+    stream << Price{Decimal(1.25)};
+    ASSERT_EQ(stream.str(), "1.2500");
+}
+
+TEST(FixedPoint, FromChars)
+{
+    ASSERT_EQ(fromString("12"), Decimal(12));
+    ASSERT_EQ(fromString("12.5"), Decimal(12.5));
+    ASSERT_EQ(fromString("-0.0025"), Decimal(-0.0025));
+    ASSERT_EQ(fromString(".5"), Decimal(0.5));
+    ASSERT_EQ(fromString("1.00005"), Decimal(1.0001));
+    ASSERT_EQ(fromString("1.000049999"), Decimal(1.0));
+    ASSERT_EQ(fromString("-922337203685477.5808"), Decimal::fromRaw(std::numeric_limits<int64_t>::min()));
+
+    Decimal value;
+    const std::string_view invalid = "-x";
+    ASSERT_EQ(from_chars(invalid.data(), invalid.data() + invalid.size(), value).ec, std::errc::invalid_argument);
+    const std::string_view tooLarge = "922337203685478";
+    ASSERT_EQ(from_chars(tooLarge.data(), tooLarge.data() + tooLarge.size(), value).ec,
+              std::errc::result_out_of_range);
+
+    const std::string_view trailing = "1.5 EUR";
+    const auto result = from_chars(trailing.data(), trailing.data() + trailing.size(), value);
+    ASSERT_EQ(result.ec, std::errc{});
+    ASSERT_EQ(*result.ptr, ' ');
+    ASSERT_EQ(value, Decimal(1.5));
+}
+
+}  // namespace zbo::test
@@ -0,0 +1,441 @@
+// MIT License
+//
+// Copyright (c) 2020 Lenzebo
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#pragma once
+
+#include "cache_line.h"
+#include "contracts.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <csignal>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <istream>
+#include <memory>
+#include <ostream>
+#include <vector>
+
+#include <fcntl.h>
+#include <unistd.h>
+#ifdef __linux__
+#include <sys/syscall.h>
+#endif
+
+namespace zbo {
+
+/// one event in the flight recorder, written as is into the dump
+struct FlightEvent
+{
+    static constexpr size_t NUM_ARGS = 4;
+
+    /// nanoseconds since the epoch of the clock of the recorder
+    int64_t time = 0;
+    uint32_t id = 0;
+    uint32_t reserved = 0;
+    std::array<int64_t, NUM_ARGS> args{};
+};
+
+/// layout of a dump: a FileHeader, followed by a RingHeader and its events for every ring
+namespace flight_dump {
+
+constexpr std::array<char, 8> MAGIC{'Z', 'B', 'O', 'F', 'L', 'I', 'G', 'H'};
+constexpr uint32_t VERSION = 1;
+constexpr size_t REASON_SIZE = 256;
+/// limits of the format, so that decoding a corrupt dump does not allocate unbounded memory
+constexpr uint32_t MAX_RINGS = 1U << 16U;
+constexpr uint32_t MAX_EVENTS_PER_RING = 1U << 20U;
+
+struct FileHeader
+{
+    std::array<char, 8> magic = MAGIC;
+    uint32_t version = VERSION;
+    uint32_t eventSize = sizeof(FlightEvent);
+    uint32_t numRings = 0;
+    uint32_t eventsPerRing = 0;
+    std::array<char, REASON_SIZE> reason{};
+};
+
+struct RingHeader
+{
+    uint64_t threadId = 0;
+    /// number of events ever written into the ring, the last eventsPerRing of them are in the dump
+    uint64_t head = 0;
+};
+
+}  // namespace flight_dump
+
+namespace detail {
+
+/// appends text to buffer without allocating, so it can be used in signal handlers
+template <size_t size>
+void appendSignalSafe(std::array<char, size>& buffer, size_t& length, const char* text) noexcept
+{
+    for (; text != nullptr && *text != '\0' && length + 1 < size; ++text)
+    {
+        buffer[length++] = *text;
+    }
+    buffer[length] = '\0';
+}
+
+template <size_t size>
+void appendSignalSafe(std::array<char, size>& buffer, size_t& length, int64_t number) noexcept
+{
+    std::array<char, 24> digits{};
+    size_t numDigits = 0;
+    uint64_t magnitude = number < 0 ? 0 - static_cast<uint64_t>(number) : static_cast<uint64_t>(number);
+    do
+    {
+        digits[numDigits++] = static_cast<char>('0' + magnitude % 10);
+        magnitude /= 10;
+    } while (magnitude > 0);
+    if (number < 0)
+    {
+        digits[numDigits++] = '-';
+    }
+    std::array<char, 25> text{};
+    std::reverse_copy(digits.begin(), digits.begin() + numDigits, text.begin());
+    appendSignalSafe(buffer, length, text.data());
+}
+
+inline bool writeAll(int file, const void* data, size_t size) noexcept
+{
+    const auto* bytes = static_cast<const char*>(data);
+    while (size > 0)
+    {
+        const ssize_t written = ::write(file, bytes, size);
+        if (written <= 0)
+        {
+            return false;
+        }
+        bytes += written;
+        size -= static_cast<size_t>(written);
+    }
+    return true;
+}
+
+inline uint64_t currentThreadId() noexcept
+{
+#ifdef __linux__
+    return static_cast<uint64_t>(::syscall(SYS_gettid));
+#else
+    return 0;
+#endif
+}
+
+}  // namespace detail
+
+/**
+ * @brief Records recent events of every thread in memory and writes them to a file when the process dies, to see what
+ *        led up to a contract violation or a crash.
+ *
+ * Every thread writes fixed size FlightEvents into a ring of its own, which only costs a timestamp and a couple of
+ * stores. After install(), a contract violation or a fatal signal (SIGSEGV, SIGBUS, SIGFPE, SIGILL, SIGABRT) dumps the
+ * rings of all threads to a file using only async-signal-safe calls, before the process dies as it would have without
+ * the recorder. decodeFlightDump() or the flight_recorder_decoder tool turn the dump into text.
+ *
+ * A thread claims a ring with its first event and gives it back when it exits. Unused rings are claimed first, so
+ * the history of exited threads is kept as long as possible. Threads that do not get a ring, as all are in use,
+ * record nothing. Events that are written while dumping may be torn.
+ *
+ * Usage:
+ *   FlightRecorder::install("/var/log/app/flight.bin");
+ *   ...
+ *   FlightRecorder::record(ORDER_RECEIVED, order.id, order.quantity);
+ *
+ *   $ flight_recorder_decoder /var/log/app/flight.bin
+ *
+ * @tparam Clock the clock for the timestamps, like for StopWatchT
+ */
+template <typename Clock>
+class FlightRecorderT
+{
+  public:
+    /**
+     * @brief allocates the rings and installs the contract violation and signal handlers
+     *
+     * Needs to be called once, before the first event is recorded. Replaces previously installed signal handlers and
+     * contract violation handler.
+     *
+     * @param dumpPath file that is written on a contract violation or fatal signal
+     * @param maxThreads number of rings, i.e. threads that record at the same time
+     * @param eventsPerThread size of each ring, rounded up to a power of two
+     */
+    static void install(const char* dumpPath, size_t maxThreads = 64, size_t eventsPerThread = 4096)
+    {
+        ZBO_PRECONDITION(state_.load() == nullptr)
+        ZBO_PRECONDITION(std::strlen(dumpPath) < PATH_SIZE)
+        ZBO_PRECONDITION(maxThreads <= flight_dump::MAX_RINGS)
+        ZBO_PRECONDITION(eventsPerThread <= flight_dump::MAX_EVENTS_PER_RING)
+        auto state = std::make_unique<State>();
+        std::strcpy(state->path.data(), dumpPath);  // NOLINT (clang-analyzer-security.insecureAPI.strcpy) size checked
+        state->eventsPerRing = std::bit_ceil(eventsPerThread);
+        state->rings = std::make_unique<Ring[]>(maxThreads);
+        state->numRings = maxThreads;
+        for (size_t idx = 0; idx < maxThreads; ++idx)
+        {
+            state->rings[idx].events = std::make_unique<FlightEvent[]>(state->eventsPerRing);
+        }
+        // never freed, as threads and signal handlers may access it until the process ends
+        state_.store(state.release(), std::memory_order_release);
+
+        setContractViolationHandler(&onContractViolation);
+        struct sigaction action = {};
+        action.sa_handler = &onSignal;
+        sigemptyset(&action.sa_mask);
+        action.sa_flags = SA_RESETHAND;
+        for (int signal : FATAL_SIGNALS)
+        {
+            sigaction(signal, &action, nullptr);
+        }
+    }
+
+    [[nodiscard]] static bool isInstalled() noexcept { return state_.load(std::memory_order_acquire) != nullptr; }
+
+    /// records an event in the ring of the calling thread, does nothing before install()
+    static void record(uint32_t id, int64_t arg0 = 0, int64_t arg1 = 0, int64_t arg2 = 0, int64_t arg3 = 0) noexcept
+    {
+        Ring* ring = lease_.ring;
+        if (ring == nullptr) ZBO_UNLIKELY
+            {
+                ring = lease_.claim();
+                if (ring == nullptr)
+                {
+                    return;
+                }
+            }
+        const uint64_t head = ring->head.load(std::memory_order_relaxed);
+        FlightEvent& event = ring->events[head & ring->mask];
+        event.time = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now().time_since_epoch()).count();
+        event.id = id;
+        event.args = {arg0, arg1, arg2, arg3};
+        ring->head.store(head + 1, std::memory_order_release);
+    }
+
+    /// writes the rings of all threads to the dump file, async-signal-safe
+    static bool dump(const char* reason) noexcept
+    {
+        const State* state = state_.load(std::memory_order_acquire);
+        if (state == nullptr)
+        {
+            return false;
+        }
+        // NOLINTNEXTLINE (hicpp-signed-bitwise)
+        const int file = ::open(state->path.data(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        if (file < 0)
+        {
+            return false;
+        }
+        flight_dump::FileHeader header;
+        header.numRings = static_cast<uint32_t>(state->numRings);
+        header.eventsPerRing = static_cast<uint32_t>(state->eventsPerRing);
+        size_t length = 0;
+        detail::appendSignalSafe(header.reason, length, reason);
+        bool ok = detail::writeAll(file, &header, sizeof(header));
+        for (size_t idx = 0; ok && idx < state->numRings; ++idx)
+        {
+            const Ring& ring = state->rings[idx];
+            const flight_dump::RingHeader ringHeader{ring.threadId.load(std::memory_order_relaxed),
+                                                     ring.head.load(std::memory_order_acquire)};
+            ok = detail::writeAll(file, &ringHeader, sizeof(ringHeader)) &&
+                 detail::writeAll(file, ring.events.get(), state->eventsPerRing * sizeof(FlightEvent));
+        }
+        ::close(file);
+        return ok;
+    }
+
+  private:
+    static constexpr size_t PATH_SIZE = 4096;
+    static constexpr std::array<int, 5> FATAL_SIGNALS{SIGSEGV, SIGBUS, SIGFPE, SIGILL, SIGABRT};
+
+    struct alignas(CACHE_LINE_SIZE) Ring
+    {
+        std::atomic<uint64_t> head{0};
+        uint64_t mask = 0;
+        std::unique_ptr<FlightEvent[]> events;
+        std::atomic<bool> taken{false};
+        std::atomic<uint64_t> threadId{0};
+    };
+
+    struct State
+    {
+        std::array<char, PATH_SIZE> path{};
+        size_t eventsPerRing = 0;
+        size_t numRings = 0;
+        std::unique_ptr<Ring[]> rings;
+    };
+
+    /// the ring of a thread, which is given back when the thread exits
+    struct Lease
+    {
+        Lease() = default;
+        Lease(const Lease&) = delete;
+        Lease& operator=(const Lease&) = delete;
+        ~Lease()
+        {
+            if (ring != nullptr)
+            {
+                ring->taken.store(false, std::memory_order_release);
+            }
+        }
+
+        Ring* claim() noexcept
+        {
+            State* state = state_.load(std::memory_order_acquire);
+            if (state == nullptr || exhausted)
+            {
+                return nullptr;
+            }
+            // prefers rings that have not been used yet, to keep the history of exited threads as long as possible
+            for (size_t idx = 0; idx < 2 * state->numRings; ++idx)
+            {
+                Ring& candidate = state->rings[idx % state->numRings];
+                const bool unused = candidate.head.load(std::memory_order_relaxed) == 0;
+                if ((unused || idx >= state->numRings) && !candidate.taken.exchange(true, std::memory_order_acquire))
+                {
+                    candidate.mask = state->eventsPerRing - 1;
+                    candidate.head.store(0, std::memory_order_relaxed);
+                    candidate.threadId.store(detail::currentThreadId(), std::memory_order_relaxed);
+                    ring = &candidate;
+                    return ring;
+                }
+            }
+            // do not scan all rings again for every event
+            exhausted = true;
+            return nullptr;
+        }
+
+        Ring* ring = nullptr;
+        bool exhausted = false;
+    };
+
+    /// the first fatal event dumps, e.g. a contract violation and the SIGABRT of the following std::terminate()
+    static void dumpOnce(const char* reason) noexcept
+    {
+        if (!dumped_.exchange(true))
+        {
+            dump(reason);
+        }
+    }
+
+    static void onContractViolation(const ContractViolation& violation) noexcept
+    {
+        std::array<char, flight_dump::REASON_SIZE> reason{};
+        size_t length = 0;
+        detail::appendSignalSafe(reason, length, violation.type);
+        detail::appendSignalSafe(reason, length, " condition failed: ");
+        detail::appendSignalSafe(reason, length, violation.condition);
+        detail::appendSignalSafe(reason, length, " at ");
+        detail::appendSignalSafe(reason, length, violation.file);
+        detail::appendSignalSafe(reason, length, ":");
+        detail::appendSignalSafe(reason, length, violation.line);
+        dumpOnce(reason.data());
+    }
+
+    static void onSignal(int signal) noexcept
+    {
+        std::array<char, flight_dump::REASON_SIZE> reason{};
+        size_t length = 0;
+        detail::appendSignalSafe(reason, length, "fatal signal ");
+        detail::appendSignalSafe(reason, length, signal);
+        dumpOnce(reason.data());
+        // the handler has been reset to the default, which ends the process
+        std::raise(signal);
+    }
+
+    static inline std::atomic<State*> state_{nullptr};
+    static inline std::atomic<bool> dumped_{false};
+    static inline thread_local Lease lease_;
+};
+
+/// The default flight recorder using the std::chrono::steady_clock
+using FlightRecorder = FlightRecorderT<std::chrono::steady_clock>;
+
+/**
+ * @brief writes the events of a dump as text to output, ordered by time and one line per event, and returns false if
+ *        input is not a valid dump
+ *
+ * Times are relative to the first event in the dump:
+ *   # Pre condition failed: idx < size() at zbo/max_size_vector.h:108
+ *   +0.000000000 s  thread 4711  event 3  args 42 0 0 0
+ */
+inline bool decodeFlightDump(std::istream& input, std::ostream& output)
+{
+    flight_dump::FileHeader header;
+    if (!input.read(reinterpret_cast<char*>(&header), sizeof(header)) ||  // NOLINT (cppcoreguidelines-pro-type-*)
+        header.magic != flight_dump::MAGIC || header.version != flight_dump::VERSION ||
+        header.eventSize != sizeof(FlightEvent) || header.numRings > flight_dump::MAX_RINGS ||
+        !std::has_single_bit(header.eventsPerRing) || header.eventsPerRing > flight_dump::MAX_EVENTS_PER_RING)
+    {
+        return false;
+    }
+    header.reason.back() = '\0';
+
+    struct Line
+    {
+        uint64_t threadId;
+        FlightEvent event;
+    };
+    std::vector<Line> lines;
+    std::vector<FlightEvent> events(header.eventsPerRing);
+    for (uint32_t ringIdx = 0; ringIdx < header.numRings; ++ringIdx)
+    {
+        flight_dump::RingHeader ring;
+        if (!input.read(reinterpret_cast<char*>(&ring), sizeof(ring)) ||  // NOLINT (cppcoreguidelines-pro-type-*)
+            !input.read(reinterpret_cast<char*>(events.data()),           // NOLINT (cppcoreguidelines-pro-type-*)
+                        static_cast<std::streamsize>(events.size() * sizeof(FlightEvent))))
+        {
+            return false;
+        }
+        const uint64_t first = ring.head > events.size() ? ring.head - events.size() : 0;
+        for (uint64_t idx = first; idx < ring.head; ++idx)
+        {
+            lines.push_back(Line{ring.threadId, events[idx % events.size()]});
+        }
+    }
+    std::stable_sort(lines.begin(), lines.end(),
+                     [](const Line& lhs, const Line& rhs) { return lhs.event.time < rhs.event.time; });
+
+    output << "# " << header.reason.data() << '\n';
+    const int64_t start = lines.empty() ? 0 : lines.front().event.time;
+    for (const Line& line : lines)
+    {
+        const int64_t offset = line.event.time - start;
+        std::array<char, 32> time{};
+        std::snprintf(time.data(), time.size(), "+%lld.%09lld s", static_cast<long long>(offset / 1'000'000'000),
+                      static_cast<long long>(offset % 1'000'000'000));
+        output << time.data() << "  thread " << line.threadId << "  event " << line.event.id << "  args";
+        for (int64_t arg : line.event.args)
+        {
+            output << ' ' << arg;
+        }
+        output << '\n';
+    }
+    return true;
+}
+
+}  // namespace zbo
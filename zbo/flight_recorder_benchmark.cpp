@@ -0,0 +1,70 @@
+#include "flight_recorder.h"
+
+#include <benchmark/benchmark.h>
+
+#include <chrono>
+#include <cstdio>
+#include <string>
+
+#if defined(__x86_64__)
+#include <x86intrin.h>
+#endif
+
+namespace zbo::bench {
+
+/// a clock that is cheaper than steady_clock but counts cycles instead of nanoseconds
+struct CycleClock
+{
+    using duration = std::chrono::nanoseconds;                         // NOLINT (readability-identifier-naming)
+    using time_point = std::chrono::time_point<CycleClock, duration>;  // NOLINT (readability-identifier-naming)
+
+    static time_point now() noexcept
+    {
+#if defined(__x86_64__)
+        return time_point(duration(static_cast<int64_t>(__rdtsc())));
+#else
+        return time_point(std::chrono::steady_clock::now().time_since_epoch());
+#endif
+    }
+};
+
+/// a recorder that is not installed, to see the cost of a disabled recorder
+struct NotInstalledClock : std::chrono::steady_clock
+{
+};
+
+template <typename Clock>
+void record(benchmark::State& state)
+{
+    if (state.thread_index() == 0 && !FlightRecorderT<Clock>::isInstalled() &&
+        !std::is_same_v<Clock, NotInstalledClock>)
+    {
+        static const std::string path = std::string(P_tmpdir) + "/flight_recorder_benchmark.bin";
+        FlightRecorderT<Clock>::install(path.c_str());
+    }
+    int64_t idx = 0;
+    for (auto _ : state)
+    {
+        FlightRecorderT<Clock>::record(7, idx++, 42);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+/// the lower bound of recording with the steady_clock
+void steadyClockNow(benchmark::State& state)
+{
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(std::chrono::steady_clock::now());
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK(steadyClockNow);
+BENCHMARK_TEMPLATE(record, std::chrono::steady_clock)->Threads(1)->Threads(4);
+BENCHMARK_TEMPLATE(record, CycleClock)->Threads(1)->Threads(4);
+BENCHMARK_TEMPLATE(record, NotInstalledClock);
+
+}  // namespace zbo::bench
+
+BENCHMARK_MAIN();
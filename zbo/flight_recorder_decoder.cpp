@@ -0,0 +1,21 @@
+#include "flight_recorder.h"
+
+#include <fstream>
+#include <iostream>
+
+/// turns a dump of the FlightRecorder into text, usage: flight_recorder_decoder <dump>
+int main(int argc, char** argv)
+{
+    if (argc != 2)
+    {
+        std::cerr << "usage: " << argv[0] << " <dump>\n";  // NOLINT (cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        return 1;
+    }
+    std::ifstream input(argv[1], std::ios::binary);  // NOLINT (cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    if (!zbo::decodeFlightDump(input, std::cout))
+    {
+        std::cerr << argv[1] << " is not a flight recorder dump\n";  // NOLINT (cppcoreguidelines-pro-bounds-*)
+        return 1;
+    }
+    return 0;
+}
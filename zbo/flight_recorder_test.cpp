@@ -0,0 +1,143 @@
+#include "flight_recorder.h"
+
+#include <gtest/gtest.h>
+
+#include <csignal>
+#include <fstream>
+#include <limits>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace zbo::test {
+
+constexpr size_t EVENTS_PER_THREAD = 8;
+
+const std::string& dumpPath()
+{
+    static const std::string path = testing::TempDir() + "flight_recorder_test.bin";
+    return path;
+}
+
+/// the recorder can only be installed once per process
+void installOnce()
+{
+    if (!FlightRecorder::isInstalled())
+    {
+        FlightRecorder::install(dumpPath().c_str(), 4, EVENTS_PER_THREAD);
+    }
+}
+
+std::string decodeDump()
+{
+    std::ifstream input(dumpPath(), std::ios::binary);
+    std::ostringstream output;
+    EXPECT_TRUE(decodeFlightDump(input, output));
+    return output.str();
+}
+
+std::vector<std::string> linesOf(const std::string& text)
+{
+    std::vector<std::string> lines;
+    std::istringstream stream(text);
+    for (std::string line; std::getline(stream, line);)
+    {
+        lines.push_back(line);
+    }
+    return lines;
+}
+
+TEST(FlightRecorder, KeepsTheLastEventsOfEveryThread)
+{
+    installOnce();
+    std::thread([]() {
+        for (int idx = 0; idx < 20; ++idx)
+        {
+            FlightRecorder::record(100, idx, -idx);
+        }
+    }).join();
+    // the ring of the exited thread is kept until another thread claims it
+    std::thread([]() { FlightRecorder::record(200, 1, 2, 3, 4); }).join();
+    ASSERT_TRUE(FlightRecorder::dump("manual dump"));
+
+    const auto lines = linesOf(decodeDump());
+    ASSERT_EQ(lines.front(), "# manual dump");
+    std::vector<std::string> ownEvents;
+    for (const auto& line : lines)
+    {
+        if (line.find("event 100 ") != std::string::npos || line.find("event 200 ") != std::string::npos)
+        {
+            ownEvents.push_back(line.substr(line.find("event")));
+        }
+    }
+    ASSERT_EQ(ownEvents.size(), EVENTS_PER_THREAD + 1);
+    ASSERT_EQ(ownEvents.front(), "event 100  args 12 -12 0 0");
+    ASSERT_EQ(ownEvents[EVENTS_PER_THREAD - 1], "event 100  args 19 -19 0 0");
+    ASSERT_EQ(ownEvents.back(), "event 200  args 1 2 3 4");
+}
+
+TEST(FlightRecorder, DecodeRejectsOtherFiles)
+{
+    std::istringstream input("certainly not a flight recorder dump, but long enough to read a header from it");
+    std::ostringstream output;
+    ASSERT_FALSE(decodeFlightDump(input, output));
+
+    // a well-formed header with invalid sizes, followed by a ring that has events
+    const auto decodeHeader = [](uint32_t numRings, uint32_t eventsPerRing) {
+        flight_dump::FileHeader header;
+        header.numRings = numRings;
+        header.eventsPerRing = eventsPerRing;
+        flight_dump::RingHeader ring;
+        ring.head = 3;
+        std::string dump(reinterpret_cast<const char*>(&header), sizeof(header));  // NOLINT
+        dump.append(reinterpret_cast<const char*>(&ring), sizeof(ring));           // NOLINT
+        dump.append(4 * sizeof(FlightEvent), '\0');
+        std::istringstream corrupt(dump);
+        std::ostringstream text;
+        return decodeFlightDump(corrupt, text);
+    };
+    ASSERT_TRUE(decodeHeader(1, 4));
+    ASSERT_FALSE(decodeHeader(1, 0));
+    ASSERT_FALSE(decodeHeader(1, 3));
+    ASSERT_FALSE(decodeHeader(1, 1U << 31U));
+    ASSERT_FALSE(decodeHeader(std::numeric_limits<uint32_t>::max(), 4));
+}
+
+TEST(FlightRecorderDeathTest, DumpsOnContractViolation)
+{
+    installOnce();
+    std::remove(dumpPath().c_str());
+    ASSERT_DEATH(
+        {
+            FlightRecorder::record(1, 42);
+            std::thread([]() { FlightRecorder::record(2, 43); }).join();
+            const int size = 3;
+            ZBO_PRECONDITION(size > 5)
+        },
+        "");
+
+    const std::string text = decodeDump();
+    ASSERT_NE(text.find("# Pre condition failed: size > 5 at "), std::string::npos) << text;
+    ASSERT_NE(text.find("flight_recorder_test.cpp:"), std::string::npos) << text;
+    ASSERT_NE(text.find("event 1  args 42 0 0 0"), std::string::npos) << text;
+    ASSERT_NE(text.find("event 2  args 43 0 0 0"), std::string::npos) << text;
+}
+
+TEST(FlightRecorderDeathTest, DumpsOnFatalSignal)
+{
+    installOnce();
+    std::remove(dumpPath().c_str());
+    ASSERT_DEATH(
+        {
+            FlightRecorder::record(3, 7);
+            std::raise(SIGSEGV);
+        },
+        "");
+
+    const std::string text = decodeDump();
+    ASSERT_NE(text.find("# fatal signal 11"), std::string::npos) << text;
+    ASSERT_NE(text.find("event 3  args 7 0 0 0"), std::string::npos) << text;
+}
+
+}  // namespace zbo::test
@@ -0,0 +1,326 @@
+// MIT License
+//
+// Copyright (c) 2020 Lenzebo
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include "contracts.h"
+#include "named_type.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace zbo {
+
+namespace detail {
+/// Hashes a NamedType by its underlying value, this works for plain NamedType typedefs as well
+template <typename Id>
+struct UnderlyingHash
+{
+    [[nodiscard]] size_t operator()(const Id& id) const noexcept { return std::hash<UnderlyingType<Id>>{}(id.get()); }
+};
+}  // namespace detail
+
+/**
+ * @brief Flat hash map keyed by a strong id (e.g. NamedType<uint32_t, struct OrderIdTag>) using open addressing with
+ *        linear probing. Use IdVector instead if the ids are dense.
+ *
+ * All entries are stored in one contiguous array together with their hash, so lookups touch (mostly) one cache line,
+ * growing does not need to rehash the keys and erasing shifts back the following entries instead of leaving
+ * tombstones. Keys are compared by their underlying value, so Id does not need to define any operators.
+ *
+ * Pointers and iterators into the map are invalidated by insertion and erasure.
+ *
+ * Usage:
+ *   IdMap<OrderId, Order> orders;
+ *   orders.insert(OrderId{5}, Order{...});
+ *   if (Order* order = orders.find(OrderId{5})) { ... }
+ *   for (auto [id, order] : orders) { ... }
+ *
+ * @tparam Id NamedType used as key
+ * @tparam T The mapped type
+ * @tparam Hash Hash function for Id, its result is mixed again before being used
+ */
+template <typename Id, typename T, typename Hash = detail::UnderlyingHash<Id>>
+class IdMap
+{
+    static_assert(std::is_default_constructible_v<T> && std::is_default_constructible_v<Id>,
+                  "Id and T must be default constructible for now to simplify the storage of empty slots");
+
+    static constexpr uint64_t EMPTY = 0;
+    static constexpr size_t MIN_CAPACITY = 16;
+
+    struct Slot
+    {
+        uint64_t hash = EMPTY;
+        Id id{};
+        T value{};
+    };
+
+    template <bool isConst>
+    class Iterator
+    {
+        using SlotType = std::conditional_t<isConst, const Slot, Slot>;
+        using ValueRef = std::conditional_t<isConst, const T&, T&>;
+
+      public:
+        using value_type = std::pair<const Id&, ValueRef>;    // NOLINT(readability-identifier-naming)
+        using difference_type = std::ptrdiff_t;               // NOLINT(readability-identifier-naming)
+        using iterator_category = std::forward_iterator_tag;  // NOLINT(readability-identifier-naming)
+
+        Iterator() = default;
+        Iterator(SlotType* slot, SlotType* end) : slot_(slot), end_(end) { skipEmpty(); }
+
+        [[nodiscard]] value_type operator*() const { return {slot_->id, slot_->value}; }
+        Iterator& operator++()
+        {
+            ++slot_;
+            skipEmpty();
+            return *this;
+        }
+        Iterator operator++(int)
+        {
+            Iterator it = *this;
+            ++(*this);
+            return it;
+        }
+        [[nodiscard]] bool operator==(const Iterator& other) const noexcept { return slot_ == other.slot_; }
+        [[nodiscard]] bool operator!=(const Iterator& other) const noexcept { return !((*this) == other); }
+
+      private:
+        void skipEmpty()
+        {
+            while (slot_ != end_ && slot_->hash == EMPTY)
+            {
+                ++slot_;
+            }
+        }
+
+        SlotType* slot_ = nullptr;
+        SlotType* end_ = nullptr;
+    };
+
+  public:
+    using key_type = Id;                    // NOLINT(readability-identifier-naming)
+    using mapped_type = T;                  // NOLINT(readability-identifier-naming)
+    using iterator = Iterator<false>;       // NOLINT(readability-identifier-naming)
+    using const_iterator = Iterator<true>;  // NOLINT(readability-identifier-naming)
+
+    IdMap() = default;
+    explicit IdMap(size_t expectedSize) { reserve(expectedSize); }
+
+    [[nodiscard]] iterator begin() noexcept { return {slots_.data(), slots_.data() + slots_.size()}; }
+    [[nodiscard]] iterator end() noexcept { return {slots_.data() + slots_.size(), slots_.data() + slots_.size()}; }
+    [[nodiscard]] const_iterator begin() const noexcept { return {slots_.data(), slots_.data() + slots_.size()}; }
+    [[nodiscard]] const_iterator end() const noexcept
+    {
+        return {slots_.data() + slots_.size(), slots_.data() + slots_.size()};
+    }
+
+    [[nodiscard]] bool empty() const noexcept { return size_ == 0; }
+    [[nodiscard]] size_t size() const noexcept { return size_; }
+    /// number of slots, the map grows when more than 3/4 of them are used
+    [[nodiscard]] size_t capacity() const noexcept { return slots_.size(); }
+
+    void clear()
+    {
+        for (auto& slot : slots_)
+        {
+            slot = Slot{};
+        }
+        size_ = 0;
+    }
+
+    /// makes sure that expectedSize elements can be stored without growing
+    void reserve(size_t expectedSize)
+    {
+        size_t newCapacity = std::max(MIN_CAPACITY, slots_.size());
+        while (exceedsLoadFactor(expectedSize, newCapacity))
+        {
+            newCapacity *= 2;
+        }
+        if (newCapacity != slots_.size())
+        {
+            rehash(newCapacity);
+        }
+    }
+
+    /**
+     * @brief inserts value under the given id if the id is not yet part of the map
+     * @return pointer to the value stored under id and whether the insertion took place
+     */
+    template <typename... Args>
+    std::pair<T*, bool> emplace(const Id& id, Args&&... args)
+    {
+        if (exceedsLoadFactor(size_ + 1, slots_.size()))
+        {
+            reserve(size_ + 1);
+        }
+
+        const uint64_t hash = hashOf(id);
+        size_t idx = homeIndex(hash);
+        while (slots_[idx].hash != EMPTY)
+        {
+            if (slots_[idx].hash == hash && slots_[idx].id.get() == id.get())
+            {
+                return {&slots_[idx].value, false};
+            }
+            idx = nextIndex(idx);
+        }
+
+        auto& slot = slots_[idx];
+        slot.hash = hash;
+        slot.id = id;
+        slot.value = T(std::forward<Args>(args)...);
+        ++size_;
+        return {&slot.value, true};
+    }
+
+    std::pair<T*, bool> insert(const Id& id, const T& value) { return emplace(id, value); }
+    std::pair<T*, bool> insert(const Id& id, T&& value) { return emplace(id, std::move(value)); }
+
+    /// returns the value stored under id, inserting a default constructed one if it does not exist yet
+    T& operator[](const Id& id) { return *emplace(id).first; }
+
+    /// returns a pointer to the value stored under id or nullptr if the map does not contain id
+    [[nodiscard]] T* find(const Id& id) noexcept
+    {
+        const size_t idx = findIndex(id);
+        return idx == slots_.size() ? nullptr : &slots_[idx].value;
+    }
+    [[nodiscard]] const T* find(const Id& id) const noexcept
+    {
+        const size_t idx = findIndex(id);
+        return idx == slots_.size() ? nullptr : &slots_[idx].value;
+    }
+
+    [[nodiscard]] bool contains(const Id& id) const noexcept { return findIndex(id) != slots_.size(); }
+
+    [[nodiscard]] T& at(const Id& id)
+    {
+        T* value = find(id);
+        ZBO_PRECONDITION(value != nullptr)
+        return *value;
+    }
+    [[nodiscard]] const T& at(const Id& id) const
+    {
+        const T* value = find(id);
+        ZBO_PRECONDITION(value != nullptr)
+        return *value;
+    }
+
+    /// removes id from the map and returns the number of removed elements (0 or 1)
+    size_t erase(const Id& id)
+    {
+        size_t hole = findIndex(id);
+        if (hole == slots_.size())
+        {
+            return 0;
+        }
+
+        // shift back all following entries of the probe sequence that may be moved into the hole
+        for (size_t idx = nextIndex(hole); slots_[idx].hash != EMPTY; idx = nextIndex(idx))
+        {
+            const size_t home = homeIndex(slots_[idx].hash);
+            const size_t distanceToHole = (hole - home) & mask();
+            const size_t distanceToIdx = (idx - home) & mask();
+            if (distanceToHole < distanceToIdx)
+            {
+                slots_[hole] = std::move(slots_[idx]);
+                hole = idx;
+            }
+        }
+        slots_[hole] = Slot{};
+        --size_;
+        return 1;
+    }
+
+  private:
+    [[nodiscard]] static bool exceedsLoadFactor(size_t size, size_t capacity) noexcept
+    {
+        return size * 4 > capacity * 3;
+    }
+
+    [[nodiscard]] static uint64_t hashOf(const Id& id) noexcept
+    {
+        // fibonacci hashing distributes sequential and strided ids over the (power of two) table, the lowest bit is
+        // set to distinguish occupied from empty slots. Slot indices are taken from the upper bits
+        constexpr uint64_t FIBONACCI = 0x9E3779B97F4A7C15ULL;
+        return (static_cast<uint64_t>(Hash{}(id)) * FIBONACCI) | 1U;
+    }
+
+    [[nodiscard]] size_t mask() const noexcept { return slots_.size() - 1; }
+    [[nodiscard]] size_t nextIndex(size_t idx) const noexcept { return (idx + 1) & mask(); }
+    [[nodiscard]] size_t homeIndex(uint64_t hash) const noexcept { return static_cast<size_t>(hash >> shift_); }
+
+    [[nodiscard]] size_t findIndex(const Id& id) const noexcept
+    {
+        if (slots_.empty())
+        {
+            return 0;
+        }
+        const uint64_t hash = hashOf(id);
+        for (size_t idx = homeIndex(hash); slots_[idx].hash != EMPTY; idx = nextIndex(idx))
+        {
+            if (slots_[idx].hash == hash && slots_[idx].id.get() == id.get())
+            {
+                return idx;
+            }
+        }
+        return slots_.size();
+    }
+
+    void rehash(size_t newCapacity)
+    {
+        std::vector<Slot> oldSlots(newCapacity);
+        std::swap(oldSlots, slots_);
+
+        shift_ = 64;
+        for (size_t capacity = newCapacity; capacity > 1; capacity /= 2)
+        {
+            --shift_;
+        }
+
+        for (auto& slot : oldSlots)
+        {
+            if (slot.hash == EMPTY)
+            {
+                continue;
+            }
+            size_t idx = homeIndex(slot.hash);
+            while (slots_[idx].hash != EMPTY)
+            {
+                idx = nextIndex(idx);
+            }
+            slots_[idx] = std::move(slot);
+        }
+    }
+
+    std::vector<Slot> slots_;
+    size_t size_ = 0;
+    unsigned shift_ = 64;
+};
+
+}  // namespace zbo
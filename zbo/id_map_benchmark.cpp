@@ -0,0 +1,187 @@
+#include "id_map.h"
+#include "id_vector.h"
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <numeric>
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+namespace zbo::bench {
+
+using OrderId = NamedType<uint32_t, struct OrderIdTag>;
+
+struct OrderIdHash
+{
+    size_t operator()(const OrderId& id) const noexcept { return std::hash<uint32_t>{}(id.get()); }
+};
+struct OrderIdEqual
+{
+    bool operator()(const OrderId& lhs, const OrderId& rhs) const noexcept { return lhs.get() == rhs.get(); }
+};
+
+using UnorderedMap = std::unordered_map<OrderId, uint64_t, OrderIdHash, OrderIdEqual>;
+using FlatMap = IdMap<OrderId, uint64_t>;
+
+constexpr int64_t MIN_SIZE = 1000;
+constexpr int64_t MAX_SIZE = 10'000'000;
+constexpr int MULTIPLIER = 10;
+
+/// unique, randomly distributed ids as they would come from an external system
+std::vector<OrderId> sparseIds(size_t size)
+{
+    std::mt19937 gen{42};
+    std::vector<uint32_t> raw(size);
+    std::uniform_int_distribution<uint32_t> dist;
+    std::generate(raw.begin(), raw.end(), [&]() { return dist(gen); });
+    std::sort(raw.begin(), raw.end());
+    raw.erase(std::unique(raw.begin(), raw.end()), raw.end());
+    std::shuffle(raw.begin(), raw.end(), gen);
+    return {raw.begin(), raw.end()};
+}
+
+/// ids 0..size-1 in random order
+std::vector<OrderId> denseIds(size_t size)
+{
+    std::mt19937 gen{42};
+    std::vector<uint32_t> raw(size);
+    std::iota(raw.begin(), raw.end(), 0);
+    std::shuffle(raw.begin(), raw.end(), gen);
+    return {raw.begin(), raw.end()};
+}
+
+template <typename Map>
+void insert(benchmark::State& state)
+{
+    const auto ids = sparseIds(state.range(0));
+    for (auto _ : state)
+    {
+        Map map;
+        for (const auto& id : ids)
+        {
+            map[id] = id.get();
+        }
+        benchmark::DoNotOptimize(map);
+    }
+    state.SetItemsProcessed(state.iterations() * ids.size());
+}
+
+void insertIdVector(benchmark::State& state)
+{
+    const auto size = static_cast<size_t>(state.range(0));
+    for (auto _ : state)
+    {
+        IdVector<OrderId, uint64_t> vector;
+        for (size_t i = 0; i < size; ++i)
+        {
+            vector.push_back(i);
+        }
+        benchmark::DoNotOptimize(vector);
+    }
+    state.SetItemsProcessed(state.iterations() * size);
+}
+
+template <typename Map>
+void lookup(benchmark::State& state)
+{
+    const auto ids = sparseIds(state.range(0));
+    Map map;
+    for (const auto& id : ids)
+    {
+        map[id] = id.get();
+    }
+    auto lookupIds = ids;
+    std::shuffle(lookupIds.begin(), lookupIds.end(), std::mt19937{1});
+
+    for (auto _ : state)
+    {
+        uint64_t sum = 0;
+        for (const auto& id : lookupIds)
+        {
+            if constexpr (std::is_same_v<Map, FlatMap>)
+            {
+                sum += *map.find(id);
+            }
+            else
+            {
+                sum += map.find(id)->second;
+            }
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * lookupIds.size());
+}
+
+void lookupIdVector(benchmark::State& state)
+{
+    const auto ids = denseIds(state.range(0));
+    IdVector<OrderId, uint64_t> vector(ids.size());
+    for (const auto& id : ids)
+    {
+        vector[id] = id.get();
+    }
+
+    for (auto _ : state)
+    {
+        uint64_t sum = 0;
+        for (const auto& id : ids)
+        {
+            sum += vector[id];
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * ids.size());
+}
+
+template <typename Map>
+void iterate(benchmark::State& state)
+{
+    const auto ids = sparseIds(state.range(0));
+    Map map;
+    for (const auto& id : ids)
+    {
+        map[id] = id.get();
+    }
+
+    for (auto _ : state)
+    {
+        uint64_t sum = 0;
+        for (auto [id, value] : map)
+        {
+            sum += value;
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * ids.size());
+}
+
+void iterateIdVector(benchmark::State& state)
+{
+    const IdVector<OrderId, uint64_t> vector(state.range(0));
+    for (auto _ : state)
+    {
+        uint64_t sum = 0;
+        for (uint64_t value : vector)
+        {
+            sum += value;
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * vector.size());
+}
+
+BENCHMARK_TEMPLATE(insert, UnorderedMap)->RangeMultiplier(MULTIPLIER)->Range(MIN_SIZE, MAX_SIZE);
+BENCHMARK_TEMPLATE(insert, FlatMap)->RangeMultiplier(MULTIPLIER)->Range(MIN_SIZE, MAX_SIZE);
+BENCHMARK(insertIdVector)->RangeMultiplier(MULTIPLIER)->Range(MIN_SIZE, MAX_SIZE);
+BENCHMARK_TEMPLATE(lookup, UnorderedMap)->RangeMultiplier(MULTIPLIER)->Range(MIN_SIZE, MAX_SIZE);
+BENCHMARK_TEMPLATE(lookup, FlatMap)->RangeMultiplier(MULTIPLIER)->Range(MIN_SIZE, MAX_SIZE);
+BENCHMARK(lookupIdVector)->RangeMultiplier(MULTIPLIER)->Range(MIN_SIZE, MAX_SIZE);
+BENCHMARK_TEMPLATE(iterate, UnorderedMap)->RangeMultiplier(MULTIPLIER)->Range(MIN_SIZE, MAX_SIZE);
+BENCHMARK_TEMPLATE(iterate, FlatMap)->RangeMultiplier(MULTIPLIER)->Range(MIN_SIZE, MAX_SIZE);
+BENCHMARK(iterateIdVector)->RangeMultiplier(MULTIPLIER)->Range(MIN_SIZE, MAX_SIZE);
+
+}  // namespace zbo::bench
+
+BENCHMARK_MAIN();
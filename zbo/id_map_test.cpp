@@ -0,0 +1,106 @@
+#include "id_map.h"
+
+#include <gtest/gtest.h>
+
+#include <random>
+#include <string>
+#include <unordered_map>
+
+namespace zbo::test {
+
+using OrderId = NamedType<uint32_t, struct OrderIdTag>;
+
+TEST(IdMap, InsertFind)
+{
+    IdMap<OrderId, std::string> names;
+    ASSERT_TRUE(names.empty());
+    ASSERT_EQ(names.find(OrderId{1}), nullptr);
+
+    auto [value, inserted] = names.insert(OrderId{1}, "one");
+    ASSERT_TRUE(inserted);
+    ASSERT_EQ(*value, "one");
+
+    std::tie(value, inserted) = names.insert(OrderId{1}, "uno");
+    ASSERT_FALSE(inserted);
+    ASSERT_EQ(*value, "one");
+
+    names[OrderId{2}] = "two";
+    ASSERT_EQ(names.size(), 2);
+    ASSERT_EQ(names.at(OrderId{2}), "two");
+    ASSERT_TRUE(names.contains(OrderId{1}));
+    ASSERT_FALSE(names.contains(OrderId{3}));
+}
+
+TEST(IdMap, Iteration)
+{
+    constexpr uint32_t SIZE = 100;
+    IdMap<OrderId, uint32_t> squares;
+    for (uint32_t i = 0; i < SIZE; ++i)
+    {
+        squares.insert(OrderId{i}, i * i);
+    }
+
+    size_t count = 0;
+    for (auto [id, square] : squares)
+    {
+        ASSERT_EQ(square, id.get() * id.get());
+        ++count;
+    }
+    ASSERT_EQ(count, SIZE);
+
+    squares.clear();
+    ASSERT_TRUE(squares.empty());
+    ASSERT_EQ(squares.begin(), squares.end());
+}
+
+TEST(IdMap, Reserve)
+{
+    constexpr size_t SIZE = 1000;
+    IdMap<OrderId, int> map(SIZE);
+    const size_t capacity = map.capacity();
+    ASSERT_GE(capacity, SIZE);
+    for (uint32_t i = 0; i < SIZE; ++i)
+    {
+        map[OrderId{i}] = 1;
+    }
+    ASSERT_EQ(map.capacity(), capacity);
+}
+
+TEST(IdMap, RandomOperationsMatchUnorderedMap)
+{
+    // small key range to get a lot of collisions, erasures of existing keys and reinsertions
+    constexpr uint32_t KEY_RANGE = 512;
+    constexpr size_t OPERATIONS = 100000;
+
+    std::mt19937 gen{1};
+    std::uniform_int_distribution<uint32_t> keyDist{0, KEY_RANGE};
+    std::uniform_int_distribution<int> opDist{0, 2};
+
+    IdMap<OrderId, uint32_t> map;
+    std::unordered_map<uint32_t, uint32_t> reference;
+    for (size_t i = 0; i < OPERATIONS; ++i)
+    {
+        // multiples of 1024 stress the mixing of the hash function
+        const uint32_t key = keyDist(gen) * 1024;
+        switch (opDist(gen))
+        {
+            case 0:
+                ASSERT_EQ(map.insert(OrderId{key}, key + 1).second, reference.emplace(key, key + 1).second);
+                break;
+            case 1:
+                ASSERT_EQ(map.erase(OrderId{key}), reference.erase(key));
+                break;
+            default:
+                ASSERT_EQ(map.contains(OrderId{key}), reference.contains(key));
+                break;
+        }
+        ASSERT_EQ(map.size(), reference.size());
+    }
+
+    for (auto [id, value] : map)
+    {
+        ASSERT_EQ(reference.at(id.get()), value);
+    }
+}
+
+}  // namespace zbo::test
@@ -0,0 +1,133 @@
+// MIT License
+//
+// Copyright (c) 2020 Lenzebo
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include "contracts.h"
+#include "named_type.h"
+
+#include <limits>
+#include <type_traits>
+#include <vector>
+
+namespace zbo {
+
+/**
+ * @brief A vector that is indexed by a strong integral id (e.g. NamedType<uint32_t, struct OrderIdTag>) instead of a
+ *        plain size_t. Use this instead of a map when ids are handed out densely starting from 0.
+ *
+ * Usage:
+ *   using OrderId = NamedType<uint32_t, struct OrderIdTag>;
+ *   IdVector<OrderId, Order> orders;
+ *   const OrderId id = orders.push_back(Order{...});
+ *   orders[id].price = ...;
+ *
+ * @tparam Id NamedType with an integral underlying type used as index
+ * @tparam T The value type within the container
+ */
+template <typename Id, typename T>
+class IdVector
+{
+  public:
+    using value_type = T;                                            // NOLINT (readability-identifier-naming)
+    using reference = T&;                                            // NOLINT (readability-identifier-naming)
+    using const_reference = const T&;                                // NOLINT (readability-identifier-naming)
+    using iterator = typename std::vector<T>::iterator;              // NOLINT (readability-identifier-naming)
+    using const_iterator = typename std::vector<T>::const_iterator;  // NOLINT (readability-identifier-naming)
+
+    static_assert(std::is_integral_v<UnderlyingType<Id>>, "Id must be a NamedType with an integral underlying type");
+
+    IdVector() = default;
+    explicit IdVector(size_t size) : data_(size) {}
+
+    [[nodiscard]] iterator begin() noexcept { return data_.begin(); }
+    [[nodiscard]] iterator end() noexcept { return data_.end(); }
+    [[nodiscard]] const_iterator begin() const noexcept { return data_.begin(); }
+    [[nodiscard]] const_iterator end() const noexcept { return data_.end(); }
+
+    [[nodiscard]] bool empty() const noexcept { return data_.empty(); }
+    [[nodiscard]] size_t size() const noexcept { return data_.size(); }
+    [[nodiscard]] T* data() noexcept { return data_.data(); }
+    [[nodiscard]] const T* data() const noexcept { return data_.data(); }
+
+    void reserve(size_t newCapacity) { data_.reserve(newCapacity); }
+    void resize(size_t newSize) { data_.resize(newSize); }
+    void clear() noexcept { data_.clear(); }
+
+    /// returns whether the id refers to an element in the container
+    [[nodiscard]] bool contains(const Id& id) const noexcept { return toIndex(id) < data_.size(); }
+
+    /// returns the id the next element added with push_back/emplace_back will get, which needs to fit into the id
+    [[nodiscard]] Id nextId() const noexcept
+    {
+        using Underlying = UnderlyingType<Id>;
+        constexpr auto MAX_ID = static_cast<std::make_unsigned_t<Underlying>>(std::numeric_limits<Underlying>::max());
+        ZBO_PRECONDITION(data_.size() <= MAX_ID)
+        return Id(static_cast<Underlying>(data_.size()));
+    }
+
+    [[nodiscard]] T& at(const Id& id)
+    {
+        ZBO_PRECONDITION(contains(id))
+        return data_[toIndex(id)];
+    }
+    [[nodiscard]] const T& at(const Id& id) const
+    {
+        ZBO_PRECONDITION(contains(id))
+        return data_[toIndex(id)];
+    }
+
+    [[nodiscard]] T& operator[](const Id& id) { return at(id); }
+    [[nodiscard]] const T& operator[](const Id& id) const { return at(id); }
+
+    // NOLINTNEXTLINE (readability-identifier-naming)
+    Id push_back(const T& elem)
+    {
+        const Id id = nextId();
+        data_.push_back(elem);
+        return id;
+    }
+
+    // NOLINTNEXTLINE (readability-identifier-naming)
+    Id push_back(T&& elem)
+    {
+        const Id id = nextId();
+        data_.push_back(std::move(elem));
+        return id;
+    }
+
+    /// constructs a new element at the end and returns its id
+    template <typename... Args>
+    Id emplace_back(Args&&... args)  // NOLINT (readability-identifier-naming)
+    {
+        const Id id = nextId();
+        data_.emplace_back(std::forward<Args>(args)...);
+        return id;
+    }
+
+  private:
+    [[nodiscard]] static size_t toIndex(const Id& id) noexcept { return static_cast<size_t>(id.get()); }
+
+    std::vector<T> data_;
+};
+
+}  // namespace zbo
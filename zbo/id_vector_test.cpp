@@ -0,0 +1,59 @@
+#include "id_vector.h"
+
+#include <gtest/gtest.h>
+
+#include <string>
+
+namespace zbo::test {
+
+using OrderId = NamedType<uint32_t, struct OrderIdTag>;
+
+TEST(IdVector, PushBackReturnsIds)
+{
+    IdVector<OrderId, std::string> names;
+    ASSERT_TRUE(names.empty());
+    ASSERT_EQ(names.nextId().get(), 0);
+
+    const OrderId first = names.push_back("first");
+    const OrderId second = names.emplace_back(3, 'x');
+    ASSERT_EQ(first.get(), 0);
+    ASSERT_EQ(second.get(), 1);
+    ASSERT_EQ(names.size(), 2);
+
+    ASSERT_EQ(names[first], "first");
+    ASSERT_EQ(names.at(second), "xxx");
+    ASSERT_TRUE(names.contains(second));
+    ASSERT_FALSE(names.contains(names.nextId()));
+}
+
+TEST(IdVector, IterateAndModify)
+{
+    constexpr size_t SIZE = 10;
+    IdVector<OrderId, int> values(SIZE);
+    for (uint32_t i = 0; i < SIZE; ++i)
+    {
+        values[OrderId{i}] = static_cast<int>(i);
+    }
+    int expected = 0;
+    for (int value : values)
+    {
+        ASSERT_EQ(value, expected++);
+    }
+    values.clear();
+    ASSERT_FALSE(values.contains(OrderId{0}));
+}
+
+TEST(IdVectorDeathTest, IdsNeedToFitIntoTheIdType)
+{
+    using SmallId = NamedType<uint8_t, struct SmallIdTag>;
+    IdVector<SmallId, int> values;
+    for (int i = 0; i < 256; ++i)
+    {
+        ASSERT_EQ(values.push_back(i).get(), i);
+    }
+    ASSERT_DEATH((void)values.push_back(256), "");
+    ASSERT_DEATH((void)values.emplace_back(256), "");
+    ASSERT_EQ(values.size(), 256);
+}
+
+}  // namespace zbo::test
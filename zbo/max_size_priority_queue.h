@@ -0,0 +1,332 @@
+// MIT License
+//
+// Copyright (c) 2020 Lenzebo
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include "contracts.h"
+#include "max_size_vector.h"
+#include "named_type.h"
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <utility>
+
+namespace zbo {
+
+/**
+ * @brief Priority queue with a fixed maximum size that is implemented as a d-ary heap in a MaxSizeVector, so it never
+ *        allocates.
+ *
+ * Like std::priority_queue, top() is the element that compares greatest with Compare, so std::greater<T> turns it
+ * into a min-queue (e.g. for timeouts). Every pushed element gets a Handle that stays valid until the element is
+ * popped or erased, which allows changing the priority of or removing an element that is not on top in O(log n).
+ * Handles of removed elements are reused by later pushes.
+ *
+ * A larger arity makes the heap flatter, so push, decrease_key and heapify touch fewer cache lines while pop compares
+ * more children per level. Which arity is best depends on the mix of operations, see max_size_priority_queue_benchmark.
+ *
+ * Usage:
+ *   MaxSizePriorityQueue<Timeout, 1024, std::greater<>> timeouts;
+ *   const auto handle = timeouts.push(Timeout{deadline, job});
+ *   timeouts.decrease_key(handle, Timeout{earlierDeadline, job});
+ *   while (!timeouts.empty() && timeouts.top().deadline <= now) { timeouts.pop(); }
+ *
+ * @tparam T element type, needs to be default constructible
+ * @tparam maxSize maximum number of elements
+ * @tparam Compare strict weak ordering, the greatest element is on top
+ * @tparam arity number of children per node of the heap
+ */
+template <typename T, size_t maxSize, typename Compare = std::less<T>, size_t arity = 4>
+class MaxSizePriorityQueue
+{
+    struct HandleTag;
+
+  public:
+    using value_type = T;           // NOLINT (readability-identifier-naming)
+    using size_type = size_t;       // NOLINT (readability-identifier-naming)
+    using value_compare = Compare;  // NOLINT (readability-identifier-naming)
+    using Handle = NamedType<uint32_t, HandleTag>;
+
+    constexpr MaxSizePriorityQueue() = default;
+    constexpr explicit MaxSizePriorityQueue(const Compare& compare) : compare_(compare) {}
+
+    /// builds the queue from [first, last) in O(n), see heapify()
+    template <class InputIterator>
+    constexpr MaxSizePriorityQueue(InputIterator first, InputIterator last, const Compare& compare = Compare())
+        : compare_(compare)
+    {
+        heapify(first, last);
+    }
+
+    [[nodiscard]] constexpr size_t size() const noexcept { return heap_.size(); }
+    [[nodiscard]] constexpr bool empty() const noexcept { return heap_.empty(); }
+    [[nodiscard]] static constexpr size_t capacity() noexcept { return maxSize; }
+
+    /// greatest element with respect to Compare
+    [[nodiscard]] constexpr const T& top() const
+    {
+        ZBO_PRECONDITION(!empty())
+        return heap_.data()[0].value;
+    }
+
+    /// handle of the element returned by top()
+    [[nodiscard]] constexpr Handle topHandle() const
+    {
+        ZBO_PRECONDITION(!empty())
+        return Handle(heap_.data()[0].slot);
+    }
+
+    /// returns whether handle refers to an element in the queue
+    [[nodiscard]] constexpr bool contains(Handle handle) const noexcept
+    {
+        return handle.get() < nextSlot_ && positions_[handle.get()] != NO_POSITION;
+    }
+
+    [[nodiscard]] constexpr const T& operator[](Handle handle) const
+    {
+        ZBO_PRECONDITION(contains(handle))
+        return heap_.data()[positions_[handle.get()]].value;
+    }
+
+    constexpr Handle push(const T& value) { return pushNode(Node{value, allocateSlot()}); }
+    constexpr Handle push(T&& value) { return pushNode(Node{std::move(value), allocateSlot()}); }
+
+    template <typename... Args>
+    constexpr Handle emplace(Args&&... args)
+    {
+        return pushNode(Node{T(std::forward<Args>(args)...), allocateSlot()});
+    }
+
+    /// removes the top element
+    constexpr void pop()
+    {
+        ZBO_PRECONDITION(!empty())
+        removeAt(0);
+    }
+
+    /// removes the element referred to by handle, which invalidates the handle
+    constexpr void erase(Handle handle)
+    {
+        ZBO_PRECONDITION(contains(handle))
+        removeAt(positions_[handle.get()]);
+    }
+
+    /**
+     * @brief moves an element closer to the top by replacing its value with one that does not compare less
+     *
+     * For a min-queue (Compare = std::greater) this decreases the value, hence the name.
+     */
+    // NOLINTNEXTLINE (readability-identifier-naming)
+    constexpr void decrease_key(Handle handle, T value)
+    {
+        ZBO_PRECONDITION(contains(handle))
+        const size_t idx = positions_[handle.get()];
+        Node& node = heap_.data()[idx];
+        ZBO_PRECONDITION(!compare_(value, node.value))
+        node.value = std::move(value);
+        siftUp(idx);
+    }
+
+    /// replaces the value of an element, which may move it in either direction
+    constexpr void update(Handle handle, T value)
+    {
+        ZBO_PRECONDITION(contains(handle))
+        const size_t idx = positions_[handle.get()];
+        Node& node = heap_.data()[idx];
+        const bool up = compare_(node.value, value);
+        node.value = std::move(value);
+        if (up)
+        {
+            siftUp(idx);
+        }
+        else
+        {
+            siftDown(idx);
+        }
+    }
+
+    /**
+     * @brief adds all elements of [first, last) and restores the heap once in O(size()) instead of pushing them one by
+     *        one in O(n log size())
+     *
+     * The handles of the added elements are not returned. If no element has been removed since construction or the
+     * last clear(), the elements get consecutive handles, i.e. the i-th element added to an empty queue gets Handle(i).
+     */
+    template <class InputIterator>
+    constexpr void heapify(InputIterator first, InputIterator last)
+    {
+        for (; first != last; ++first)
+        {
+            heap_.push_back(Node{*first, allocateSlot()});
+            positions_[heap_.back().slot] = static_cast<uint32_t>(heap_.size() - 1);
+        }
+        if (heap_.size() < 2)
+        {
+            return;
+        }
+        // sift down every node that has children, starting with the last one
+        for (size_t idx = parent(heap_.size() - 1) + 1; idx-- > 0;)
+        {
+            siftDown(idx);
+        }
+    }
+
+    /// removes all elements and invalidates all handles
+    constexpr void clear() noexcept
+    {
+        heap_.clear();
+        freeSlots_.clear();
+        nextSlot_ = 0;
+    }
+
+  private:
+    static_assert(arity >= 2, "a heap needs at least two children per node");
+    static_assert(maxSize < std::numeric_limits<uint32_t>::max(), "positions are stored as uint32_t");
+
+    static constexpr uint32_t NO_POSITION = std::numeric_limits<uint32_t>::max();
+
+    struct Node
+    {
+        T value{};
+        uint32_t slot = 0;
+    };
+
+    constexpr uint32_t allocateSlot()
+    {
+        if (freeSlots_.empty())
+        {
+            ZBO_PRECONDITION(nextSlot_ < maxSize)
+            return nextSlot_++;
+        }
+        const uint32_t slot = freeSlots_.back();
+        freeSlots_.pop_back();
+        return slot;
+    }
+
+    constexpr Handle pushNode(Node&& node)
+    {
+        const Handle handle(node.slot);
+        heap_.push_back(std::move(node));
+        siftUp(heap_.size() - 1);
+        return handle;
+    }
+
+    constexpr void removeAt(size_t idx)
+    {
+        Node* nodes = heap_.data();
+        positions_[nodes[idx].slot] = NO_POSITION;
+        freeSlots_.push_back(nodes[idx].slot);
+
+        // the last node fills the hole, which then moves up or down until that node fits
+        Node last = std::move(nodes[heap_.size() - 1]);
+        heap_.pop_back();
+        if (idx == heap_.size())
+        {
+            return;
+        }
+        if (idx > 0 && compare_(nodes[parent(idx)].value, last.value))
+        {
+            siftUp(idx, std::move(last));
+        }
+        else
+        {
+            siftDown(idx, std::move(last));
+        }
+    }
+
+    [[nodiscard]] static constexpr size_t parent(size_t idx) noexcept { return (idx - 1) / arity; }
+
+    /// moves node into position idx and records the new position for its handle
+    constexpr void place(size_t idx, Node&& node)
+    {
+        positions_[node.slot] = static_cast<uint32_t>(idx);
+        heap_.data()[idx] = std::move(node);
+    }
+
+    // the node is moved out first, as its position is overwritten while sifting
+    constexpr void siftUp(size_t idx)
+    {
+        Node node = std::move(heap_.data()[idx]);
+        siftUp(idx, std::move(node));
+    }
+    constexpr void siftDown(size_t idx)
+    {
+        Node node = std::move(heap_.data()[idx]);
+        siftDown(idx, std::move(node));
+    }
+
+    // both sift functions treat idx as a hole that the other nodes are shifted into instead of swapping at every
+    // level, node is only placed once its final position is known
+    constexpr void siftUp(size_t idx, Node&& node)
+    {
+        Node* nodes = heap_.data();
+        while (idx > 0 && compare_(nodes[parent(idx)].value, node.value))
+        {
+            place(idx, std::move(nodes[parent(idx)]));
+            idx = parent(idx);
+        }
+        place(idx, std::move(node));
+    }
+
+    constexpr void siftDown(size_t idx, Node&& node)
+    {
+        Node* nodes = heap_.data();
+        const size_t count = heap_.size();
+        while (true)
+        {
+            const size_t firstChild = idx * arity + 1;
+            if (firstChild >= count)
+            {
+                break;
+            }
+            const size_t lastChild = std::min(firstChild + arity, count);
+            size_t best = firstChild;
+            for (size_t child = firstChild + 1; child < lastChild; ++child)
+            {
+                if (compare_(nodes[best].value, nodes[child].value))
+                {
+                    best = child;
+                }
+            }
+            if (!compare_(node.value, nodes[best].value))
+            {
+                break;
+            }
+            place(idx, std::move(nodes[best]));
+            idx = best;
+        }
+        place(idx, std::move(node));
+    }
+
+    MaxSizeVector<Node, maxSize> heap_;
+    /// position in heap_ for every handle, NO_POSITION for handles of removed elements
+    std::array<uint32_t, maxSize> positions_{};
+    MaxSizeVector<uint32_t, maxSize> freeSlots_;
+    uint32_t nextSlot_ = 0;
+    [[no_unique_address]] Compare compare_{};
+};
+
+}  // namespace zbo
@@ -0,0 +1,185 @@
+#include "max_size_priority_queue.h"
+#include "max_size_vector.h"
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <functional>
+#include <memory>
+#include <queue>
+#include <random>
+#include <vector>
+
+namespace zbo::bench {
+
+constexpr size_t CAPACITY = 65'536;
+constexpr int64_t MIN_SIZE = 64;
+constexpr int64_t MAX_SIZE = CAPACITY;
+constexpr int MULTIPLIER = 4;
+
+// all queues hold timeouts, i.e. the smallest value is on top
+using Timeout = uint64_t;
+
+template <size_t arity>
+using HeapQueue = MaxSizePriorityQueue<Timeout, CAPACITY, std::greater<>, arity>;
+using StdQueue = std::priority_queue<Timeout, std::vector<Timeout>, std::greater<>>;
+
+/// the approach MaxSizePriorityQueue replaces: sorted descending, so the top is at the back and pop is cheap
+class SortedVectorQueue
+{
+  public:
+    void push(Timeout value)
+    {
+        auto* pos = std::upper_bound(values_.begin(), values_.end(), value, std::greater<>());
+        values_.insert(pos, &value, std::next(&value));
+    }
+    [[nodiscard]] Timeout top() const { return values_.back(); }
+    void pop() { values_.pop_back(); }
+
+    void decreaseKey(Timeout oldValue, Timeout newValue)
+    {
+        values_.erase(std::lower_bound(values_.begin(), values_.end(), oldValue, std::greater<>()));
+        push(newValue);
+    }
+
+  private:
+    MaxSizeVector<Timeout, CAPACITY> values_;
+};
+
+std::vector<Timeout> randomTimeouts(size_t size)
+{
+    std::mt19937_64 gen{42};
+    std::uniform_int_distribution<Timeout> dist(0, 1'000'000'000);
+    std::vector<Timeout> values(size);
+    std::generate(values.begin(), values.end(), [&]() { return dist(gen); });
+    return values;
+}
+
+/// steady state of a scheduler: the queue holds range(0) timeouts, the earliest expires and a new one is added
+template <typename Queue>
+void popPush(benchmark::State& state)
+{
+    const auto initial = randomTimeouts(state.range(0));
+    const auto added = randomTimeouts(4096);
+    auto queue = std::make_unique<Queue>();
+    for (const auto value : initial)
+    {
+        queue->push(value);
+    }
+
+    size_t idx = 0;
+    for (auto _ : state)
+    {
+        // keeps the values increasing like deadlines, so the new timeout does not always end up on top
+        const Timeout next = queue->top() + added[idx++ % added.size()];
+        queue->pop();
+        queue->push(next);
+        benchmark::DoNotOptimize(queue->top());
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+/// moves a random timeout that is not on top closer to the top, e.g. a job that got more urgent
+template <size_t arity>
+void decreaseKeyHeap(benchmark::State& state)
+{
+    const auto initial = randomTimeouts(state.range(0));
+    auto queue = std::make_unique<HeapQueue<arity>>();
+    std::vector<typename HeapQueue<arity>::Handle> handles;
+    for (const auto value : initial)
+    {
+        handles.push_back(queue->push(value));
+    }
+
+    std::mt19937 gen{42};
+    for (auto _ : state)
+    {
+        const auto handle = handles[gen() % handles.size()];
+        const Timeout value = (*queue)[handle];
+        queue->decrease_key(handle, value - std::min<Timeout>(value, gen() % 1000));
+        benchmark::DoNotOptimize(queue->top());
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+void decreaseKeySortedVector(benchmark::State& state)
+{
+    auto values = randomTimeouts(state.range(0));
+    auto queue = std::make_unique<SortedVectorQueue>();
+    for (const auto value : values)
+    {
+        queue->push(value);
+    }
+
+    std::mt19937 gen{42};
+    for (auto _ : state)
+    {
+        Timeout& value = values[gen() % values.size()];
+        const Timeout newValue = value - std::min<Timeout>(value, gen() % 1000);
+        queue->decreaseKey(value, newValue);
+        value = newValue;
+        benchmark::DoNotOptimize(queue->top());
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+/// builds a queue out of range(0) timeouts at once
+template <size_t arity>
+void heapify(benchmark::State& state)
+{
+    const auto values = randomTimeouts(state.range(0));
+    auto queue = std::make_unique<HeapQueue<arity>>();
+    for (auto _ : state)
+    {
+        queue->clear();
+        queue->heapify(values.begin(), values.end());
+        benchmark::DoNotOptimize(queue->top());
+    }
+    state.SetItemsProcessed(state.iterations() * values.size());
+}
+
+void heapifyStd(benchmark::State& state)
+{
+    const auto values = randomTimeouts(state.range(0));
+    for (auto _ : state)
+    {
+        StdQueue queue(std::greater<>(), values);
+        benchmark::DoNotOptimize(queue.top());
+    }
+    state.SetItemsProcessed(state.iterations() * values.size());
+}
+
+void heapifySortedVector(benchmark::State& state)
+{
+    const auto values = randomTimeouts(state.range(0));
+    auto sorted = std::make_unique<MaxSizeVector<Timeout, CAPACITY>>();
+    for (auto _ : state)
+    {
+        sorted->clear();
+        sorted->insert(sorted->begin(), values.begin(), values.end());
+        std::sort(sorted->begin(), sorted->end(), std::greater<>());
+        benchmark::DoNotOptimize(sorted->back());
+    }
+    state.SetItemsProcessed(state.iterations() * values.size());
+}
+
+BENCHMARK_TEMPLATE(popPush, HeapQueue<2>)->RangeMultiplier(MULTIPLIER)->Range(MIN_SIZE, MAX_SIZE);
+BENCHMARK_TEMPLATE(popPush, HeapQueue<4>)->RangeMultiplier(MULTIPLIER)->Range(MIN_SIZE, MAX_SIZE);
+BENCHMARK_TEMPLATE(popPush, HeapQueue<8>)->RangeMultiplier(MULTIPLIER)->Range(MIN_SIZE, MAX_SIZE);
+BENCHMARK_TEMPLATE(popPush, StdQueue)->RangeMultiplier(MULTIPLIER)->Range(MIN_SIZE, MAX_SIZE);
+BENCHMARK_TEMPLATE(popPush, SortedVectorQueue)->RangeMultiplier(MULTIPLIER)->Range(MIN_SIZE, MAX_SIZE);
+
+BENCHMARK_TEMPLATE(decreaseKeyHeap, 2)->RangeMultiplier(MULTIPLIER)->Range(MIN_SIZE, MAX_SIZE);
+BENCHMARK_TEMPLATE(decreaseKeyHeap, 4)->RangeMultiplier(MULTIPLIER)->Range(MIN_SIZE, MAX_SIZE);
+BENCHMARK_TEMPLATE(decreaseKeyHeap, 8)->RangeMultiplier(MULTIPLIER)->Range(MIN_SIZE, MAX_SIZE);
+BENCHMARK(decreaseKeySortedVector)->RangeMultiplier(MULTIPLIER)->Range(MIN_SIZE, MAX_SIZE);
+
+BENCHMARK_TEMPLATE(heapify, 2)->RangeMultiplier(MULTIPLIER)->Range(MIN_SIZE, MAX_SIZE);
+BENCHMARK_TEMPLATE(heapify, 4)->RangeMultiplier(MULTIPLIER)->Range(MIN_SIZE, MAX_SIZE);
+BENCHMARK_TEMPLATE(heapify, 8)->RangeMultiplier(MULTIPLIER)->Range(MIN_SIZE, MAX_SIZE);
+BENCHMARK(heapifyStd)->RangeMultiplier(MULTIPLIER)->Range(MIN_SIZE, MAX_SIZE);
+BENCHMARK(heapifySortedVector)->RangeMultiplier(MULTIPLIER)->Range(MIN_SIZE, MAX_SIZE);
+
+}  // namespace zbo::bench
+
+BENCHMARK_MAIN();
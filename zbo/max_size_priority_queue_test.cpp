@@ -0,0 +1,207 @@
+#include "max_size_priority_queue.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <functional>
+#include <random>
+#include <vector>
+
+namespace zbo::test {
+
+TEST(MaxSizePriorityQueue, PushPopInOrder)
+{
+    MaxSizePriorityQueue<int, 8> queue;
+    ASSERT_TRUE(queue.empty());
+    ASSERT_EQ(queue.capacity(), 8);
+
+    for (int value : {3, 7, 1, 5, 7, 2})
+    {
+        queue.push(value);
+    }
+    ASSERT_EQ(queue.size(), 6);
+
+    std::vector<int> popped;
+    while (!queue.empty())
+    {
+        popped.push_back(queue.top());
+        queue.pop();
+    }
+    ASSERT_EQ(popped, (std::vector<int>{7, 7, 5, 3, 2, 1}));
+}
+
+TEST(MaxSizePriorityQueue, MinQueueWithGreater)
+{
+    MaxSizePriorityQueue<int, 8, std::greater<>> queue;
+    queue.push(5);
+    queue.emplace(2);
+    queue.push(9);
+    ASSERT_EQ(queue.top(), 2);
+    queue.pop();
+    ASSERT_EQ(queue.top(), 5);
+}
+
+TEST(MaxSizePriorityQueue, HandlesStayValid)
+{
+    MaxSizePriorityQueue<int, 8> queue;
+    const auto low = queue.push(1);
+    const auto high = queue.push(10);
+    const auto mid = queue.push(5);
+
+    ASSERT_EQ(queue.topHandle().get(), high.get());
+    ASSERT_EQ(queue[low], 1);
+    ASSERT_EQ(queue[mid], 5);
+
+    queue.pop();
+    ASSERT_FALSE(queue.contains(high));
+    ASSERT_TRUE(queue.contains(low));
+    ASSERT_EQ(queue[low], 1);
+    ASSERT_EQ(queue.topHandle().get(), mid.get());
+
+    // the handle of the popped element is reused
+    const auto reused = queue.push(3);
+    ASSERT_EQ(reused.get(), high.get());
+    ASSERT_EQ(queue[reused], 3);
+}
+
+TEST(MaxSizePriorityQueue, DecreaseKeyMovesToTop)
+{
+    MaxSizePriorityQueue<int, 16, std::greater<>> timeouts;
+    std::vector<MaxSizePriorityQueue<int, 16, std::greater<>>::Handle> handles;
+    for (int deadline = 10; deadline < 20; ++deadline)
+    {
+        handles.push_back(timeouts.push(deadline));
+    }
+    ASSERT_EQ(timeouts.top(), 10);
+
+    timeouts.decrease_key(handles[7], 5);
+    ASSERT_EQ(timeouts.top(), 5);
+    ASSERT_EQ(timeouts.topHandle().get(), handles[7].get());
+    ASSERT_EQ(timeouts[handles[7]], 5);
+}
+
+TEST(MaxSizePriorityQueue, UpdateAndErase)
+{
+    MaxSizePriorityQueue<int, 16> queue;
+    std::vector<MaxSizePriorityQueue<int, 16>::Handle> handles;
+    for (int value = 0; value < 10; ++value)
+    {
+        handles.push_back(queue.push(value));
+    }
+
+    queue.update(handles[9], -1);
+    ASSERT_EQ(queue.top(), 8);
+    queue.update(handles[0], 100);
+    ASSERT_EQ(queue.top(), 100);
+
+    queue.erase(handles[0]);
+    queue.erase(handles[4]);
+    ASSERT_FALSE(queue.contains(handles[4]));
+    ASSERT_EQ(queue.size(), 8);
+
+    std::vector<int> popped;
+    while (!queue.empty())
+    {
+        popped.push_back(queue.top());
+        queue.pop();
+    }
+    ASSERT_EQ(popped, (std::vector<int>{8, 7, 6, 5, 3, 2, 1, -1}));
+}
+
+TEST(MaxSizePriorityQueue, Heapify)
+{
+    using Queue = MaxSizePriorityQueue<int, 16>;
+    const std::vector<int> values = {4, 9, 1, 7, 3, 8, 2};
+    Queue queue(values.begin(), values.end());
+    ASSERT_EQ(queue.size(), values.size());
+    ASSERT_EQ(queue.top(), 9);
+
+    // elements added to an empty queue get consecutive handles
+    for (uint32_t idx = 0; idx < values.size(); ++idx)
+    {
+        ASSERT_EQ(queue[Queue::Handle(idx)], values[idx]);
+    }
+
+    const std::vector<int> more = {5, 10};
+    queue.heapify(more.begin(), more.end());
+    ASSERT_EQ(queue.top(), 10);
+    ASSERT_EQ(queue.size(), 9);
+
+    queue.clear();
+    ASSERT_TRUE(queue.empty());
+    ASSERT_EQ(queue.push(1).get(), 0);
+}
+
+template <size_t arity>
+void checkAgainstReference()
+{
+    using Queue = MaxSizePriorityQueue<int, 256, std::less<>, arity>;
+    std::mt19937 rng(42);  // NOLINT (cert-msc51-cpp) deterministic on purpose
+    std::uniform_int_distribution<int> values(0, 1000);
+
+    Queue queue;
+    std::vector<std::pair<typename Queue::Handle, int>> reference;
+    for (int iteration = 0; iteration < 5000; ++iteration)
+    {
+        const auto operation = rng() % 4;
+        if (operation < 2 && reference.size() < Queue::capacity())
+        {
+            const int value = values(rng);
+            reference.emplace_back(queue.push(value), value);
+        }
+        else if (operation == 2 && !reference.empty())
+        {
+            auto& [handle, value] = reference[rng() % reference.size()];
+            value = values(rng);
+            queue.update(handle, value);
+        }
+        else if (!reference.empty())
+        {
+            const auto byValue = [](const auto& lhs, const auto& rhs) { return lhs.second < rhs.second; };
+            const auto maxIt = std::max_element(reference.begin(), reference.end(), byValue);
+            ASSERT_EQ(queue.top(), maxIt->second);
+            ASSERT_EQ(queue[queue.topHandle()], maxIt->second);
+            std::erase_if(reference, [&](const auto& entry) { return entry.first.get() == queue.topHandle().get(); });
+            queue.pop();
+        }
+        ASSERT_EQ(queue.size(), reference.size());
+        for (const auto& [handle, value] : reference)
+        {
+            ASSERT_EQ(queue[handle], value);
+        }
+    }
+}
+
+TEST(MaxSizePriorityQueue, MatchesReferenceForAllArities)
+{
+    checkAgainstReference<2>();
+    checkAgainstReference<3>();
+    checkAgainstReference<4>();
+    checkAgainstReference<8>();
+}
+
+TEST(MaxSizePriorityQueue, Constexpr)
+{
+    constexpr int TOP = [] {
+        MaxSizePriorityQueue<int, 4> queue;
+        queue.push(2);
+        const auto handle = queue.push(1);
+        queue.decrease_key(handle, 3);
+        return queue.top();
+    }();
+    static_assert(TOP == 3);
+}
+
+TEST(MaxSizePriorityQueueDeathTest, ContractViolations)
+{
+    MaxSizePriorityQueue<int, 2> queue;
+    ASSERT_DEATH(queue.pop(), "");
+    const auto handle = queue.push(5);
+    queue.push(6);
+    ASSERT_DEATH(queue.push(7), "");
+    ASSERT_DEATH(queue.decrease_key(handle, 4), "");
+    queue.erase(handle);
+    ASSERT_DEATH((void)queue[handle], "");
+}
+
+}  // namespace zbo::test
@@ -78,8 +78,8 @@ class MaxSizeVector
         size_t dist = std::distance(first, last);
         ZBO_PRECONDITION(size() + dist <= capacity());
 
-        // first move all the elements to the end...
-        std::move(position, end(), position + dist);  // NOLINT
+        // first move all the elements to the end, back to front as the ranges overlap...
+        std::move_backward(position, end(), end() + dist);  // NOLINT
 
         // now copy the input range into the empty space
         std::copy(first, last, position);
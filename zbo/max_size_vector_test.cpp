@@ -2,6 +2,8 @@
 
 #include <gtest/gtest.h>
 
+#include <string>
+
 namespace zbo::test {
 
 constexpr size_t MAX_SIZE = 10;
@@ -77,6 +79,19 @@ TEST(MaxSizeVector, InsertErase)
     ASSERT_EQ(vector.back(), 1);
 }
 
+TEST(MaxSizeVector, InsertInTheMiddleKeepsTail)
+{
+    // std::string is not trivially copyable, so the shift is not a memmove and has to run back to front
+    MaxSizeVector<std::string, MAX_SIZE> vector{};
+    const std::array<std::string, 5> head{"a", "b", "d", "e", "f"};
+    const std::array<std::string, 1> middle{"c"};
+    vector.insert(vector.begin(), head.begin(), head.end());
+    vector.insert(std::next(vector.begin(), 2), middle.begin(), middle.end());
+
+    const std::array<std::string, 6> expected{"a", "b", "c", "d", "e", "f"};
+    ASSERT_TRUE(std::equal(expected.begin(), expected.end(), vector.begin(), vector.end()));
+}
+
 template <typename T, typename Func>
 void testAlgorithm(std::vector<T> data, Func&& function)
 {
@@ -22,9 +22,16 @@
 
 #pragma once
 
+#include "contracts.h"
+
+#include <algorithm>
 #include <array>
+#include <cstdint>
+#include <limits>
 #include <optional>
+#include <span>
 #include <string_view>
+#include <type_traits>
 
 namespace zbo {
 
@@ -43,6 +50,10 @@ struct MetaEnumMember
 
 /**
  * @brief Struct describing an complete enum type
+ *
+ * The members are stored column wise: values and names are what iteration and lookups touch, the full member
+ * declarations (including initializers and comments) are kept in a separate array.
+ *
  * @tparam EnumType
  * @tparam UnderlyingTypeIn
  * @tparam SIZE
@@ -52,8 +63,15 @@ struct MetaEnum
 {
     using UnderlyingType = UnderlyingTypeIn;
     [[nodiscard]] constexpr size_t size() const { return numEnums; }
+    [[nodiscard]] constexpr MetaEnumMember<EnumType> member(size_t index) const
+    {
+        return {values.at(index), names.at(index), strings.at(index), index};
+    }
+
     std::string_view string;
-    std::array<MetaEnumMember<EnumType>, numEnums> members = {};
+    std::array<EnumType, numEnums> values = {};
+    std::array<std::string_view, numEnums> names = {};
+    std::array<std::string_view, numEnums> strings = {};
 };
 
 #include "detail/meta_enum_detail.h"
@@ -68,11 +86,12 @@ struct MetaEnum
 #define ZBO_DECLARE_NESTED_ENUM(Type, UnderlyingType, ...) ZBO_ENUM_IMPL(Type, , friend, UnderlyingType, __VA_ARGS__)
 
 /**
- * @brief This function returns the MetaEnum definition for a given enum type @see MetaEnum
+ * @brief This function returns the MetaEnum definition for a given enum type @see MetaEnum. The definition is a
+ *        constexpr variable, so this can be used in constant expressions
  * @tparam E enum type
  */
 template <class E>
-const auto& metaEnum()
+constexpr const auto& metaEnum()
 {
     return metaEnum(::zbo::meta_enum_internal::Tag<E>());
 }
@@ -83,18 +102,18 @@ const auto& metaEnum()
  * @return string representation of the passed enum value
  */
 template <class E>
-std::string_view enumToString(E e)
+constexpr std::string_view enumToString(E e)
 {
     return enumToString<E>(e, meta_enum_internal::Tag<E>());
 }
 
 /**
- * @brief Returns the index (in MetaEnum.members) of the given enum value
+ * @brief Returns the index (in MetaEnum.values) of the given enum value
  * @tparam E enum type
  * @param e value of that enum
  */
 template <class E>
-size_t enumToIndex(E e)
+constexpr size_t enumToIndex(E e)
 {
     return enumToIndex<E>(e, meta_enum_internal::Tag<E>());
 }
@@ -105,18 +124,30 @@ size_t enumToIndex(E e)
  * @return enum value that corresponds to str, or empty if parsing fails
  */
 template <class E>
-std::optional<E> stringToEnum(std::string_view str)
+constexpr std::optional<E> stringToEnum(std::string_view str)
 {
     return stringToEnum<E>(str, meta_enum_internal::Tag<E>());
 }
 
+/**
+ * @brief Same as stringToEnum, but ignores the (ASCII) case of str, e.g. "one", "One" and "ONE" are all parsed as ONE.
+ *        Member names must differ by more than their case to use this.
+ * @tparam E enum type to generate
+ * @return enum value whose name equals str ignoring case, or empty if parsing fails
+ */
+template <class E>
+constexpr std::optional<E> stringToEnumCaseInsensitive(std::string_view str)
+{
+    return stringToEnumCaseInsensitive<E>(str, meta_enum_internal::Tag<E>());
+}
+
 /**
  * @brief Helper class to convert a string to an enum or return the default value if it cannot be parsed corretly
  * @tparam E enum type to parse
  * @return enum value that corresponds to str, or the default_value if parsing fails
  */
 template <class E>
-E stringToEnum(std::string_view str, E defaultValue)
+constexpr E stringToEnum(std::string_view str, E defaultValue)
 {
     return stringToEnum<E>(str).value_or(defaultValue);
 }
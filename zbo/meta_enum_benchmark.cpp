@@ -0,0 +1,265 @@
+#include "meta_enum.h"
+#include "meta_enum_iterator.h"
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <optional>
+#include <random>
+#include <string>
+#include <vector>
+
+// NOLINTNEXTLINE (cppcoreguidelines-macro-usage)
+#define ZBO_BENCH_SIXTEEN(P)                                                                                 \
+    P##_ALPHA, P##_BRAVO, P##_CHARLIE, P##_DELTA, P##_ECHO, P##_FOXTROT, P##_GOLF, P##_HOTEL, P##_INDIA, \
+        P##_JULIETT, P##_KILO, P##_LIMA, P##_MIKE, P##_NOVEMBER, P##_OSCAR, P##_PAPA
+
+ZBO_ENUM_CLASS(Small, uint16_t, NEW, PARTIALLY_FILLED, FILLED, CANCELED)
+ZBO_ENUM_CLASS(Medium, uint16_t, ZBO_BENCH_SIXTEEN(ORDER), ZBO_BENCH_SIXTEEN(TRADE))
+ZBO_ENUM_CLASS(Large, uint16_t, ZBO_BENCH_SIXTEEN(ORDER), ZBO_BENCH_SIXTEEN(TRADE), ZBO_BENCH_SIXTEEN(QUOTE),
+               ZBO_BENCH_SIXTEEN(MARKET), ZBO_BENCH_SIXTEEN(LIMIT), ZBO_BENCH_SIXTEEN(STOP), ZBO_BENCH_SIXTEEN(ICEBERG),
+               ZBO_BENCH_SIXTEEN(AUCTION), ZBO_BENCH_SIXTEEN(OPEN), ZBO_BENCH_SIXTEEN(CLOSE), ZBO_BENCH_SIXTEEN(HALT),
+               ZBO_BENCH_SIXTEEN(RESUME), ZBO_BENCH_SIXTEEN(SETTLE), ZBO_BENCH_SIXTEEN(CLEAR),
+               ZBO_BENCH_SIXTEEN(REJECT), ZBO_BENCH_SIXTEEN(EXPIRE))
+ZBO_ENUM_CLASS(SmallSparse, int32_t, NEW = 100, PARTIALLY_FILLED = 2000, FILLED = 30000, CANCELED = 400000)
+ZBO_ENUM_CLASS(LargeSparse, int32_t, ZBO_BENCH_SIXTEEN(ORDER), TRADE = 10000, ZBO_BENCH_SIXTEEN(TRADE),
+               QUOTE = 20000, ZBO_BENCH_SIXTEEN(QUOTE), MARKET = 30000, ZBO_BENCH_SIXTEEN(MARKET), LIMIT = 40000,
+               ZBO_BENCH_SIXTEEN(LIMIT), STOP = 50000, ZBO_BENCH_SIXTEEN(STOP), ICEBERG = 60000,
+               ZBO_BENCH_SIXTEEN(ICEBERG), AUCTION = 70000, ZBO_BENCH_SIXTEEN(AUCTION), OPEN = 80000,
+               ZBO_BENCH_SIXTEEN(OPEN), CLOSE = 90000, ZBO_BENCH_SIXTEEN(CLOSE), HALT = 100000,
+               ZBO_BENCH_SIXTEEN(HALT), RESUME = 110000, ZBO_BENCH_SIXTEEN(RESUME), SETTLE = 120000,
+               ZBO_BENCH_SIXTEEN(SETTLE), CLEAR = 130000, ZBO_BENCH_SIXTEEN(CLEAR), REJECT = 140000,
+               ZBO_BENCH_SIXTEEN(REJECT), EXPIRE = 150000, ZBO_BENCH_SIXTEEN(EXPIRE))
+
+namespace zbo::bench {
+
+constexpr size_t NUM_LOOKUPS = 1024;
+
+/// the linear scan over all members stringToEnum used to do
+template <typename E>
+std::optional<E> linearStringToEnum(std::string_view str)
+{
+    const auto& m = metaEnum<E>();
+    for (size_t i = 0; i < m.size(); ++i)
+    {
+        if (m.names[i] == str)
+        {
+            return m.values[i];
+        }
+    }
+    return std::nullopt;
+}
+
+/// the linear scan over all members enumToIndex used to do
+template <typename E>
+size_t linearEnumToIndex(E e)
+{
+    const auto& m = metaEnum<E>();
+    for (size_t i = 0; i < m.size(); ++i)
+    {
+        if (m.values[i] == e)
+        {
+            return i;
+        }
+    }
+    return m.size();
+}
+
+template <typename E>
+std::string_view linearEnumToString(E e)
+{
+    const auto& m = metaEnum<E>();
+    const size_t idx = linearEnumToIndex(e);
+    return idx < m.size() ? m.names[idx] : std::string_view("__INVALID_ENUM_VAL__");
+}
+
+template <typename E>
+std::vector<E> randomValues()
+{
+    std::mt19937 gen{42};
+    const auto& m = metaEnum<E>();
+    std::uniform_int_distribution<size_t> dist{0, m.size() - 1};
+    std::vector<E> values;
+    for (size_t i = 0; i < NUM_LOOKUPS; ++i)
+    {
+        values.push_back(m.values.at(dist(gen)));
+    }
+    return values;
+}
+
+template <typename E>
+std::vector<std::string> randomNames(bool known, bool lowerCase = false)
+{
+    std::mt19937 gen{42};
+    const auto& m = metaEnum<E>();
+    std::uniform_int_distribution<size_t> dist{0, m.size() - 1};
+    std::vector<std::string> names;
+    for (size_t i = 0; i < NUM_LOOKUPS; ++i)
+    {
+        std::string name{m.names.at(dist(gen))};
+        if (!known)
+        {
+            name.back() = '#';
+        }
+        if (lowerCase)
+        {
+            std::transform(name.begin(), name.end(), name.begin(), [](char c) { return std::tolower(c); });
+        }
+        names.push_back(std::move(name));
+    }
+    return names;
+}
+
+template <typename E, typename Parse>
+void runLookups(benchmark::State& state, const std::vector<std::string>& names, Parse parse)
+{
+    for (auto _ : state)
+    {
+        for (const auto& name : names)
+        {
+            benchmark::DoNotOptimize(parse(name));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(names.size()));
+    state.counters["members"] = static_cast<double>(metaEnum<E>().size());
+}
+
+template <typename E>
+void linearScan(benchmark::State& state)
+{
+    runLookups<E>(state, randomNames<E>(true), [](std::string_view name) { return linearStringToEnum<E>(name); });
+}
+
+template <typename E>
+void perfectHash(benchmark::State& state)
+{
+    runLookups<E>(state, randomNames<E>(true), [](std::string_view name) { return stringToEnum<E>(name); });
+}
+
+template <typename E>
+void perfectHashCaseInsensitive(benchmark::State& state)
+{
+    runLookups<E>(state, randomNames<E>(true, true),
+                  [](std::string_view name) { return stringToEnumCaseInsensitive<E>(name); });
+}
+
+template <typename E>
+void linearScanUnknown(benchmark::State& state)
+{
+    runLookups<E>(state, randomNames<E>(false), [](std::string_view name) { return linearStringToEnum<E>(name); });
+}
+
+template <typename E>
+void perfectHashUnknown(benchmark::State& state)
+{
+    runLookups<E>(state, randomNames<E>(false), [](std::string_view name) { return stringToEnum<E>(name); });
+}
+
+template <typename E, typename Convert>
+void runConversions(benchmark::State& state, Convert convert)
+{
+    const auto values = randomValues<E>();
+    for (auto _ : state)
+    {
+        for (const auto value : values)
+        {
+            benchmark::DoNotOptimize(convert(value));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(values.size()));
+    state.counters["members"] = static_cast<double>(metaEnum<E>().size());
+}
+
+template <typename E>
+void linearToIndex(benchmark::State& state)
+{
+    runConversions<E>(state, [](E e) { return linearEnumToIndex(e); });
+}
+
+template <typename E>
+void tableToIndex(benchmark::State& state)
+{
+    runConversions<E>(state, [](E e) { return enumToIndex(e); });
+}
+
+template <typename E>
+void linearToString(benchmark::State& state)
+{
+    runConversions<E>(state, [](E e) { return linearEnumToString(e); });
+}
+
+template <typename E>
+void tableToString(benchmark::State& state)
+{
+    runConversions<E>(state, [](E e) { return enumToString(e); });
+}
+
+template <typename E>
+void iterateRange(benchmark::State& state)
+{
+    for (auto _ : state)
+    {
+        int64_t sum = 0;
+        for (const auto e : MetaEnumRange<E>())
+        {
+            sum += static_cast<int64_t>(e);
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(metaEnum<E>().size()));
+}
+
+template <typename E>
+void iterateNames(benchmark::State& state)
+{
+    for (auto _ : state)
+    {
+        size_t length = 0;
+        for (const auto e : MetaEnumRange<E>())
+        {
+            length += enumToString(e).size();
+        }
+        benchmark::DoNotOptimize(length);
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(metaEnum<E>().size()));
+}
+
+BENCHMARK_TEMPLATE(linearScan, Small);
+BENCHMARK_TEMPLATE(perfectHash, Small);
+BENCHMARK_TEMPLATE(perfectHashCaseInsensitive, Small);
+BENCHMARK_TEMPLATE(linearScan, Medium);
+BENCHMARK_TEMPLATE(perfectHash, Medium);
+BENCHMARK_TEMPLATE(perfectHashCaseInsensitive, Medium);
+BENCHMARK_TEMPLATE(linearScan, Large);
+BENCHMARK_TEMPLATE(perfectHash, Large);
+BENCHMARK_TEMPLATE(perfectHashCaseInsensitive, Large);
+BENCHMARK_TEMPLATE(linearScanUnknown, Large);
+BENCHMARK_TEMPLATE(perfectHashUnknown, Large);
+
+BENCHMARK_TEMPLATE(linearToIndex, Small);
+BENCHMARK_TEMPLATE(tableToIndex, Small);
+BENCHMARK_TEMPLATE(linearToIndex, SmallSparse);
+BENCHMARK_TEMPLATE(tableToIndex, SmallSparse);
+BENCHMARK_TEMPLATE(linearToIndex, Large);
+BENCHMARK_TEMPLATE(tableToIndex, Large);
+BENCHMARK_TEMPLATE(linearToIndex, LargeSparse);
+BENCHMARK_TEMPLATE(tableToIndex, LargeSparse);
+BENCHMARK_TEMPLATE(linearToString, Small);
+BENCHMARK_TEMPLATE(tableToString, Small);
+BENCHMARK_TEMPLATE(linearToString, SmallSparse);
+BENCHMARK_TEMPLATE(tableToString, SmallSparse);
+BENCHMARK_TEMPLATE(linearToString, Large);
+BENCHMARK_TEMPLATE(tableToString, Large);
+BENCHMARK_TEMPLATE(linearToString, LargeSparse);
+BENCHMARK_TEMPLATE(tableToString, LargeSparse);
+
+BENCHMARK_TEMPLATE(iterateRange, Small);
+BENCHMARK_TEMPLATE(iterateRange, Large);
+BENCHMARK_TEMPLATE(iterateRange, LargeSparse);
+BENCHMARK_TEMPLATE(iterateNames, Small);
+BENCHMARK_TEMPLATE(iterateNames, Large);
+BENCHMARK_TEMPLATE(iterateNames, LargeSparse);
+
+}  // namespace zbo::bench
+
+BENCHMARK_MAIN();
@@ -0,0 +1,76 @@
+#!/usr/bin/env python3
+"""Measures compile time and peak memory of translation units with one generated ZBO_ENUM of growing size.
+
+Every generated enum mixes members with and without initializers and the translation unit uses metaEnum, enumToString
+and stringToEnum, so the parsing of the member list and the lookup tables are all evaluated by the compiler.
+"""
+
+import argparse
+import os
+import sys
+import tempfile
+import time
+
+DEFAULT_SIZES = [10, 50, 100, 500, 1000, 2000, 5000]
+
+
+def generate_source(num_members):
+    members = []
+    for i in range(num_members):
+        # every fourth member continues from the previous value, the others are spread out
+        members.append(f"    MEMBER_{i}" if i % 4 == 3 else f"    MEMBER_{i} = {i * 7}")
+    member_list = ",\n".join(members)
+    return f"""#include "zbo/meta_enum.h"
+
+ZBO_ENUM_CLASS(Generated, int32_t,
+{member_list})
+
+int main(int argc, char** argv)
+{{
+    const auto parsed = zbo::stringToEnum<Generated>(argv[0]);
+    return static_cast<int>(zbo::metaEnum<Generated>().size() + zbo::enumToString(static_cast<Generated>(argc)).size() +
+                            (parsed ? zbo::enumToIndex(*parsed) : 0));
+}}
+"""
+
+
+def compile_source(compiler, flags, source, output):
+    """Compiles source and returns the wall time in seconds, the peak memory in MB and whether it succeeded."""
+    start = time.monotonic()
+    pid = os.fork()
+    if pid == 0:
+        os.execvp(compiler, [compiler] + flags + ["-c", source, "-o", output])
+    _, status, usage = os.wait4(pid, 0)
+    elapsed = time.monotonic() - start
+    # ru_maxrss is in kilobytes on Linux
+    return elapsed, usage.ru_maxrss / 1024.0, os.WIFEXITED(status) and os.WEXITSTATUS(status) == 0
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__)
+    parser.add_argument("--compiler", default=os.environ.get("CXX", "c++"))
+    parser.add_argument("--include", default=os.path.join(os.path.dirname(os.path.abspath(__file__)), ".."),
+                        help="directory containing zbo/meta_enum.h")
+    parser.add_argument("--build-dir", help="directory for the generated sources, a temporary one by default")
+    parser.add_argument("--flags", default="-std=c++20 -O2", help="compiler flags")
+    parser.add_argument("sizes", nargs="*", type=int, default=DEFAULT_SIZES, help="number of enum members")
+    args = parser.parse_args()
+
+    build_dir = args.build_dir or tempfile.mkdtemp(prefix="meta_enum_compile_benchmark")
+    os.makedirs(build_dir, exist_ok=True)
+    flags = args.flags.split() + ["-I", args.include]
+
+    print(f"{'members':>8} {'time [s]':>10} {'peak memory [MB]':>17}")
+    failed = False
+    for size in args.sizes:
+        source = os.path.join(build_dir, f"enum_{size}.cpp")
+        with open(source, "w") as file:
+            file.write(generate_source(size))
+        elapsed, memory, success = compile_source(args.compiler, flags, source, source + ".o")
+        print(f"{size:>8} {elapsed:>10.2f} {memory:>17.1f}{'' if success else '  FAILED'}", flush=True)
+        failed = failed or not success
+    return 1 if failed else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,351 @@
+// MIT License
+//
+// Copyright (c) 2020 Lenzebo
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include "meta_enum.h"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <charconv>
+#include <iterator>
+#include <limits>
+#include <optional>
+#include <string_view>
+#include <system_error>
+#include <type_traits>
+
+namespace zbo {
+
+namespace meta_enum_internal {
+
+/// bitwise or of all members
+template <typename MetaEnumType>
+constexpr auto allFlags(const MetaEnumType& meta)
+{
+    std::make_unsigned_t<typename MetaEnumType::UnderlyingType> bits = 0;
+    for (const auto value : meta.values)
+    {
+        bits |= static_cast<decltype(bits)>(value);
+    }
+    return bits;
+}
+
+constexpr std::to_chars_result copyChars(char* first, char* last, std::string_view str) noexcept
+{
+    if (static_cast<size_t>(last - first) < str.size())
+    {
+        return {last, std::errc::value_too_large};
+    }
+    return {std::copy(str.begin(), str.end(), first), std::errc{}};
+}
+
+constexpr std::string_view trimSpaces(std::string_view str) noexcept
+{
+    while (!str.empty() && str.front() == ' ')
+    {
+        str.remove_prefix(1);
+    }
+    while (!str.empty() && str.back() == ' ')
+    {
+        str.remove_suffix(1);
+    }
+    return str;
+}
+
+/// parses the tokens flagsToChars uses for bits without member: "0" and hexadecimal numbers with 0x prefix
+template <typename Unsigned>
+constexpr std::optional<Unsigned> parseFlagsNumber(std::string_view str) noexcept
+{
+    constexpr unsigned HEX_BASE = 16;
+    constexpr int DECIMAL_DIGITS = 10;
+    if (str == "0")
+    {
+        return Unsigned{0};
+    }
+    if (str.size() < 3 || str.size() > 2 + 2 * sizeof(Unsigned) || str.substr(0, 2) != "0x")
+    {
+        return std::nullopt;
+    }
+    Unsigned bits = 0;
+    for (char c : str.substr(2))
+    {
+        const int digit = (c >= '0' && c <= '9') ? c - '0' : (c >= 'a' && c <= 'f') ? c - 'a' + DECIMAL_DIGITS : -1;
+        if (digit < 0)
+        {
+            return std::nullopt;
+        }
+        bits = static_cast<Unsigned>(bits * HEX_BASE + static_cast<unsigned>(digit));
+    }
+    return bits;
+}
+
+/// maps every bit position to the index of the member with exactly that bit or to meta.size() if there is none
+template <typename MetaEnumType>
+constexpr auto bitMembers(const MetaEnumType& meta)
+{
+    using Unsigned = std::make_unsigned_t<typename MetaEnumType::UnderlyingType>;
+    std::array<size_t, std::numeric_limits<Unsigned>::digits> members{};
+    members.fill(meta.size());
+    for (size_t i = meta.size(); i-- > 0;)
+    {
+        const auto bits = static_cast<Unsigned>(meta.values[i]);
+        if (std::has_single_bit(bits))
+        {
+            members[static_cast<size_t>(std::countr_zero(bits))] = i;
+        }
+    }
+    return members;
+}
+
+}  // namespace meta_enum_internal
+
+/// enums declared with ZBO_FLAGS_ENUM or ZBO_NESTED_FLAGS_ENUM
+template <typename E>
+concept FlagsEnum = std::is_enum_v<E> && requires
+{
+    isFlagsEnum(meta_enum_internal::Tag<E>());
+};
+
+/// bitwise or of all members of E
+template <FlagsEnum E>
+constexpr E allFlags()
+{
+    return static_cast<E>(meta_enum_internal::allFlags(metaEnum<E>()));
+}
+
+/// returns whether all bits of flags are set in value
+template <FlagsEnum E>
+constexpr bool hasFlags(E value, E flags)
+{
+    return (value & flags) == flags;
+}
+
+/// returns whether any bit of flags is set in value
+template <FlagsEnum E>
+constexpr bool hasAnyFlag(E value, E flags)
+{
+    return (value & flags) != E{};
+}
+
+/**
+ * @brief Range over the set bits of a flags value, from the lowest to the highest bit. Each element has exactly one
+ *        bit set, which is not necessarily a member of E.
+ *
+ * Usage:
+ *   for (Permission p : setFlags(permissions)) { ... }
+ */
+template <FlagsEnum E>
+class SetFlags
+{
+    using Unsigned = std::make_unsigned_t<std::underlying_type_t<E>>;
+
+  public:
+    class Iterator
+    {
+      public:
+        using value_type = E;                                 // NOLINT (readability-identifier-naming)
+        using difference_type = std::ptrdiff_t;               // NOLINT (readability-identifier-naming)
+        using iterator_category = std::forward_iterator_tag;  // NOLINT (readability-identifier-naming)
+
+        constexpr Iterator() = default;
+        constexpr explicit Iterator(Unsigned bits) : bits_(bits) {}
+
+        [[nodiscard]] constexpr E operator*() const
+        {
+            return static_cast<E>(static_cast<Unsigned>(Unsigned{1} << std::countr_zero(bits_)));
+        }
+        constexpr Iterator& operator++()
+        {
+            bits_ = static_cast<Unsigned>(bits_ & (bits_ - 1U));
+            return *this;
+        }
+        constexpr Iterator operator++(int)
+        {
+            Iterator it = *this;
+            ++(*this);
+            return it;
+        }
+        [[nodiscard]] constexpr bool operator==(const Iterator& other) const noexcept { return bits_ == other.bits_; }
+        [[nodiscard]] constexpr bool operator!=(const Iterator& other) const noexcept { return !((*this) == other); }
+
+      private:
+        Unsigned bits_ = 0;
+    };
+
+    constexpr explicit SetFlags(E value) : bits_(static_cast<Unsigned>(value)) {}
+
+    [[nodiscard]] constexpr Iterator begin() const noexcept { return Iterator(bits_); }
+    [[nodiscard]] constexpr Iterator end() const noexcept { return Iterator(0); }
+    [[nodiscard]] constexpr size_t size() const noexcept { return static_cast<size_t>(std::popcount(bits_)); }
+
+  private:
+    Unsigned bits_;
+};
+
+template <FlagsEnum E>
+constexpr SetFlags<E> setFlags(E value)
+{
+    return SetFlags<E>(value);
+}
+
+/**
+ * @brief Formats a flags value as "A|B|C" into [first, last) without allocating.
+ *
+ * Values that equal a member (including zero or combined members) are written as that member. Otherwise the single
+ * bit members are written from the lowest to the highest bit, remaining bits without member are appended as one
+ * hexadecimal number (e.g. "A|0x40") and zero without member is written as "0". stringToFlags parses all of them.
+ *
+ * @return same semantics as std::to_chars
+ */
+template <FlagsEnum E>
+std::to_chars_result flagsToChars(char* first, char* last, E value) noexcept
+{
+    using Unsigned = std::make_unsigned_t<std::underlying_type_t<E>>;
+    constexpr int HEX_BASE = 16;
+    constexpr auto BIT_MEMBERS = meta_enum_internal::bitMembers(metaEnum<E>());
+    const auto& meta = metaEnum<E>();
+
+    if (const size_t idx = enumToIndex(value); idx < meta.size())
+    {
+        return meta_enum_internal::copyChars(first, last, meta.names[idx]);
+    }
+    if (value == E{})
+    {
+        return meta_enum_internal::copyChars(first, last, "0");
+    }
+
+    Unsigned unknownBits = 0;
+    std::to_chars_result result{first, std::errc{}};
+    for (E flag : setFlags(value))
+    {
+        const size_t idx = BIT_MEMBERS[static_cast<size_t>(std::countr_zero(static_cast<Unsigned>(flag)))];
+        if (idx == meta.size())
+        {
+            unknownBits |= static_cast<Unsigned>(flag);
+            continue;
+        }
+        if (result.ptr != first)
+        {
+            result = meta_enum_internal::copyChars(result.ptr, last, "|");
+        }
+        if (result.ec == std::errc{})
+        {
+            result = meta_enum_internal::copyChars(result.ptr, last, meta.names[idx]);
+        }
+        if (result.ec != std::errc{})
+        {
+            return result;
+        }
+    }
+
+    if (unknownBits != 0)
+    {
+        result = meta_enum_internal::copyChars(result.ptr, last, result.ptr != first ? "|0x" : "0x");
+        if (result.ec == std::errc{})
+        {
+            result = std::to_chars(result.ptr, last, unknownBits, HEX_BASE);
+        }
+    }
+    return result;
+}
+
+/**
+ * @brief Parses flags formatted by flagsToChars, e.g. "A|B|C". Spaces around the separators are ignored and each
+ *        member name is resolved with stringToEnum.
+ * @return parsed value or empty if any part is neither a member name nor a number as written by flagsToChars
+ */
+template <FlagsEnum E>
+constexpr std::optional<E> stringToFlags(std::string_view str)
+{
+    using Unsigned = std::make_unsigned_t<std::underlying_type_t<E>>;
+
+    Unsigned bits = 0;
+    while (true)
+    {
+        const size_t separator = str.find('|');
+        const std::string_view token = meta_enum_internal::trimSpaces(str.substr(0, separator));
+        if (const auto flag = stringToEnum<E>(token))
+        {
+            bits |= static_cast<Unsigned>(*flag);
+        }
+        else if (const auto number = meta_enum_internal::parseFlagsNumber<Unsigned>(token))
+        {
+            bits |= *number;
+        }
+        else
+        {
+            return std::nullopt;
+        }
+
+        if (separator == std::string_view::npos)
+        {
+            return static_cast<E>(bits);
+        }
+        str.remove_prefix(separator + 1);
+    }
+}
+
+}  // namespace zbo
+
+// NOLINTNEXTLINE (cppcoreguidelines-macro-usage)
+#define ZBO_FLAGS_OPERATORS_IMPL(Type, Friend)                                                                   \
+    constexpr Friend Type operator|(Type lhs, Type rhs)                                                          \
+    {                                                                                                            \
+        using Unsigned = std::make_unsigned_t<std::underlying_type_t<Type>>;                                     \
+        return static_cast<Type>(static_cast<Unsigned>(lhs) | static_cast<Unsigned>(rhs));                       \
+    }                                                                                                            \
+    constexpr Friend Type operator&(Type lhs, Type rhs)                                                          \
+    {                                                                                                            \
+        using Unsigned = std::make_unsigned_t<std::underlying_type_t<Type>>;                                     \
+        return static_cast<Type>(static_cast<Unsigned>(lhs) & static_cast<Unsigned>(rhs));                       \
+    }                                                                                                            \
+    constexpr Friend Type operator^(Type lhs, Type rhs)                                                          \
+    {                                                                                                            \
+        using Unsigned = std::make_unsigned_t<std::underlying_type_t<Type>>;                                     \
+        return static_cast<Type>(static_cast<Unsigned>(lhs) ^ static_cast<Unsigned>(rhs));                       \
+    }                                                                                                            \
+    /* the complement only contains bits of members */                                                          \
+    constexpr Friend Type operator~(Type value)                                                                  \
+    {                                                                                                            \
+        using Unsigned = std::make_unsigned_t<std::underlying_type_t<Type>>;                                     \
+        const auto& meta = metaEnum(::zbo::meta_enum_internal::Tag<Type>());                                     \
+        const Unsigned complement = ~static_cast<Unsigned>(value);                                               \
+        return static_cast<Type>(complement & ::zbo::meta_enum_internal::allFlags(meta));                        \
+    }                                                                                                            \
+    constexpr Friend Type& operator|=(Type& lhs, Type rhs) { return lhs = lhs | rhs; }                           \
+    constexpr Friend Type& operator&=(Type& lhs, Type rhs) { return lhs = lhs & rhs; }                           \
+    constexpr Friend Type& operator^=(Type& lhs, Type rhs) { return lhs = lhs ^ rhs; }                           \
+    constexpr Friend bool isFlagsEnum(::zbo::meta_enum_internal::Tag<Type>) { return true; }
+
+/**
+ * Declares an enum class of bit flags with the same introspection as ZBO_ENUM_CLASS plus bitwise operators and support
+ * for setFlags, flagsToChars and stringToFlags. Members need literal initializers, e.g.
+ *   ZBO_FLAGS_ENUM(Permission, uint8_t, NONE = 0, READ = 1, WRITE = 2, EXECUTE = 4, READ_WRITE = 3)
+ */
+// NOLINTNEXTLINE (cppcoreguidelines-macro-usage)
+#define ZBO_FLAGS_ENUM(Type, UnderlyingType, ...) \
+    ZBO_ENUM_IMPL(Type, class, , UnderlyingType, __VA_ARGS__) ZBO_FLAGS_OPERATORS_IMPL(Type, )
+// NOLINTNEXTLINE (cppcoreguidelines-macro-usage)
+#define ZBO_NESTED_FLAGS_ENUM(Type, UnderlyingType, ...) \
+    ZBO_ENUM_IMPL(Type, class, friend, UnderlyingType, __VA_ARGS__) ZBO_FLAGS_OPERATORS_IMPL(Type, friend)
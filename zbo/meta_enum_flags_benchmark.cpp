@@ -0,0 +1,142 @@
+#include "meta_enum_flags.h"
+
+#include <benchmark/benchmark.h>
+
+#include <array>
+#include <random>
+#include <string>
+#include <vector>
+
+ZBO_FLAGS_ENUM(Style, uint32_t, NONE = 0, BOLD = 1, ITALIC = 2, UNDERLINE = 4, STRIKE = 8, BLINK = 0x10,
+               INVERSE = 0x20, HIDDEN = 0x40, DIM = 0x80, OVERLINE = 0x100, FRAMED = 0x200, ENCIRCLED = 0x400,
+               SUPERSCRIPT = 0x800, SUBSCRIPT = 0x1000, MONOSPACE = 0x2000, SERIF = 0x4000, SANS_SERIF = 0x8000)
+
+namespace zbo::bench {
+
+constexpr size_t NUM_VALUES = 1024;
+
+std::vector<Style> randomStyles()
+{
+    std::mt19937 gen{42};
+    std::uniform_int_distribution<uint32_t> dist{0, 0xFFFF};
+    std::vector<Style> values(NUM_VALUES);
+    for (auto& value : values)
+    {
+        value = static_cast<Style>(dist(gen));
+    }
+    return values;
+}
+
+/// straightforward formatting as it is often written by hand
+std::string naiveFormat(Style value)
+{
+    std::string result;
+    for (const auto member : metaEnum<Style>().values)
+    {
+        const auto bits = static_cast<uint32_t>(member);
+        if (bits != 0 && (static_cast<uint32_t>(value) & bits) == bits)
+        {
+            if (!result.empty())
+            {
+                result += "|";
+            }
+            result += std::string(zbo::enumToString(member));
+        }
+    }
+    return result;
+}
+
+/// straightforward parsing: split into strings and compare against every member name
+std::optional<Style> naiveParse(const std::string& str)
+{
+    uint32_t bits = 0;
+    size_t begin = 0;
+    while (begin <= str.size())
+    {
+        const size_t end = std::min(str.find('|', begin), str.size());
+        const std::string token = str.substr(begin, end - begin);
+        bool found = false;
+        for (const auto member : metaEnum<Style>().values)
+        {
+            if (std::string(zbo::enumToString(member)) == token)
+            {
+                bits |= static_cast<uint32_t>(member);
+                found = true;
+                break;
+            }
+        }
+        if (!found)
+        {
+            return std::nullopt;
+        }
+        begin = end + 1;
+    }
+    return static_cast<Style>(bits);
+}
+
+void naiveFormat(benchmark::State& state)
+{
+    const auto values = randomStyles();
+    size_t i = 0;
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(naiveFormat(values[i++ % values.size()]));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+void flagsToChars(benchmark::State& state)
+{
+    const auto values = randomStyles();
+    std::array<char, 256> buffer{};
+    size_t i = 0;
+    for (auto _ : state)
+    {
+        const Style value = values[i++ % values.size()];
+        const auto result = zbo::flagsToChars(buffer.data(), buffer.data() + buffer.size(), value);
+        benchmark::DoNotOptimize(result.ptr);
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+std::vector<std::string> formattedStyles()
+{
+    std::vector<std::string> strings;
+    for (const auto value : randomStyles())
+    {
+        strings.push_back(naiveFormat(value));
+    }
+    return strings;
+}
+
+void naiveParse(benchmark::State& state)
+{
+    const auto strings = formattedStyles();
+    size_t i = 0;
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(naiveParse(strings[i++ % strings.size()]));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+void stringToFlags(benchmark::State& state)
+{
+    const auto strings = formattedStyles();
+    size_t i = 0;
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(zbo::stringToFlags<Style>(strings[i++ % strings.size()]));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK(naiveFormat);
+BENCHMARK(flagsToChars);
+BENCHMARK(naiveParse);
+BENCHMARK(stringToFlags);
+
+}  // namespace zbo::bench
+
+BENCHMARK_MAIN();
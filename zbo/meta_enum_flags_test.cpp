@@ -0,0 +1,115 @@
+#include "meta_enum_flags.h"
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <string>
+#include <vector>
+
+namespace zbo::test {
+
+ZBO_FLAGS_ENUM(Permission, uint8_t, NONE = 0, READ = 1, WRITE = 2, EXECUTE = 4, READ_WRITE = 3, ADMIN = 0x80)
+ZBO_FLAGS_ENUM(Channel, uint32_t, LEFT = 1, RIGHT = 2, CENTER = 4, SURROUND = 0x80000000)
+
+struct Socket
+{
+    ZBO_NESTED_FLAGS_ENUM(Option, int, REUSE_ADDR = 1, NO_DELAY = 2, KEEP_ALIVE = 4);
+};
+
+static_assert(FlagsEnum<Permission>);
+static_assert(FlagsEnum<Socket::Option>);
+static_assert((Permission::READ | Permission::WRITE) == Permission::READ_WRITE);
+static_assert((Permission::READ_WRITE & Permission::WRITE) == Permission::WRITE);
+static_assert((Permission::READ_WRITE ^ Permission::WRITE) == Permission::READ);
+static_assert(~Permission::READ == (Permission::WRITE | Permission::EXECUTE | Permission::ADMIN));
+static_assert(allFlags<Channel>() == (Channel::LEFT | Channel::RIGHT | Channel::CENTER | Channel::SURROUND));
+static_assert(hasFlags(Permission::READ_WRITE, Permission::WRITE));
+static_assert(!hasFlags(Permission::READ, Permission::READ_WRITE));
+static_assert(hasAnyFlag(Permission::READ, Permission::READ_WRITE));
+static_assert(setFlags(Permission::READ_WRITE | Permission::ADMIN).size() == 3);
+static_assert(stringToFlags<Permission>("READ|EXECUTE") == (Permission::READ | Permission::EXECUTE));
+static_assert(!FlagsEnum<int>);
+
+template <typename E>
+std::string format(E value)
+{
+    std::array<char, 64> buffer{};
+    const auto result = flagsToChars(buffer.data(), buffer.data() + buffer.size(), value);
+    EXPECT_EQ(result.ec, std::errc{});
+    return std::string(buffer.data(), result.ptr);
+}
+
+TEST(FlagsEnum, CompoundAssignment)
+{
+    Socket::Option options = Socket::Option::REUSE_ADDR;
+    options |= Socket::Option::KEEP_ALIVE;
+    ASSERT_TRUE(hasFlags(options, Socket::Option::KEEP_ALIVE));
+    options &= ~Socket::Option::REUSE_ADDR;
+    ASSERT_EQ(options, Socket::Option::KEEP_ALIVE);
+    options ^= Socket::Option::NO_DELAY;
+    ASSERT_EQ(options, Socket::Option::KEEP_ALIVE | Socket::Option::NO_DELAY);
+}
+
+TEST(FlagsEnum, IterateSetBits)
+{
+    std::vector<Channel> channels;
+    for (Channel channel : setFlags(Channel::SURROUND | Channel::LEFT | Channel::CENTER))
+    {
+        channels.push_back(channel);
+    }
+    ASSERT_EQ(channels, (std::vector<Channel>{Channel::LEFT, Channel::CENTER, Channel::SURROUND}));
+    ASSERT_EQ(setFlags(Channel{}).begin(), setFlags(Channel{}).end());
+}
+
+TEST(FlagsEnum, Format)
+{
+    ASSERT_EQ(format(Permission::NONE), "NONE");
+    ASSERT_EQ(format(Permission::READ), "READ");
+    ASSERT_EQ(format(Permission::READ | Permission::WRITE), "READ_WRITE");
+    ASSERT_EQ(format(Permission::READ | Permission::EXECUTE | Permission::ADMIN), "READ|EXECUTE|ADMIN");
+    ASSERT_EQ(format(Permission::WRITE | static_cast<Permission>(0x60)), "WRITE|0x60");
+    ASSERT_EQ(format(static_cast<Permission>(0x10)), "0x10");
+    ASSERT_EQ(format(Channel{}), "0");
+    ASSERT_EQ(format(Channel::SURROUND | Channel::RIGHT), "RIGHT|SURROUND");
+    ASSERT_EQ(format(Socket::Option::REUSE_ADDR | Socket::Option::NO_DELAY), "REUSE_ADDR|NO_DELAY");
+}
+
+TEST(FlagsEnum, FormatBufferTooSmall)
+{
+    std::array<char, 8> buffer{};
+    const auto value = Permission::READ | Permission::EXECUTE;
+    ASSERT_EQ(flagsToChars(buffer.data(), buffer.data() + 4, value).ec, std::errc::value_too_large);
+    ASSERT_EQ(flagsToChars(buffer.data(), buffer.data() + 5, value).ec, std::errc::value_too_large);
+    ASSERT_EQ(flagsToChars(buffer.data(), buffer.data() + 7, value).ec, std::errc::value_too_large);
+    ASSERT_EQ(flagsToChars(buffer.data(), buffer.data() + 1, static_cast<Permission>(0x10)).ec,
+              std::errc::value_too_large);
+}
+
+TEST(FlagsEnum, Parse)
+{
+    ASSERT_EQ(stringToFlags<Permission>("READ"), Permission::READ);
+    ASSERT_EQ(stringToFlags<Permission>("READ | ADMIN"), Permission::READ | Permission::ADMIN);
+    ASSERT_EQ(stringToFlags<Permission>("READ_WRITE|EXECUTE"), ~Permission::ADMIN);
+    ASSERT_EQ(stringToFlags<Permission>("0"), Permission::NONE);
+    ASSERT_EQ(stringToFlags<Permission>("WRITE|0x60"), Permission::WRITE | static_cast<Permission>(0x60));
+
+    ASSERT_EQ(stringToFlags<Permission>(""), std::nullopt);
+    ASSERT_EQ(stringToFlags<Permission>("READ|"), std::nullopt);
+    ASSERT_EQ(stringToFlags<Permission>("READ||WRITE"), std::nullopt);
+    ASSERT_EQ(stringToFlags<Permission>("READ|write"), std::nullopt);
+    ASSERT_EQ(stringToFlags<Permission>("0x100"), std::nullopt);
+    ASSERT_EQ(stringToFlags<Permission>("0xg"), std::nullopt);
+}
+
+TEST(FlagsEnum, RoundTrip)
+{
+    for (unsigned bits = 0; bits < 256; ++bits)
+    {
+        const auto value = static_cast<Permission>(bits);
+        ASSERT_EQ(stringToFlags<Permission>(format(value)), value) << format(value);
+    }
+    const auto channels = Channel::SURROUND | Channel::CENTER | static_cast<Channel>(0x700);
+    ASSERT_EQ(stringToFlags<Channel>(format(channels)), channels);
+}
+
+}  // namespace zbo::test
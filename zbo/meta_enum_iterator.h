@@ -46,23 +46,23 @@ class MetaEnumIterator
     constexpr explicit MetaEnumIterator(EnumType value) noexcept(true) : enumIdx_(enumToIndex(value)) {}
     constexpr explicit MetaEnumIterator(size_t value) noexcept(true) : enumIdx_(value) {}
     ~MetaEnumIterator() noexcept(true) = default;
-    MetaEnumIterator& operator=(const MetaEnumIterator& rhs) noexcept(true)
+    constexpr MetaEnumIterator& operator=(const MetaEnumIterator& rhs) noexcept(true)
     {
         enumIdx_ = rhs.enumIdx_;
         return *this;
     }
-    MetaEnumIterator& operator++() noexcept(true)
+    constexpr MetaEnumIterator& operator++() noexcept(true)
     {
         enumIdx_++;
         return *this;
     }
-    MetaEnumIterator operator++(int) noexcept(true)
+    constexpr MetaEnumIterator operator++(int) noexcept(true)
     {
         MetaEnumIterator r(*this);
         ++*this;
         return r;
     }
-    MetaEnumIterator& operator+=(SizeType o) noexcept(true)
+    constexpr MetaEnumIterator& operator+=(SizeType o) noexcept(true)
     {
         enumIdx_ += o;
         return *this;
@@ -75,18 +75,18 @@ class MetaEnumIterator
     {
         return MetaEnumIterator(it.enumIdx_ + o);
     }
-    MetaEnumIterator& operator--() noexcept(true)
+    constexpr MetaEnumIterator& operator--() noexcept(true)
     {
         enumIdx_--;
         return *this;
     }
-    MetaEnumIterator operator--(int) noexcept(true)
+    constexpr MetaEnumIterator operator--(int) noexcept(true)
     {
         MetaEnumIterator r(*this);
         --*this;
         return r;
     }
-    MetaEnumIterator& operator-=(SizeType o) noexcept(true)
+    constexpr MetaEnumIterator& operator-=(SizeType o) noexcept(true)
     {
         enumIdx_ -= o;
         return *this;
@@ -99,15 +99,12 @@ class MetaEnumIterator
     {
         return DifferenceType(lhs.enumIdx_) - DifferenceType(rhs.enumIdx_);
     }
-    constexpr reference operator*() const noexcept(true) { return metaEnum<EnumType>().members.at(enumIdx_).value; }
+    constexpr reference operator*() const noexcept(true) { return metaEnum<EnumType>().values[enumIdx_]; }
     constexpr reference operator[](SizeType o) const noexcept(true)
     {
-        return metaEnum<EnumType>().members.at(enumIdx_ + o).value;
-    }
-    constexpr const EnumType* operator->() const noexcept(true)
-    {
-        return &metaEnum<EnumType>().members.at(enumIdx_).value;
+        return metaEnum<EnumType>().values[enumIdx_ + o];
     }
+    constexpr const EnumType* operator->() const noexcept(true) { return &metaEnum<EnumType>().values[enumIdx_]; }
     constexpr friend bool operator==(const MetaEnumIterator& lhs, const MetaEnumIterator& rhs) noexcept(true)
     {
         return lhs.enumIdx_ == rhs.enumIdx_;
@@ -147,8 +144,8 @@ class MetaEnumRange
     using iterator = MetaEnumIterator<T>;  // NOLINT(readability-identifier-naming)
 
   public:
-    iterator begin() { return iterator(0); };
-    iterator end() { return iterator(metaEnum<T>().size()); };
+    constexpr iterator begin() { return iterator(size_t{0}); };
+    constexpr iterator end() { return iterator(metaEnum<T>().size()); };
 };
 
 }  // namespace zbo
\ No newline at end of file
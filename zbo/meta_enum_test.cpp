@@ -3,6 +3,8 @@
 
 #include <gtest/gtest.h>
 
+#include <algorithm>
+
 ZBO_ENUM(MyTestEnum, int, ONE, TWO, THREE)
 
 namespace test_namespace {
@@ -36,7 +38,10 @@ TEST(EnumUtils, MetaEnum)
     ASSERT_EQ(m2.size(), 3);
     ASSERT_EQ(m3.size(), 4);
 
-    ASSERT_EQ(m.members[1].value, TWO);
+    ASSERT_EQ(m.values[1], TWO);
+    ASSERT_EQ(m.member(1).name, "TWO");
+    ASSERT_EQ(m.member(1).index, 1);
+    ASSERT_EQ(m3.member(3).string, " FOUR = 5");
 }
 
 TEST(EnumUtils, Iteration)
@@ -94,4 +99,155 @@ ZBO_ENUM_CLASS(EnumWithCommnets, int,
 TEST(EnumUtils, EnumWithComments)
 {
     ASSERT_EQ(zbo::enumToString(EnumWithCommnets::ONE), "ONE");
-}
\ No newline at end of file
+}
+
+ZBO_ENUM_CLASS(EnumWithInitializers, int, SHIFTED = 1 << 4, NEXT, NESTED = (2 + 3) * (1 >> 0),
+               QUOTED = sizeof("a,b"), LAST)
+
+TEST(EnumUtils, EnumWithInitializers)
+{
+    const auto& m = zbo::metaEnum<EnumWithInitializers>();
+    ASSERT_EQ(m.size(), 5);
+    ASSERT_EQ(m.names, (std::array<std::string_view, 5>{"SHIFTED", "NEXT", "NESTED", "QUOTED", "LAST"}));
+    ASSERT_EQ(m.strings[3], " QUOTED = sizeof(\"a,b\")");
+    ASSERT_EQ(static_cast<int>(m.values[1]), 17);
+    ASSERT_EQ(static_cast<int>(m.values[2]), 5);
+    ASSERT_EQ(static_cast<int>(m.values[4]), 5);
+}
+// members may be named like the helpers in ZBO_ENUM_IMPL
+ZBO_ENUM_CLASS(Field, int, names, values, other = 5)
+
+TEST(EnumUtils, MembersNamedLikeInternals)
+{
+    const auto& m = zbo::metaEnum<Field>();
+    ASSERT_EQ(m.names, (std::array<std::string_view, 3>{"names", "values", "other"}));
+    ASSERT_EQ(zbo::enumToString(Field::values), "values");
+    ASSERT_EQ(zbo::stringToEnum<Field>("values"), Field::values);
+    ASSERT_EQ(static_cast<int>(m.values[2]), 5);
+}
+
+ZBO_ENUM_CLASS(Color, uint16_t, RED, GREEN, BLUE, CYAN, MAGENTA, YELLOW, BLACK, WHITE, GRAY, ORANGE, PURPLE, BROWN,
+               PINK, OLIVE, NAVY, TEAL, MAROON, LIME, AQUA, SILVER, GOLD, BEIGE, IVORY, CORAL, SALMON, KHAKI, VIOLET,
+               INDIGO, TURQUOISE, LAVENDER, CRIMSON, AZURE, R, RE, RED_2, DER)
+
+template <typename E>
+void expectAllNamesParse()
+{
+    const auto& m = zbo::metaEnum<E>();
+    for (size_t i = 0; i < m.size(); ++i)
+    {
+        ASSERT_EQ(zbo::stringToEnum<E>(m.names[i]), m.values[i]) << m.names[i];
+        ASSERT_EQ(zbo::stringToEnumCaseInsensitive<E>(m.names[i]), m.values[i]) << m.names[i];
+    }
+}
+
+TEST(EnumUtils, StringToEnumAllMembers)
+{
+    expectAllNamesParse<MyTestEnum>();
+    expectAllNamesParse<test_namespace::MyTestEnum>();
+    expectAllNamesParse<Nester::Nested>();
+    expectAllNamesParse<EnumWithCommnets>();
+    expectAllNamesParse<Color>();
+}
+
+TEST(EnumUtils, StringToEnumUnknown)
+{
+    ASSERT_EQ(zbo::stringToEnum<Color>(""), std::nullopt);
+    ASSERT_EQ(zbo::stringToEnum<Color>("REDD"), std::nullopt);
+    ASSERT_EQ(zbo::stringToEnum<Color>("Red"), std::nullopt);
+    ASSERT_EQ(zbo::stringToEnum<Color>("RED "), std::nullopt);
+    ASSERT_EQ(zbo::stringToEnum<Nester::Nested>("FIVE"), std::nullopt);
+    ASSERT_EQ(zbo::stringToEnum<Nester::Nested>("FIVE", Nester::Nested::ONE), Nester::Nested::ONE);
+}
+
+TEST(EnumUtils, StringToEnumCaseInsensitive)
+{
+    ASSERT_EQ(zbo::stringToEnumCaseInsensitive<Color>("red"), Color::RED);
+    ASSERT_EQ(zbo::stringToEnumCaseInsensitive<Color>("Red_2"), Color::RED_2);
+    ASSERT_EQ(zbo::stringToEnumCaseInsensitive<Color>("tUrQuOiSe"), Color::TURQUOISE);
+    ASSERT_EQ(zbo::stringToEnumCaseInsensitive<Color>("re"), Color::RE);
+    ASSERT_EQ(zbo::stringToEnumCaseInsensitive<Color>("reds"), std::nullopt);
+    ASSERT_EQ(zbo::stringToEnumCaseInsensitive<Nester::Nested>("four"), Nester::Nested::FOUR);
+}
+
+ZBO_ENUM_CLASS(Sparse, int, NEGATIVE = -70000, A = 100, B = 2000, C, ALIAS_B = 2000, BIG = 1 << 30, D = 5)
+ZBO_ENUM_CLASS(LargeSparse, int64_t, S0 = -1'000'000'000'000, S1 = -5000, S2 = 0, S3 = 1000, S4, S5 = 3000, S6 = 4000,
+               S7 = 5000, S8 = 6000, S9 = 7000, S10 = 8000, S11 = 9000, S12 = 10000, S13 = 11000, S14 = 12000,
+               S15 = 13000, S16 = 14000, S17 = 15000, S18 = 16000, S19 = 1'000'000'000'000, ALIAS_S10 = 8000)
+ZBO_ENUM_CLASS(Dense, int8_t, MINUS_TWO = -2, MINUS_ONE, ZERO, ONE, ALIAS_ZERO = 0, FIVE = 5)
+
+template <typename E>
+void expectAllValuesMap()
+{
+    const auto& m = zbo::metaEnum<E>();
+    for (size_t i = 0; i < m.size(); ++i)
+    {
+        const auto first = std::find(m.values.begin(), m.values.end(), m.values[i]);
+        const auto firstIndex = static_cast<size_t>(first - m.values.begin());
+        ASSERT_EQ(zbo::enumToIndex(m.values[i]), firstIndex);
+        ASSERT_EQ(zbo::enumToString(m.values[i]), m.names[firstIndex]);
+    }
+}
+
+TEST(EnumUtils, EnumToIndexAllMembers)
+{
+    expectAllValuesMap<MyTestEnum>();
+    expectAllValuesMap<Nester::Nested>();
+    expectAllValuesMap<Color>();
+    expectAllValuesMap<Sparse>();
+    expectAllValuesMap<LargeSparse>();
+    expectAllValuesMap<Dense>();
+}
+
+TEST(EnumUtils, EnumToIndexSparse)
+{
+    ASSERT_EQ(zbo::enumToIndex(Sparse::NEGATIVE), 0);
+    ASSERT_EQ(zbo::enumToIndex(Sparse::C), 3);
+    ASSERT_EQ(zbo::enumToIndex(Sparse::ALIAS_B), 2);
+    ASSERT_EQ(zbo::enumToString(Sparse::ALIAS_B), "B");
+    ASSERT_EQ(zbo::enumToString(Sparse::BIG), "BIG");
+    ASSERT_EQ(zbo::enumToIndex(static_cast<Sparse>(101)), 7);
+    ASSERT_EQ(zbo::enumToIndex(static_cast<Sparse>(-70001)), 7);
+    ASSERT_EQ(zbo::enumToIndex(static_cast<Sparse>((1 << 30) + 1)), 7);
+    ASSERT_EQ(zbo::enumToString(static_cast<Sparse>(6)), "__INVALID_ENUM_VAL__");
+
+    ASSERT_EQ(zbo::enumToIndex(LargeSparse::ALIAS_S10), 10);
+    for (int64_t value : std::initializer_list<int64_t>{-1'000'000'000'001, -4999, 1, 1002, 16001, 1'000'000'000'001})
+    {
+        ASSERT_EQ(zbo::enumToIndex(static_cast<LargeSparse>(value)), 21) << value;
+    }
+}
+
+TEST(EnumUtils, EnumToIndexDense)
+{
+    ASSERT_EQ(zbo::enumToIndex(Dense::MINUS_TWO), 0);
+    ASSERT_EQ(zbo::enumToIndex(Dense::ALIAS_ZERO), 2);
+    ASSERT_EQ(zbo::enumToIndex(Dense::FIVE), 5);
+    ASSERT_EQ(zbo::enumToIndex(static_cast<Dense>(4)), 6);
+    ASSERT_EQ(zbo::enumToIndex(static_cast<Dense>(-128)), 6);
+    ASSERT_EQ(zbo::enumToIndex(static_cast<Dense>(127)), 6);
+    ASSERT_EQ(zbo::enumToString(static_cast<Dense>(-3)), "__INVALID_ENUM_VAL__");
+    ASSERT_EQ(zbo::enumToString(Dense::MINUS_ONE), "MINUS_ONE");
+}
+
+constexpr size_t countMembers()
+{
+    size_t count = 0;
+    for ([[maybe_unused]] auto e : zbo::MetaEnumRange<Nester::Nested>())
+    {
+        ++count;
+    }
+    return count;
+}
+
+static_assert(zbo::metaEnum<MyTestEnum>().size() == 3);
+static_assert(zbo::metaEnum<Nester::Nested>().values[1] == Nester::Nested::ONE);
+static_assert(zbo::metaEnum<Nester::Nested>().names[3] == "FOUR");
+static_assert(zbo::enumToString(Sparse::B) == "B");
+static_assert(zbo::enumToIndex(Dense::FIVE) == 5);
+static_assert(zbo::stringToEnum<Color>("TEAL") == Color::TEAL);
+static_assert(zbo::stringToEnumCaseInsensitive<Color>("teal") == Color::TEAL);
+static_assert(!zbo::stringToEnum<Color>("TEA").has_value());
+static_assert(*zbo::MetaEnumIterator<MyTestEnum>(MyTestEnum::TWO) == MyTestEnum::TWO);
+static_assert(countMembers() == 4);
+static_assert(sizeof(zbo::metaEnum<Nester::Nested>().values) == 4, "Values of an enum are stored densely");
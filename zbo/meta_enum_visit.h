@@ -0,0 +1,123 @@
+// MIT License
+//
+// Copyright (c) 2020 Lenzebo
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include "contracts.h"
+#include "meta_enum.h"
+
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+namespace zbo {
+
+namespace detail {
+/// storage for the result of visitEnum, which is only set within the branch of the visited member
+template <typename Result>
+struct VisitResult
+{
+    template <typename F>
+    constexpr void set(F&& f)
+    {
+        value.emplace(f());
+    }
+    constexpr Result get() { return std::move(*value); }
+
+    std::optional<Result> value;
+};
+
+template <typename Result>
+struct VisitResult<Result&>
+{
+    template <typename F>
+    constexpr void set(F&& f)
+    {
+        value = &f();
+    }
+    constexpr Result& get() { return *value; }
+
+    Result* value = nullptr;
+};
+
+template <typename E, size_t index>
+using MemberConstant = std::integral_constant<E, metaEnum<E>().values[index]>;
+}  // namespace detail
+
+/**
+ * @brief Calls f(std::integral_constant<E, e>{}) for every member e of E in declaration order. The loop is unrolled at
+ *        compile time, so f can use the member as template argument or in if constexpr.
+ *
+ * Usage:
+ *   forEachEnum<Color>([&](auto color) { registerKernel(color.value, &kernel<color.value>); });
+ */
+template <typename E, typename F>
+constexpr void forEachEnum(F&& f)
+{
+    [&f]<size_t... index>(std::index_sequence<index...>)
+    {
+        (f(detail::MemberConstant<E, index>{}), ...);
+    }
+    (std::make_index_sequence<metaEnum<E>().size()>{});
+}
+
+/**
+ * @brief Turns the runtime value into a compile time constant: calls f(std::integral_constant<E, value>{}) and returns
+ *        its result. This replaces hand written switch statements over all members, which get out of sync with the
+ *        enum.
+ *
+ * The member is resolved to its index, which is compared against all indices in one flat condition chain that the
+ * compiler turns into a jump table with each call of f inlined into its case. All instantiations of f need to return
+ * the same type. value must be a member of E.
+ *
+ * Usage:
+ *   const double result = visitEnum(op, [&](auto op) { return apply<op.value>(lhs, rhs); });
+ */
+template <typename E, typename F>
+constexpr decltype(auto) visitEnum(E value, F&& f)
+{
+    using Result = decltype(f(detail::MemberConstant<E, 0>{}));
+
+    const size_t idx = enumToIndex(value);
+    ZBO_PRECONDITION(idx < metaEnum<E>().size())
+
+    return [&f, idx]<size_t... index>(std::index_sequence<index...>) -> Result
+    {
+        static_assert((std::is_same_v<Result, decltype(f(detail::MemberConstant<E, index>{}))> && ...),
+                      "f must return the same type for all members");
+        if constexpr (std::is_void_v<Result>)
+        {
+            (void)((idx == index && (f(detail::MemberConstant<E, index>{}), true)) || ...);
+        }
+        else
+        {
+            detail::VisitResult<Result> result;
+            (void)((idx == index &&
+                    (result.set([&f]() -> Result { return f(detail::MemberConstant<E, index>{}); }), true)) ||
+                   ...);
+            return result.get();
+        }
+    }
+    (std::make_index_sequence<metaEnum<E>().size()>{});
+}
+
+}  // namespace zbo
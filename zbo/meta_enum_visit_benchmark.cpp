@@ -0,0 +1,144 @@
+#include "meta_enum_visit.h"
+
+#include <benchmark/benchmark.h>
+
+#include <array>
+#include <functional>
+#include <memory>
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+ZBO_ENUM_CLASS(Op, uint8_t, ADD, SUB, MUL, MIN, MAX, AND, OR, XOR, SHL, SHR, NEG, ABS, INC, DEC, SQR, AVG)
+
+namespace zbo::bench {
+
+constexpr size_t NUM_OPS = 4096;
+
+template <Op op>
+int64_t apply(int64_t lhs, int64_t rhs)
+{
+    // clang-format off
+    if constexpr (op == Op::ADD) { return lhs + rhs; }
+    else if constexpr (op == Op::SUB) { return lhs - rhs; }
+    else if constexpr (op == Op::MUL) { return lhs * rhs; }
+    else if constexpr (op == Op::MIN) { return std::min(lhs, rhs); }
+    else if constexpr (op == Op::MAX) { return std::max(lhs, rhs); }
+    else if constexpr (op == Op::AND) { return lhs & rhs; }
+    else if constexpr (op == Op::OR) { return lhs | rhs; }
+    else if constexpr (op == Op::XOR) { return lhs ^ rhs; }
+    else if constexpr (op == Op::SHL) { return lhs << (rhs & 7); }
+    else if constexpr (op == Op::SHR) { return lhs >> (rhs & 7); }
+    else if constexpr (op == Op::NEG) { return -lhs; }
+    else if constexpr (op == Op::ABS) { return lhs < 0 ? -lhs : lhs; }
+    else if constexpr (op == Op::INC) { return lhs + 1; }
+    else if constexpr (op == Op::DEC) { return lhs - 1; }
+    else if constexpr (op == Op::SQR) { return lhs * lhs; }
+    else { return (lhs + rhs) / 2; }
+    // clang-format on
+}
+
+std::vector<Op> randomOps()
+{
+    std::mt19937 gen{42};
+    std::uniform_int_distribution<size_t> dist{0, metaEnum<Op>().size() - 1};
+    std::vector<Op> ops(NUM_OPS);
+    for (auto& op : ops)
+    {
+        op = metaEnum<Op>().values.at(dist(gen));
+    }
+    return ops;
+}
+
+template <typename Apply>
+void run(benchmark::State& state, Apply applyOp)
+{
+    const auto ops = randomOps();
+    for (auto _ : state)
+    {
+        int64_t acc = 1;
+        for (const auto op : ops)
+        {
+            acc = applyOp(op, acc, 3) & 0xFFFF;
+        }
+        benchmark::DoNotOptimize(acc);
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(ops.size()));
+}
+
+void visitEnumDispatch(benchmark::State& state)
+{
+    run(state, [](Op op, int64_t lhs, int64_t rhs) {
+        return visitEnum(op, [&](auto constant) { return apply<constant.value>(lhs, rhs); });
+    });
+}
+
+void handWrittenSwitch(benchmark::State& state)
+{
+    run(state, [](Op op, int64_t lhs, int64_t rhs) {
+        switch (op)
+        {
+            // clang-format off
+            case Op::ADD: return apply<Op::ADD>(lhs, rhs);
+            case Op::SUB: return apply<Op::SUB>(lhs, rhs);
+            case Op::MUL: return apply<Op::MUL>(lhs, rhs);
+            case Op::MIN: return apply<Op::MIN>(lhs, rhs);
+            case Op::MAX: return apply<Op::MAX>(lhs, rhs);
+            case Op::AND: return apply<Op::AND>(lhs, rhs);
+            case Op::OR: return apply<Op::OR>(lhs, rhs);
+            case Op::XOR: return apply<Op::XOR>(lhs, rhs);
+            case Op::SHL: return apply<Op::SHL>(lhs, rhs);
+            case Op::SHR: return apply<Op::SHR>(lhs, rhs);
+            case Op::NEG: return apply<Op::NEG>(lhs, rhs);
+            case Op::ABS: return apply<Op::ABS>(lhs, rhs);
+            case Op::INC: return apply<Op::INC>(lhs, rhs);
+            case Op::DEC: return apply<Op::DEC>(lhs, rhs);
+            case Op::SQR: return apply<Op::SQR>(lhs, rhs);
+            case Op::AVG: return apply<Op::AVG>(lhs, rhs);
+            // clang-format on
+        }
+        return lhs;
+    });
+}
+
+class Kernel
+{
+  public:
+    Kernel() = default;
+    Kernel(const Kernel&) = delete;
+    Kernel(Kernel&&) = delete;
+    Kernel& operator=(const Kernel&) = delete;
+    Kernel& operator=(Kernel&&) = delete;
+    virtual ~Kernel() = default;
+    [[nodiscard]] virtual int64_t apply(int64_t lhs, int64_t rhs) const = 0;
+};
+
+template <Op op>
+class KernelImpl final : public Kernel
+{
+  public:
+    [[nodiscard]] int64_t apply(int64_t lhs, int64_t rhs) const override { return bench::apply<op>(lhs, rhs); }
+};
+
+void virtualCallTable(benchmark::State& state)
+{
+    std::array<std::unique_ptr<Kernel>, metaEnum<Op>().size()> kernels;
+    forEachEnum<Op>([&](auto op) { kernels[enumToIndex(op.value)] = std::make_unique<KernelImpl<op.value>>(); });
+    run(state, [&](Op op, int64_t lhs, int64_t rhs) { return kernels[enumToIndex(op)]->apply(lhs, rhs); });
+}
+
+void stdFunctionMap(benchmark::State& state)
+{
+    std::unordered_map<Op, std::function<int64_t(int64_t, int64_t)>> kernels;
+    forEachEnum<Op>([&](auto op) { kernels[op.value] = &apply<op.value>; });
+    run(state, [&](Op op, int64_t lhs, int64_t rhs) { return kernels.find(op)->second(lhs, rhs); });
+}
+
+BENCHMARK(visitEnumDispatch);
+BENCHMARK(handWrittenSwitch);
+BENCHMARK(virtualCallTable);
+BENCHMARK(stdFunctionMap);
+
+}  // namespace zbo::bench
+
+BENCHMARK_MAIN();
@@ -0,0 +1,88 @@
+#include "meta_enum_visit.h"
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace zbo::test {
+
+ZBO_ENUM_CLASS(Op, int, ADD = 10, SUB = 20, MUL = 5, ALIAS_ADD = 10, NEG = -1)
+
+template <Op op>
+constexpr int apply(int lhs, int rhs)
+{
+    if constexpr (op == Op::ADD)
+    {
+        return lhs + rhs;
+    }
+    else if constexpr (op == Op::SUB)
+    {
+        return lhs - rhs;
+    }
+    else if constexpr (op == Op::MUL)
+    {
+        return lhs * rhs;
+    }
+    else
+    {
+        return -lhs;
+    }
+}
+
+constexpr int applyAll(int lhs, int rhs)
+{
+    int sum = 0;
+    forEachEnum<Op>([&](auto op) { sum += apply<op.value>(lhs, rhs); });
+    return sum;
+}
+
+static_assert(applyAll(3, 2) == 5 + 1 + 6 + 5 - 3);
+static_assert(visitEnum(Op::MUL, [](auto op) { return apply<op.value>(3, 2); }) == 6);
+
+TEST(ForEachEnum, VisitsAllMembersInOrder)
+{
+    std::vector<Op> visited;
+    forEachEnum<Op>([&](auto op) {
+        static_assert(std::is_same_v<typename decltype(op)::value_type, Op>);
+        visited.push_back(op.value);
+    });
+    ASSERT_EQ(visited, (std::vector<Op>{Op::ADD, Op::SUB, Op::MUL, Op::ALIAS_ADD, Op::NEG}));
+}
+
+TEST(VisitEnum, DispatchesToCompileTimeConstant)
+{
+    for (Op op : {Op::ADD, Op::SUB, Op::MUL, Op::NEG})
+    {
+        const int result = visitEnum(op, [](auto constant) { return apply<constant.value>(7, 3); });
+        const int expected = op == Op::ADD ? 10 : op == Op::SUB ? 4 : op == Op::MUL ? 21 : -7;
+        ASSERT_EQ(result, expected);
+    }
+    ASSERT_EQ(visitEnum(Op::ALIAS_ADD, [](auto op) { return apply<op.value>(7, 3); }), 10);
+}
+
+TEST(VisitEnum, VoidAndReferenceResults)
+{
+    std::vector<std::string> names;
+    visitEnum(Op::SUB, [&](auto op) { names.emplace_back(zbo::enumToString(op.value)); });
+    ASSERT_EQ(names, std::vector<std::string>{"SUB"});
+
+    std::array<int, 3> slots{};
+    visitEnum(Op::MUL, [&](auto op) -> int& { return slots[zbo::enumToIndex(op.value)]; }) = 42;
+    ASSERT_EQ(slots[2], 42);
+}
+
+TEST(VisitEnum, MoveOnlyResult)
+{
+    auto ptr = visitEnum(Op::NEG, [](auto op) { return std::make_unique<int>(static_cast<int>(op.value)); });
+    ASSERT_EQ(*ptr, -1);
+}
+
+TEST(VisitEnum, InvalidValueDeath)
+{
+    ASSERT_DEATH(visitEnum(static_cast<Op>(3), [](auto) {}), "");
+}
+
+}  // namespace zbo::test
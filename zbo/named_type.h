@@ -21,7 +21,10 @@
 // SOFTWARE.
 
 #pragma once
+#include <compare>
+#include <functional>
 #include <iosfwd>
+#include <type_traits>
 #include <utility>
 
 namespace zbo {
@@ -38,6 +41,8 @@ namespace zbo {
  *  - Multiplication<> defines *, *-
  *  - Division<> defines /, /-
  *  - Arithmetic: Addition+Subtraction+Multiplication+Division
+ *  - ThreeWayComparable<>: defines operator<=> and operator== (use instead of Comparable)
+ *  - Hashable<>: specializes std::hash to allow usage as key in unordered containers
  *
  * Usage:
  *  struct MyType : public NamedType<int, MyType>, Comparable<MyType> {
@@ -54,7 +59,18 @@ class NamedType
 {
   public:
     NamedType() = default;
-    explicit constexpr NamedType(T value) : value_(value){};
+    explicit constexpr NamedType(const T& value) noexcept(std::is_nothrow_copy_constructible_v<T>) : value_(value) {}
+    explicit constexpr NamedType(T&& value) noexcept(std::is_nothrow_move_constructible_v<T>)
+        : value_(std::move(value))
+    {
+    }
+    /// constructs the underlying value in place, e.g. NamedType<std::string, Tag>(std::in_place, 10, 'x')
+    template <typename... Args>
+    explicit constexpr NamedType(std::in_place_t /*tag*/,
+                                 Args&&... args) noexcept(std::is_nothrow_constructible_v<T, Args&&...>)
+        : value_(std::forward<Args>(args)...)
+    {
+    }
     [[nodiscard]] explicit constexpr operator const T&() const { return value_; }
     [[nodiscard]] explicit constexpr operator T&() { return value_; }
 
@@ -65,6 +81,13 @@ class NamedType
     T value_;
 };
 
+// NamedType shall not add any overhead, i.e. for trivial types it stays trivial, so e.g. std::vector<NamedType<...>>
+// relocates with memcpy and NamedTypes are passed in registers
+static_assert(std::is_trivially_copyable_v<NamedType<double, struct TrivialityCheckTag>>);
+static_assert(std::is_trivially_default_constructible_v<NamedType<double, struct TrivialityCheckTag>>);
+static_assert(std::is_standard_layout_v<NamedType<double, struct TrivialityCheckTag>>);
+static_assert(sizeof(NamedType<double, struct TrivialityCheckTag>) == sizeof(double));
+
 namespace detail {
 template <typename T, typename Tag>
 T getUnderlyingType(NamedType<T, Tag>);
@@ -74,6 +97,21 @@ T getUnderlyingType(NamedType<T, Tag>);
 template <typename NamedTypeT>
 using UnderlyingType = decltype(detail::getUnderlyingType(std::declval<NamedTypeT>()));
 
+/**
+ * @brief Checks whether a NamedType has the same object representation as its underlying type, which allows viewing
+ *        contiguous memory of NamedTypes as contiguous memory of the underlying type (@see named_type_span.h)
+ *
+ * This holds for NamedType itself and for types deriving from it together with any of the behaviors below, as those
+ * are empty base classes
+ */
+template <typename NamedTypeT>
+[[nodiscard]] constexpr bool isLayoutCompatible()
+{
+    using T = UnderlyingType<NamedTypeT>;
+    return std::is_standard_layout_v<NamedTypeT> && sizeof(NamedTypeT) == sizeof(T) &&
+           alignof(NamedTypeT) == alignof(T);
+}
+
 /// Adds addition to a NamedType (or anything that has a .get() function)
 template <typename NamedTypeT>
 struct Addition
@@ -194,6 +232,26 @@ struct Comparable : public EqualityComparable<NamedTypeT>
     }
 };
 
+/// Adds operator<=> and operator== to a NamedType (or anything that has a .get() function)
+template <typename NamedTypeT>
+struct ThreeWayComparable
+{
+    [[nodiscard]] friend constexpr auto operator<=>(const NamedTypeT& lhs, const NamedTypeT& rhs)
+    {
+        return lhs.get() <=> rhs.get();
+    }
+    [[nodiscard]] friend constexpr bool operator==(const NamedTypeT& lhs, const NamedTypeT& rhs)
+    {
+        return lhs.get() == rhs.get();
+    }
+};
+
+/// Marks a NamedType to be hashable with std::hash by hashing its underlying value (see specialization below)
+template <typename NamedTypeT>
+struct Hashable
+{
+};
+
 /// Allows the NamedType to be streamed to std::ostream
 template <typename NamedTypeT>
 struct Streamable
@@ -201,4 +259,17 @@ struct Streamable
     friend std::ostream& operator<<(std::ostream& stream, const NamedTypeT& type) { return stream << type.get(); }
 };
 
-}  // namespace zbo
\ No newline at end of file
+}  // namespace zbo
+
+namespace std {
+template <typename NamedTypeT>
+requires std::is_base_of_v<zbo::Hashable<NamedTypeT>, NamedTypeT>
+struct hash<NamedTypeT>
+{
+    [[nodiscard]] size_t operator()(const NamedTypeT& value) const
+        noexcept(noexcept(std::hash<zbo::UnderlyingType<NamedTypeT>>{}(value.get())))
+    {
+        return std::hash<zbo::UnderlyingType<NamedTypeT>>{}(value.get());
+    }
+};
+}  // namespace std
@@ -0,0 +1,95 @@
+#include "named_type.h"
+
+#include <benchmark/benchmark.h>
+
+#include <string>
+#include <vector>
+
+namespace zbo::bench {
+
+/// NamedType as it was before taking its value by value and copying it into the member
+template <typename T, typename Tag>
+class CopyingNamedType
+{
+  public:
+    CopyingNamedType() = default;
+    explicit CopyingNamedType(T value) : value_(value) {}
+    [[nodiscard]] const T& get() const { return value_; }
+
+  private:
+    T value_;
+};
+
+constexpr size_t STRING_LENGTH = 64;  // exceed the small string buffer to make copies allocate
+constexpr size_t VECTOR_LENGTH = 16;
+constexpr int64_t MIN_SIZE = 1 << 6;
+constexpr int64_t MAX_SIZE = 1 << 16;
+constexpr int MULTIPLIER = 8;
+
+struct StringFactory
+{
+    static std::string make() { return std::string(STRING_LENGTH, 'x'); }
+};
+
+struct VectorFactory
+{
+    static std::vector<double> make() { return std::vector<double>(VECTOR_LENGTH, 1.0); }
+};
+
+template <typename Factory>
+void rawGrowth(benchmark::State& state)
+{
+    for (auto _ : state)
+    {
+        std::vector<decltype(Factory::make())> vector;
+        for (int64_t i = 0; i < state.range(0); ++i)
+        {
+            vector.push_back(Factory::make());
+        }
+        benchmark::DoNotOptimize(vector.data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template <typename Factory>
+void copyingNamedTypeGrowth(benchmark::State& state)
+{
+    using Type = CopyingNamedType<decltype(Factory::make()), struct Tag>;
+    for (auto _ : state)
+    {
+        std::vector<Type> vector;
+        for (int64_t i = 0; i < state.range(0); ++i)
+        {
+            vector.push_back(Type{Factory::make()});
+        }
+        benchmark::DoNotOptimize(vector.data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template <typename Factory>
+void namedTypeGrowth(benchmark::State& state)
+{
+    using Type = NamedType<decltype(Factory::make()), struct Tag>;
+    for (auto _ : state)
+    {
+        std::vector<Type> vector;
+        for (int64_t i = 0; i < state.range(0); ++i)
+        {
+            vector.push_back(Type{Factory::make()});
+        }
+        benchmark::DoNotOptimize(vector.data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK_TEMPLATE(rawGrowth, StringFactory)->RangeMultiplier(MULTIPLIER)->Range(MIN_SIZE, MAX_SIZE);
+BENCHMARK_TEMPLATE(copyingNamedTypeGrowth, StringFactory)->RangeMultiplier(MULTIPLIER)->Range(MIN_SIZE, MAX_SIZE);
+BENCHMARK_TEMPLATE(namedTypeGrowth, StringFactory)->RangeMultiplier(MULTIPLIER)->Range(MIN_SIZE, MAX_SIZE);
+BENCHMARK_TEMPLATE(rawGrowth, VectorFactory)->RangeMultiplier(MULTIPLIER)->Range(MIN_SIZE, MAX_SIZE);
+BENCHMARK_TEMPLATE(copyingNamedTypeGrowth, VectorFactory)->RangeMultiplier(MULTIPLIER)->Range(MIN_SIZE, MAX_SIZE);
+BENCHMARK_TEMPLATE(namedTypeGrowth, VectorFactory)->RangeMultiplier(MULTIPLIER)->Range(MIN_SIZE, MAX_SIZE);
+
+}  // namespace zbo::bench
+
+BENCHMARK_MAIN();
@@ -0,0 +1,240 @@
+// MIT License
+//
+// Copyright (c) 2020 Lenzebo
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include "contracts.h"
+#include "named_type.h"
+
+#include <array>
+#include <ranges>
+#include <span>
+#include <type_traits>
+
+namespace zbo {
+
+namespace detail {
+template <typename NamedTypeT>
+using ConstPreservingUnderlyingType = std::conditional_t<std::is_const_v<NamedTypeT>,
+                                                         const UnderlyingType<std::remove_const_t<NamedTypeT>>,
+                                                         UnderlyingType<std::remove_const_t<NamedTypeT>>>;
+}  // namespace detail
+
+/**
+ * @brief Views contiguous NamedTypes as contiguous values of their underlying type without copying
+ *
+ * Usage:
+ *   std::vector<Meter> lengths = ...;
+ *   std::span<double> raw = asUnderlying(std::span(lengths));
+ *   cblas_dscal(raw.size(), 2.0, raw.data(), 1);
+ *
+ * @tparam NamedTypeT (possibly const) NamedType, must be layout compatible to its underlying type
+ */
+template <typename NamedTypeT, size_t extent>
+[[nodiscard]] auto asUnderlying(std::span<NamedTypeT, extent> values) noexcept
+{
+    static_assert(isLayoutCompatible<std::remove_const_t<NamedTypeT>>(),
+                  "NamedType must have the same layout as its underlying type");
+    using T = detail::ConstPreservingUnderlyingType<NamedTypeT>;
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+    return std::span<T, extent>(reinterpret_cast<T*>(values.data()), values.size());
+}
+
+/**
+ * @brief Views contiguous values of an underlying type as contiguous NamedTypes without copying
+ *
+ * Usage:
+ *   std::span<const Meter> lengths = fromUnderlying<Meter>(std::span<const double>(raw));
+ *
+ * @tparam NamedTypeT NamedType to view the values as. Constness is taken from the passed span
+ */
+template <typename NamedTypeT, typename T, size_t extent>
+[[nodiscard]] auto fromUnderlying(std::span<T, extent> values) noexcept
+{
+    using NonConstNamedType = std::remove_const_t<NamedTypeT>;
+    static_assert(std::is_same_v<std::remove_const_t<T>, UnderlyingType<NonConstNamedType>>,
+                  "Span must contain the underlying type of NamedTypeT");
+    static_assert(isLayoutCompatible<NonConstNamedType>(),
+                  "NamedType must have the same layout as its underlying type");
+    using ResultT = std::conditional_t<std::is_const_v<T>, const NonConstNamedType, NonConstNamedType>;
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+    return std::span<ResultT, extent>(reinterpret_cast<ResultT*>(values.data()), values.size());
+}
+
+/**
+ * @brief Element-wise kernels over contiguous ranges (std::vector, std::array, MaxSizeVector, std::span, ...) of
+ *        NamedTypes.
+ *
+ * The kernels only accept NamedTypes that define the corresponding behavior (e.g. Addition<> for add and sum), but
+ * internally run on the underlying type with loops shaped for auto-vectorization. Reductions (sum, dot, min, max) use
+ * several independent accumulators, so floating point results can differ in the last bits from a sequential loop.
+ */
+namespace kernels {
+
+namespace detail {
+
+/// Number of independent accumulators used in reductions to break the loop carried dependency
+constexpr size_t LANES = 4;
+
+template <typename Range>
+using ElementType = std::remove_cv_t<std::ranges::range_value_t<Range>>;
+
+template <typename Range, template <typename> class Behavior>
+constexpr bool HAS_BEHAVIOR = std::is_base_of_v<Behavior<ElementType<Range>>, ElementType<Range>>;
+
+template <typename Range>
+[[nodiscard]] auto underlying(Range&& range) noexcept
+{
+    return asUnderlying(std::span(std::forward<Range>(range)));
+}
+
+template <typename T, typename Combine>
+[[nodiscard]] constexpr T reduce(std::span<const T> values, T init, Combine combine)
+{
+    std::array<T, LANES> acc{};
+    acc.fill(init);
+
+    const size_t size = values.size();
+    size_t i = 0;
+    for (; i + LANES <= size; i += LANES)
+    {
+        for (size_t lane = 0; lane < LANES; ++lane)
+        {
+            acc[lane] = combine(acc[lane], values[i + lane]);
+        }
+    }
+    for (; i < size; ++i)
+    {
+        acc[0] = combine(acc[0], values[i]);
+    }
+    return combine(combine(acc[0], acc[1]), combine(acc[2], acc[3]));
+}
+
+}  // namespace detail
+
+/// out[i] = lhs[i] + rhs[i], out may alias lhs or rhs
+template <std::ranges::contiguous_range Lhs, std::ranges::contiguous_range Rhs, std::ranges::contiguous_range Out>
+void add(const Lhs& lhs, const Rhs& rhs, Out&& out)
+{
+    static_assert(detail::HAS_BEHAVIOR<Lhs, Addition>, "Elements need to define Addition<>");
+    static_assert(std::is_same_v<detail::ElementType<Lhs>, detail::ElementType<Rhs>> &&
+                      std::is_same_v<detail::ElementType<Lhs>, detail::ElementType<Out>>,
+                  "All ranges need to contain the same NamedType");
+
+    const auto a = detail::underlying(lhs);
+    const auto b = detail::underlying(rhs);
+    const auto result = detail::underlying(out);
+    ZBO_PRECONDITION(a.size() == b.size() && a.size() == result.size());
+
+    for (size_t i = 0; i < result.size(); ++i)
+    {
+        result[i] = a[i] + b[i];
+    }
+}
+
+/// out[i] = in[i] * factor, out may alias in
+template <std::ranges::contiguous_range In, std::ranges::contiguous_range Out, typename Factor>
+void scale(const In& in, const Factor& factor, Out&& out)
+{
+    static_assert(detail::HAS_BEHAVIOR<In, Multiplication>, "Elements need to define Multiplication<>");
+    static_assert(std::is_same_v<detail::ElementType<In>, detail::ElementType<Out>>,
+                  "All ranges need to contain the same NamedType");
+
+    const auto values = detail::underlying(in);
+    const auto result = detail::underlying(out);
+    ZBO_PRECONDITION(values.size() == result.size());
+
+    for (size_t i = 0; i < result.size(); ++i)
+    {
+        result[i] = values[i] * factor;
+    }
+}
+
+/// returns sum(lhs[i] * rhs[i]) as underlying type, as the product of two NamedTypes has a different unit
+template <std::ranges::contiguous_range Lhs, std::ranges::contiguous_range Rhs>
+[[nodiscard]] auto dot(const Lhs& lhs, const Rhs& rhs)
+{
+    static_assert(detail::HAS_BEHAVIOR<Lhs, Multiplication>, "Elements need to define Multiplication<>");
+    static_assert(std::is_same_v<detail::ElementType<Lhs>, detail::ElementType<Rhs>>,
+                  "All ranges need to contain the same NamedType");
+    using T = UnderlyingType<detail::ElementType<Lhs>>;
+
+    const auto a = detail::underlying(lhs);
+    const auto b = detail::underlying(rhs);
+    ZBO_PRECONDITION(a.size() == b.size());
+
+    std::array<T, detail::LANES> acc{};
+    const size_t size = a.size();
+    size_t i = 0;
+    for (; i + detail::LANES <= size; i += detail::LANES)
+    {
+        for (size_t lane = 0; lane < detail::LANES; ++lane)
+        {
+            acc[lane] += a[i + lane] * b[i + lane];
+        }
+    }
+    for (; i < size; ++i)
+    {
+        acc[0] += a[i] * b[i];
+    }
+    return (acc[0] + acc[1]) + (acc[2] + acc[3]);
+}
+
+/// returns the sum of all elements, or a value initialized NamedType if the range is empty
+template <std::ranges::contiguous_range In>
+[[nodiscard]] auto sum(const In& in)
+{
+    static_assert(detail::HAS_BEHAVIOR<In, Addition>, "Elements need to define Addition<>");
+    using NamedTypeT = detail::ElementType<In>;
+    using T = UnderlyingType<NamedTypeT>;
+
+    return NamedTypeT(detail::reduce<T>(detail::underlying(in), T{}, [](T lhs, T rhs) { return lhs + rhs; }));
+}
+
+/// returns the smallest element, the range must not be empty
+template <std::ranges::contiguous_range In>
+[[nodiscard]] auto min(const In& in)
+{
+    static_assert(detail::HAS_BEHAVIOR<In, Comparable>, "Elements need to define Comparable<>");
+    using NamedTypeT = detail::ElementType<In>;
+    using T = UnderlyingType<NamedTypeT>;
+
+    const auto values = detail::underlying(in);
+    ZBO_PRECONDITION(!values.empty());
+    return NamedTypeT(detail::reduce<T>(values, values[0], [](T lhs, T rhs) { return rhs < lhs ? rhs : lhs; }));
+}
+
+/// returns the largest element, the range must not be empty
+template <std::ranges::contiguous_range In>
+[[nodiscard]] auto max(const In& in)
+{
+    static_assert(detail::HAS_BEHAVIOR<In, Comparable>, "Elements need to define Comparable<>");
+    using NamedTypeT = detail::ElementType<In>;
+    using T = UnderlyingType<NamedTypeT>;
+
+    const auto values = detail::underlying(in);
+    ZBO_PRECONDITION(!values.empty());
+    return NamedTypeT(detail::reduce<T>(values, values[0], [](T lhs, T rhs) { return lhs < rhs ? rhs : lhs; }));
+}
+
+}  // namespace kernels
+}  // namespace zbo
@@ -0,0 +1,199 @@
+#include "named_type_span.h"
+
+#include <benchmark/benchmark.h>
+
+#include <random>
+#include <vector>
+
+namespace zbo::bench {
+
+struct Meter : public NamedType<double, Meter>, Comparable<Meter>, Arithmetic<Meter>
+{
+    using NamedType::NamedType;
+};
+
+constexpr int64_t MIN_SIZE = 1 << 8;
+constexpr int64_t MAX_SIZE = 1 << 20;
+constexpr int MULTIPLIER = 8;
+
+std::vector<double> randomValues(size_t size)
+{
+    std::mt19937 gen{42};
+    std::uniform_real_distribution<double> dist{-100.0, 100.0};
+    std::vector<double> values(size);
+    for (auto& value : values)
+    {
+        value = dist(gen);
+    }
+    return values;
+}
+
+std::vector<Meter> randomMeters(size_t size)
+{
+    const auto values = randomValues(size);
+    std::vector<Meter> meters(values.begin(), values.end());
+    return meters;
+}
+
+void rawAdd(benchmark::State& state)
+{
+    const auto lhs = randomValues(state.range(0));
+    const auto rhs = randomValues(state.range(0));
+    std::vector<double> out(lhs.size());
+    for (auto _ : state)
+    {
+        for (size_t i = 0; i < out.size(); ++i)
+        {
+            out[i] = lhs[i] + rhs[i];
+        }
+        benchmark::DoNotOptimize(out.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void kernelAdd(benchmark::State& state)
+{
+    const auto lhs = randomMeters(state.range(0));
+    const auto rhs = randomMeters(state.range(0));
+    std::vector<Meter> out(lhs.size());
+    for (auto _ : state)
+    {
+        kernels::add(lhs, rhs, out);
+        benchmark::DoNotOptimize(out.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void rawScale(benchmark::State& state)
+{
+    const auto in = randomValues(state.range(0));
+    std::vector<double> out(in.size());
+    for (auto _ : state)
+    {
+        for (size_t i = 0; i < out.size(); ++i)
+        {
+            out[i] = in[i] * 2.5;
+        }
+        benchmark::DoNotOptimize(out.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void kernelScale(benchmark::State& state)
+{
+    const auto in = randomMeters(state.range(0));
+    std::vector<Meter> out(in.size());
+    for (auto _ : state)
+    {
+        kernels::scale(in, 2.5, out);
+        benchmark::DoNotOptimize(out.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void rawDot(benchmark::State& state)
+{
+    const auto lhs = randomValues(state.range(0));
+    const auto rhs = randomValues(state.range(0));
+    for (auto _ : state)
+    {
+        double result = 0.0;
+        for (size_t i = 0; i < lhs.size(); ++i)
+        {
+            result += lhs[i] * rhs[i];
+        }
+        benchmark::DoNotOptimize(result);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void kernelDot(benchmark::State& state)
+{
+    const auto lhs = randomMeters(state.range(0));
+    const auto rhs = randomMeters(state.range(0));
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(kernels::dot(lhs, rhs));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void rawSum(benchmark::State& state)
+{
+    const auto in = randomValues(state.range(0));
+    for (auto _ : state)
+    {
+        double result = 0.0;
+        for (double value : in)
+        {
+            result += value;
+        }
+        benchmark::DoNotOptimize(result);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void kernelSum(benchmark::State& state)
+{
+    const auto in = randomMeters(state.range(0));
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(kernels::sum(in));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void rawMin(benchmark::State& state)
+{
+    const auto in = randomValues(state.range(0));
+    for (auto _ : state)
+    {
+        double result = in.front();
+        for (double value : in)
+        {
+            result = value < result ? value : result;
+        }
+        benchmark::DoNotOptimize(result);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void kernelMin(benchmark::State& state)
+{
+    const auto in = randomMeters(state.range(0));
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(kernels::min(in));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void kernelMax(benchmark::State& state)
+{
+    const auto in = randomMeters(state.range(0));
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(kernels::max(in));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(rawAdd)->RangeMultiplier(MULTIPLIER)->Range(MIN_SIZE, MAX_SIZE);
+BENCHMARK(kernelAdd)->RangeMultiplier(MULTIPLIER)->Range(MIN_SIZE, MAX_SIZE);
+BENCHMARK(rawScale)->RangeMultiplier(MULTIPLIER)->Range(MIN_SIZE, MAX_SIZE);
+BENCHMARK(kernelScale)->RangeMultiplier(MULTIPLIER)->Range(MIN_SIZE, MAX_SIZE);
+BENCHMARK(rawDot)->RangeMultiplier(MULTIPLIER)->Range(MIN_SIZE, MAX_SIZE);
+BENCHMARK(kernelDot)->RangeMultiplier(MULTIPLIER)->Range(MIN_SIZE, MAX_SIZE);
+BENCHMARK(rawSum)->RangeMultiplier(MULTIPLIER)->Range(MIN_SIZE, MAX_SIZE);
+BENCHMARK(kernelSum)->RangeMultiplier(MULTIPLIER)->Range(MIN_SIZE, MAX_SIZE);
+BENCHMARK(rawMin)->RangeMultiplier(MULTIPLIER)->Range(MIN_SIZE, MAX_SIZE);
+BENCHMARK(kernelMin)->RangeMultiplier(MULTIPLIER)->Range(MIN_SIZE, MAX_SIZE);
+BENCHMARK(kernelMax)->RangeMultiplier(MULTIPLIER)->Range(MIN_SIZE, MAX_SIZE);
+
+}  // namespace zbo::bench
+
+BENCHMARK_MAIN();
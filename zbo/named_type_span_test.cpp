@@ -0,0 +1,112 @@
+#include "max_size_vector.h"
+#include "named_type_span.h"
+
+#include <gtest/gtest.h>
+
+#include <numeric>
+#include <vector>
+
+namespace zbo::test {
+
+struct Meter : public NamedType<double, Meter>, Comparable<Meter>, Arithmetic<Meter>
+{
+    using NamedType::NamedType;
+};
+
+using Id = NamedType<int, struct IdTag>;
+
+static_assert(isLayoutCompatible<Meter>(), "Behaviors must not change the layout of a NamedType");
+static_assert(isLayoutCompatible<Id>(), "A plain NamedType must have the layout of its underlying type");
+static_assert(std::is_same_v<decltype(asUnderlying(std::declval<std::span<const Meter>>())), std::span<const double>>,
+              "Constness is preserved");
+static_assert(std::is_same_v<decltype(asUnderlying(std::declval<std::span<Meter, 3>>())), std::span<double, 3>>,
+              "Static extent is preserved");
+
+TEST(NamedTypeSpan, AsUnderlying)
+{
+    std::vector<Meter> lengths{Meter{1.0}, Meter{2.0}, Meter{3.0}};
+    auto raw = asUnderlying(std::span(lengths));
+    ASSERT_EQ(raw.size(), lengths.size());
+    ASSERT_EQ(static_cast<void*>(raw.data()), static_cast<void*>(lengths.data()));
+    ASSERT_DOUBLE_EQ(raw[2], 3.0);
+
+    raw[1] = 5.0;  // NOLINT(cppcoreguidelines-avoid-magic-numbers)
+    ASSERT_EQ(lengths[1], Meter{5.0});
+}
+
+TEST(NamedTypeSpan, FromUnderlying)
+{
+    const std::array<double, 3> raw{1.0, 2.0, 3.0};
+    auto lengths = fromUnderlying<Meter>(std::span(raw));
+    static_assert(std::is_same_v<decltype(lengths), std::span<const Meter, 3>>);
+    ASSERT_EQ(lengths[0], Meter{1.0});
+    ASSERT_EQ(lengths[2], Meter{3.0});
+}
+
+class NamedTypeKernels : public ::testing::TestWithParam<size_t>
+{
+  protected:
+    void SetUp() override
+    {
+        for (size_t i = 0; i < GetParam(); ++i)
+        {
+            lhs_.emplace_back(static_cast<double>(i) - 3.5);  // NOLINT(cppcoreguidelines-avoid-magic-numbers)
+            rhs_.emplace_back(static_cast<double>(i * i) * 0.5);  // NOLINT(cppcoreguidelines-avoid-magic-numbers)
+        }
+    }
+
+    std::vector<Meter> lhs_;
+    std::vector<Meter> rhs_;
+};
+
+TEST_P(NamedTypeKernels, Add)
+{
+    std::vector<Meter> out(lhs_.size());
+    kernels::add(lhs_, rhs_, out);
+    for (size_t i = 0; i < out.size(); ++i)
+    {
+        ASSERT_EQ(out[i], lhs_[i] + rhs_[i]);
+    }
+    kernels::add(lhs_, rhs_, lhs_);
+    ASSERT_EQ(lhs_, out);
+}
+
+TEST_P(NamedTypeKernels, Scale)
+{
+    std::vector<Meter> out(lhs_.size());
+    kernels::scale(lhs_, 2.0, out);
+    for (size_t i = 0; i < out.size(); ++i)
+    {
+        ASSERT_EQ(out[i], lhs_[i] * 2.0);
+    }
+}
+
+TEST_P(NamedTypeKernels, Reductions)
+{
+    const double expectedDot = std::inner_product(lhs_.begin(), lhs_.end(), rhs_.begin(), 0.0, std::plus{},
+                                                  [](Meter a, Meter b) { return a.get() * b.get(); });
+    ASSERT_DOUBLE_EQ(kernels::dot(lhs_, rhs_), expectedDot);
+    ASSERT_DOUBLE_EQ(kernels::sum(lhs_).get(), std::accumulate(lhs_.begin(), lhs_.end(), Meter{0.0}).get());
+
+    if (!lhs_.empty())
+    {
+        ASSERT_EQ(kernels::min(rhs_), *std::min_element(rhs_.begin(), rhs_.end()));
+        ASSERT_EQ(kernels::max(rhs_), *std::max_element(rhs_.begin(), rhs_.end()));
+        ASSERT_EQ(kernels::min(lhs_), lhs_.front());
+        ASSERT_EQ(kernels::max(lhs_), lhs_.back());
+    }
+}
+
+// sizes around the number of accumulators to cover the remainder loops
+INSTANTIATE_TEST_SUITE_P(Sizes, NamedTypeKernels, ::testing::Values(0, 1, 3, 4, 5, 8, 11, 1000));
+
+TEST(NamedTypeSpan, KernelsOnMaxSizeVector)
+{
+    constexpr size_t MAX_SIZE = 8;
+    MaxSizeVector<Meter, MAX_SIZE> vec{Meter{3.0}, Meter{-1.0}, Meter{2.0}};
+    ASSERT_EQ(kernels::sum(vec), Meter{4.0});
+    ASSERT_EQ(kernels::min(vec), Meter{-1.0});
+    ASSERT_EQ(kernels::max(vec), Meter{3.0});
+}
+
+}  // namespace zbo::test
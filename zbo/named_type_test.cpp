@@ -5,7 +5,11 @@
 #include <gtest/gtest.h>
 
 #include <algorithm>
+#include <limits>
 #include <numeric>
+#include <set>
+#include <string>
+#include <unordered_set>
 
 namespace zbo::test {
 struct Type1 : public NamedType<int, Type1>, Comparable<Type1>
@@ -82,4 +86,119 @@ TEST(NamedType, Sorting)
     ASSERT_DOUBLE_EQ(totalLength, totalLengthM.get());
 }
 
+struct OrderId : public NamedType<uint32_t, OrderId>, ThreeWayComparable<OrderId>, Hashable<OrderId>
+{
+    using NamedType::NamedType;
+};
+
+static_assert(std::is_same_v<decltype(OrderId{1} <=> OrderId{2}), std::strong_ordering>,
+              "Three way comparison forwards the ordering category of the underlying type");
+static_assert(OrderId{1} < OrderId{2} && OrderId{2} >= OrderId{2} && OrderId{1} != OrderId{2});
+
+TEST(NamedType, ThreeWayComparable)
+{
+    constexpr double NAN_VALUE = std::numeric_limits<double>::quiet_NaN();
+    struct Price : public NamedType<double, Price>, ThreeWayComparable<Price>
+    {
+        using NamedType::NamedType;
+    };
+    ASSERT_EQ(Price{1.0} <=> Price{2.0}, std::partial_ordering::less);
+    ASSERT_EQ(Price{1.0} <=> Price{NAN_VALUE}, std::partial_ordering::unordered);
+
+    std::set<OrderId> ids{OrderId{3}, OrderId{1}, OrderId{2}, OrderId{1}};
+    ASSERT_EQ(ids.size(), 3);
+    ASSERT_EQ(*ids.begin(), OrderId{1});
+}
+
+TEST(NamedType, Hashable)
+{
+    ASSERT_EQ(std::hash<OrderId>{}(OrderId{42}), std::hash<uint32_t>{}(42));
+
+    std::unordered_set<OrderId> ids{OrderId{3}, OrderId{1}, OrderId{2}, OrderId{1}};
+    ASSERT_EQ(ids.size(), 3);
+    ASSERT_TRUE(ids.contains(OrderId{2}));
+    ASSERT_FALSE(ids.contains(OrderId{4}));
+}
+
+struct TrackerStats
+{
+    size_t copies = 0;
+    size_t moves = 0;
+};
+
+/// counts how often it is copied and moved
+struct Tracker
+{
+    static TrackerStats& stats()
+    {
+        static TrackerStats s;
+        return s;
+    }
+    static void reset() { stats() = {}; }
+
+    Tracker() = default;
+    explicit Tracker(int value) : value(value) {}
+    Tracker(const Tracker& other) : value(other.value) { ++stats().copies; }
+    Tracker(Tracker&& other) noexcept : value(other.value) { ++stats().moves; }
+    Tracker& operator=(const Tracker& other) = default;
+    Tracker& operator=(Tracker&& other) noexcept = default;
+    ~Tracker() = default;
+
+    int value{};
+};
+
+using TrackedType = NamedType<Tracker, struct TrackedTypeTag>;
+
+static_assert(std::is_nothrow_move_constructible_v<TrackedType>);
+static_assert(!std::is_nothrow_copy_constructible_v<TrackedType>);
+static_assert(std::is_nothrow_constructible_v<TrackedType, Tracker&&>);
+static_assert(!std::is_nothrow_constructible_v<TrackedType, const Tracker&>);
+static_assert(std::is_nothrow_constructible_v<NamedType<std::string, struct StringTag>, std::string&&>);
+static_assert(std::is_trivially_copyable_v<Meter>, "Behaviors must not make a NamedType non-trivial");
+static_assert(std::is_trivially_copyable_v<OrderId>, "Behaviors must not make a NamedType non-trivial");
+
+TEST(NamedType, ConstructionFromRvalueMoves)
+{
+    Tracker::reset();
+    TrackedType type{Tracker{1}};
+    ASSERT_EQ(Tracker::stats().copies, 0);
+    ASSERT_EQ(Tracker::stats().moves, 1);
+    ASSERT_EQ(type.get().value, 1);
+}
+
+TEST(NamedType, ConstructionFromLvalueCopiesOnce)
+{
+    const Tracker tracker{2};
+    Tracker::reset();
+    TrackedType type{tracker};
+    ASSERT_EQ(Tracker::stats().copies, 1);
+    ASSERT_EQ(Tracker::stats().moves, 0);
+    ASSERT_EQ(type.get().value, 2);
+}
+
+TEST(NamedType, InPlaceConstruction)
+{
+    Tracker::reset();
+    TrackedType type{std::in_place, 3};
+    ASSERT_EQ(Tracker::stats().copies, 0);
+    ASSERT_EQ(Tracker::stats().moves, 0);
+    ASSERT_EQ(type.get().value, 3);
+
+    const NamedType<std::string, struct StringTag> string{std::in_place, 3, 'x'};
+    ASSERT_EQ(string.get(), "xxx");
+}
+
+TEST(NamedType, VectorGrowthMoves)
+{
+    constexpr size_t SIZE = 100;
+    std::vector<TrackedType> vector;
+    Tracker::reset();
+    for (size_t i = 0; i < SIZE; ++i)
+    {
+        vector.emplace_back(std::in_place, static_cast<int>(i));
+    }
+    ASSERT_EQ(Tracker::stats().copies, 0);
+    ASSERT_EQ(vector.back().get().value, SIZE - 1);
+}
+
 }  // namespace zbo::test
\ No newline at end of file
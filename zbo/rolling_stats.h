@@ -0,0 +1,442 @@
+// MIT License
+//
+// Copyright (c) 2020 Lenzebo
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include "circular_range.h"
+#include "contracts.h"
+#include "max_size_priority_queue.h"
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <span>
+#include <type_traits>
+
+namespace zbo {
+
+/**
+ * @brief The last windowSize samples pushed, stored in a ring that overwrites the oldest sample once it is full.
+ *
+ * Usage:
+ *   RollingWindow<double, 64> window;
+ *   window.push(1.0);
+ *   for (double sample : window.range()) { ... }  // oldest to newest
+ *
+ * @tparam T sample type
+ * @tparam windowSize number of samples kept
+ */
+template <typename T, size_t windowSize>
+class RollingWindow
+{
+  public:
+    static_assert(windowSize > 0, "a window needs to hold at least one sample");
+
+    [[nodiscard]] constexpr size_t size() const noexcept { return full_ ? windowSize : next_; }
+    [[nodiscard]] constexpr bool empty() const noexcept { return size() == 0; }
+    [[nodiscard]] constexpr bool full() const noexcept { return full_; }
+    [[nodiscard]] static constexpr size_t capacity() noexcept { return windowSize; }
+
+    /// position in the ring the next sample is written to, which holds the oldest sample if the window is full
+    [[nodiscard]] constexpr size_t nextPosition() const noexcept { return next_; }
+
+    [[nodiscard]] constexpr const T& oldest() const
+    {
+        ZBO_PRECONDITION(!empty())
+        return samples_[full_ ? next_ : 0];
+    }
+    [[nodiscard]] constexpr const T& newest() const
+    {
+        ZBO_PRECONDITION(!empty())
+        return samples_[(next_ + windowSize - 1) % windowSize];
+    }
+
+    /// adds a sample, dropping the oldest one if the window is full
+    constexpr void push(const T& sample)
+    {
+        samples_[next_] = sample;
+        if (++next_ == windowSize)
+        {
+            next_ = 0;
+            full_ = true;
+        }
+    }
+
+    /// all samples from the oldest to the newest
+    [[nodiscard]] CircularRange<const T> range() const
+    {
+        return {std::span<const T>(samples_.data(), size()), full_ ? next_ : 0};
+    }
+
+    constexpr void clear() noexcept
+    {
+        next_ = 0;
+        full_ = false;
+    }
+
+  private:
+    std::array<T, windowSize> samples_{};
+    size_t next_ = 0;
+    bool full_ = false;
+};
+
+/**
+ * @brief Mean and variance of the last windowSize samples, updated in O(1) per sample.
+ *
+ * Uses Welford's update while the window fills up and its sliding variant afterwards, which replaces the oldest sample
+ * by the new one. As rounding errors of the sliding updates accumulate, mean and variance are recomputed from the
+ * samples in the window every reanchorInterval samples, which is O(1) amortized for reanchorInterval >= windowSize.
+ *
+ * @tparam T arithmetic sample type
+ * @tparam windowSize number of samples in the window
+ * @tparam reanchorInterval number of sliding updates after which mean and variance are recomputed
+ */
+template <typename T, size_t windowSize, size_t reanchorInterval = windowSize>
+class RollingMeanVariance
+{
+  public:
+    static_assert(std::is_arithmetic_v<T>, "samples need to be numbers");
+    static_assert(reanchorInterval > 0, "the reanchor interval needs to be positive");
+
+    [[nodiscard]] constexpr size_t size() const noexcept { return window_.size(); }
+    [[nodiscard]] constexpr const RollingWindow<T, windowSize>& window() const noexcept { return window_; }
+
+    [[nodiscard]] constexpr double mean() const noexcept { return mean_; }
+    /// population variance of the samples in the window
+    [[nodiscard]] constexpr double variance() const noexcept { return size() == 0 ? 0.0 : squares() / size(); }
+    /// unbiased sample variance of the samples in the window
+    [[nodiscard]] constexpr double sampleVariance() const noexcept
+    {
+        return size() < 2 ? 0.0 : squares() / (size() - 1);
+    }
+
+    void push(T sample)
+    {
+        const auto value = static_cast<double>(sample);
+        if (!window_.full())
+        {
+            window_.push(sample);
+            const double delta = value - mean_;
+            mean_ += delta / window_.size();
+            squares_ += delta * (value - mean_);
+            return;
+        }
+
+        const auto evicted = static_cast<double>(window_.oldest());
+        window_.push(sample);
+        if (++sinceAnchor_ == reanchorInterval)
+        {
+            reanchor();
+            return;
+        }
+        const double oldMean = mean_;
+        mean_ += (value - evicted) / windowSize;
+        squares_ += (value - evicted) * (value - mean_ + evicted - oldMean);
+    }
+
+    constexpr void clear() noexcept
+    {
+        window_.clear();
+        mean_ = 0.0;
+        squares_ = 0.0;
+        sinceAnchor_ = 0;
+    }
+
+  private:
+    /// sum of squared differences from the mean, which can drift slightly below zero
+    [[nodiscard]] constexpr double squares() const noexcept { return std::max(squares_, 0.0); }
+
+    /// recomputes mean and variance from scratch with two passes over the window
+    void reanchor()
+    {
+        sinceAnchor_ = 0;
+        double sum = 0.0;
+        for (const T& sample : window_.range())
+        {
+            sum += static_cast<double>(sample);
+        }
+        mean_ = sum / windowSize;
+        squares_ = 0.0;
+        for (const T& sample : window_.range())
+        {
+            const double delta = static_cast<double>(sample) - mean_;
+            squares_ += delta * delta;
+        }
+    }
+
+    RollingWindow<T, windowSize> window_;
+    double mean_ = 0.0;
+    double squares_ = 0.0;
+    size_t sinceAnchor_ = 0;
+};
+
+namespace detail {
+/// deque of the samples of a window that can still become the extremum, so the extremum is always in front
+template <typename T, size_t windowSize, typename Compare>
+class MonotonicDeque
+{
+  public:
+    [[nodiscard]] constexpr const T& front() const
+    {
+        ZBO_PRECONDITION(size_ > 0)
+        return entries_[begin_].value;
+    }
+
+    constexpr void push(uint64_t sequence, const T& sample)
+    {
+        // the front dropped out of the window
+        if (size_ > 0 && entries_[begin_].sequence + windowSize <= sequence)
+        {
+            begin_ = (begin_ + 1) % windowSize;
+            --size_;
+        }
+        // samples that are not more extreme than the new one can never become the extremum anymore
+        while (size_ > 0 && !compare_(entries_[(begin_ + size_ - 1) % windowSize].value, sample))
+        {
+            --size_;
+        }
+        entries_[(begin_ + size_) % windowSize] = Entry{sequence, sample};
+        ++size_;
+    }
+
+    constexpr void clear() noexcept { size_ = 0; }
+
+  private:
+    struct Entry
+    {
+        uint64_t sequence = 0;
+        T value{};
+    };
+
+    std::array<Entry, windowSize> entries_{};
+    size_t begin_ = 0;
+    size_t size_ = 0;
+    [[no_unique_address]] Compare compare_{};
+};
+}  // namespace detail
+
+/**
+ * @brief Minimum and maximum of the last windowSize samples, updated in O(1) amortized per sample.
+ *
+ * Each extremum is kept in a monotonic deque that only holds samples that are more extreme than all samples pushed
+ * after them, so the extremum of the window is always in front and leaves the deque once it drops out of the window.
+ *
+ * @tparam T sample type
+ * @tparam windowSize number of samples in the window
+ */
+template <typename T, size_t windowSize>
+class RollingMinMax
+{
+  public:
+    static_assert(windowSize > 0, "a window needs to hold at least one sample");
+
+    [[nodiscard]] constexpr size_t size() const noexcept { return std::min<uint64_t>(count_, windowSize); }
+    [[nodiscard]] constexpr const T& min() const { return min_.front(); }
+    [[nodiscard]] constexpr const T& max() const { return max_.front(); }
+
+    constexpr void push(const T& sample)
+    {
+        min_.push(count_, sample);
+        max_.push(count_, sample);
+        ++count_;
+    }
+
+    constexpr void clear() noexcept
+    {
+        min_.clear();
+        max_.clear();
+        count_ = 0;
+    }
+
+  private:
+    // strict comparisons, so equal samples replace older ones, which drop out of the window earlier
+    detail::MonotonicDeque<T, windowSize, std::less<T>> min_;
+    detail::MonotonicDeque<T, windowSize, std::greater<T>> max_;
+    uint64_t count_ = 0;
+};
+
+/**
+ * @brief Median of the last windowSize samples, updated in O(log windowSize) per sample.
+ *
+ * The smaller half of the window is kept in a max-heap and the larger half in a min-heap, so the median is on top of
+ * them. The heaps are MaxSizePriorityQueues, whose handles allow removing the sample that drops out of the window from
+ * the middle of its heap.
+ *
+ * @tparam T arithmetic sample type
+ * @tparam windowSize number of samples in the window
+ */
+template <typename T, size_t windowSize>
+class RollingMedian
+{
+    struct Entry
+    {
+        T value{};
+        /// position of the sample in the window
+        uint32_t position = 0;
+    };
+    struct ByValue
+    {
+        constexpr bool operator()(const Entry& lhs, const Entry& rhs) const noexcept { return lhs.value < rhs.value; }
+    };
+    struct ByValueDescending
+    {
+        constexpr bool operator()(const Entry& lhs, const Entry& rhs) const noexcept { return rhs.value < lhs.value; }
+    };
+
+    // the lower half holds at most one sample more than the upper one, plus one until rebalanced
+    static constexpr size_t HALF = windowSize / 2 + 2;
+    using Lower = MaxSizePriorityQueue<Entry, HALF, ByValue>;
+    using Upper = MaxSizePriorityQueue<Entry, HALF, ByValueDescending>;
+
+  public:
+    static_assert(std::is_arithmetic_v<T>, "samples need to be numbers");
+    static_assert(windowSize < std::numeric_limits<uint32_t>::max(), "positions are stored as uint32_t");
+
+    [[nodiscard]] constexpr size_t size() const noexcept { return lower_.size() + upper_.size(); }
+
+    /// median of the samples in the window, the mean of the two middle samples for an even number of samples
+    [[nodiscard]] constexpr double median() const
+    {
+        ZBO_PRECONDITION(size() > 0)
+        if (lower_.size() > upper_.size())
+        {
+            return static_cast<double>(lower_.top().value);
+        }
+        return (static_cast<double>(lower_.top().value) + static_cast<double>(upper_.top().value)) / 2.0;
+    }
+
+    constexpr void push(T sample)
+    {
+        if (size() == windowSize)
+        {
+            const Location evicted = locations_[next_];
+            if (evicted.lower)
+            {
+                lower_.erase(typename Lower::Handle(evicted.handle));
+            }
+            else
+            {
+                upper_.erase(typename Upper::Handle(evicted.handle));
+            }
+        }
+
+        const Entry entry{sample, static_cast<uint32_t>(next_)};
+        if (lower_.empty() || !(lower_.top().value < sample))
+        {
+            locations_[next_] = {true, lower_.push(entry).get()};
+        }
+        else
+        {
+            locations_[next_] = {false, upper_.push(entry).get()};
+        }
+        next_ = (next_ + 1) % windowSize;
+        rebalance();
+    }
+
+    constexpr void clear() noexcept
+    {
+        lower_.clear();
+        upper_.clear();
+        next_ = 0;
+    }
+
+  private:
+    struct Location
+    {
+        bool lower = true;
+        uint32_t handle = 0;
+    };
+
+    constexpr void rebalance()
+    {
+        if (lower_.size() > upper_.size() + 1)
+        {
+            const Entry moved = lower_.top();
+            lower_.pop();
+            locations_[moved.position] = {false, upper_.push(moved).get()};
+        }
+        else if (upper_.size() > lower_.size())
+        {
+            const Entry moved = upper_.top();
+            upper_.pop();
+            locations_[moved.position] = {true, lower_.push(moved).get()};
+        }
+    }
+
+    Lower lower_;
+    Upper upper_;
+    /// heap and handle of the sample at every position of the window
+    std::array<Location, windowSize> locations_{};
+    size_t next_ = 0;
+};
+
+/**
+ * @brief Mean, variance, min, max and median of the last windowSize samples, all updated incrementally.
+ *
+ * Usage:
+ *   auto latency = std::make_unique<RollingStats<double, 100'000>>();  // large windows do not fit on the stack
+ *   latency->push(sample);
+ *   latency->mean(); latency->max(); latency->median();
+ *
+ * @tparam T arithmetic sample type
+ * @tparam windowSize number of samples in the window
+ */
+template <typename T, size_t windowSize>
+class RollingStats
+{
+  public:
+    [[nodiscard]] constexpr size_t size() const noexcept { return meanVariance_.size(); }
+    [[nodiscard]] constexpr const RollingWindow<T, windowSize>& window() const noexcept
+    {
+        return meanVariance_.window();
+    }
+
+    [[nodiscard]] constexpr double mean() const noexcept { return meanVariance_.mean(); }
+    [[nodiscard]] constexpr double variance() const noexcept { return meanVariance_.variance(); }
+    [[nodiscard]] constexpr double sampleVariance() const noexcept { return meanVariance_.sampleVariance(); }
+    [[nodiscard]] constexpr const T& min() const { return minMax_.min(); }
+    [[nodiscard]] constexpr const T& max() const { return minMax_.max(); }
+    [[nodiscard]] constexpr double median() const { return median_.median(); }
+
+    void push(T sample)
+    {
+        meanVariance_.push(sample);
+        minMax_.push(sample);
+        median_.push(sample);
+    }
+
+    constexpr void clear() noexcept
+    {
+        meanVariance_.clear();
+        minMax_.clear();
+        median_.clear();
+    }
+
+  private:
+    RollingMeanVariance<T, windowSize> meanVariance_;
+    RollingMinMax<T, windowSize> minMax_;
+    RollingMedian<T, windowSize> median_;
+};
+
+}  // namespace zbo
@@ -0,0 +1,143 @@
+#include "rolling_stats.h"
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <memory>
+#include <random>
+#include <vector>
+
+namespace zbo::bench {
+
+constexpr size_t NUM_SAMPLES = 1 << 16;
+
+std::vector<double> randomSamples()
+{
+    std::mt19937_64 gen{42};
+    std::normal_distribution<double> dist(100.0, 15.0);
+    std::vector<double> samples(NUM_SAMPLES);
+    std::generate(samples.begin(), samples.end(), [&]() { return dist(gen); });
+    return samples;
+}
+
+struct Result
+{
+    double mean = 0.0;
+    double variance = 0.0;
+    double min = 0.0;
+    double max = 0.0;
+    double median = 0.0;
+};
+
+/// what RollingStats replaces: every statistic is recomputed by iterating over the window
+template <size_t windowSize>
+Result recompute(const RollingWindow<double, windowSize>& window, std::vector<double>& scratch)
+{
+    Result result;
+    const auto range = window.range();
+    double sum = 0.0;
+    result.min = range[0];
+    result.max = range[0];
+    scratch.clear();
+    for (double sample : range)
+    {
+        scratch.push_back(sample);
+        sum += sample;
+        result.min = std::min(result.min, sample);
+        result.max = std::max(result.max, sample);
+    }
+    result.mean = sum / window.size();
+    for (double sample : range)
+    {
+        result.variance += (sample - result.mean) * (sample - result.mean);
+    }
+    result.variance /= window.size();
+
+    const auto middle = scratch.begin() + scratch.size() / 2;
+    std::nth_element(scratch.begin(), middle, scratch.end());
+    result.median = *middle;
+    return result;
+}
+
+template <size_t windowSize>
+void fullRecompute(benchmark::State& state)
+{
+    const auto samples = randomSamples();
+    auto window = std::make_unique<RollingWindow<double, windowSize>>();
+    for (size_t idx = 0; idx < windowSize; ++idx)
+    {
+        window->push(samples[idx % samples.size()]);
+    }
+
+    std::vector<double> scratch;
+    size_t idx = 0;
+    for (auto _ : state)
+    {
+        window->push(samples[idx++ % samples.size()]);
+        benchmark::DoNotOptimize(recompute(*window, scratch));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+template <size_t windowSize>
+void incremental(benchmark::State& state)
+{
+    const auto samples = randomSamples();
+    auto stats = std::make_unique<RollingStats<double, windowSize>>();
+    for (size_t idx = 0; idx < windowSize; ++idx)
+    {
+        stats->push(samples[idx % samples.size()]);
+    }
+
+    size_t idx = 0;
+    for (auto _ : state)
+    {
+        stats->push(samples[idx++ % samples.size()]);
+        benchmark::DoNotOptimize(Result{stats->mean(), stats->variance(), stats->min(), stats->max(), stats->median()});
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+/// cost of the single accumulators, as not every metric needs all statistics
+template <typename Accumulator>
+void accumulator(benchmark::State& state)
+{
+    const auto samples = randomSamples();
+    auto stats = std::make_unique<Accumulator>();
+    size_t idx = 0;
+    for (auto _ : state)
+    {
+        stats->push(samples[idx++ % samples.size()]);
+        benchmark::DoNotOptimize(*stats);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+constexpr size_t TINY = 64;
+constexpr size_t SMALL = 1024;
+constexpr size_t MEDIUM = 16384;
+constexpr size_t LARGE = 262'144;
+constexpr size_t HUGE = 1'048'576;
+
+BENCHMARK_TEMPLATE(fullRecompute, TINY);
+BENCHMARK_TEMPLATE(fullRecompute, SMALL);
+BENCHMARK_TEMPLATE(fullRecompute, MEDIUM);
+BENCHMARK_TEMPLATE(fullRecompute, LARGE);
+BENCHMARK_TEMPLATE(fullRecompute, HUGE);
+
+BENCHMARK_TEMPLATE(incremental, TINY);
+BENCHMARK_TEMPLATE(incremental, SMALL);
+BENCHMARK_TEMPLATE(incremental, MEDIUM);
+BENCHMARK_TEMPLATE(incremental, LARGE);
+BENCHMARK_TEMPLATE(incremental, HUGE);
+
+BENCHMARK_TEMPLATE(accumulator, RollingMeanVariance<double, SMALL>);
+BENCHMARK_TEMPLATE(accumulator, RollingMinMax<double, SMALL>);
+BENCHMARK_TEMPLATE(accumulator, RollingMedian<double, SMALL>);
+BENCHMARK_TEMPLATE(accumulator, RollingMeanVariance<double, HUGE>);
+BENCHMARK_TEMPLATE(accumulator, RollingMinMax<double, HUGE>);
+BENCHMARK_TEMPLATE(accumulator, RollingMedian<double, HUGE>);
+
+}  // namespace zbo::bench
+
+BENCHMARK_MAIN();
@@ -0,0 +1,162 @@
+#include "rolling_stats.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <memory>
+#include <numeric>
+#include <random>
+#include <vector>
+
+namespace zbo::test {
+
+TEST(RollingWindow, KeepsLastSamples)
+{
+    RollingWindow<int, 3> window;
+    ASSERT_TRUE(window.empty());
+    window.push(1);
+    window.push(2);
+    ASSERT_EQ(window.size(), 2);
+    ASSERT_EQ(window.oldest(), 1);
+    ASSERT_EQ(window.newest(), 2);
+
+    window.push(3);
+    window.push(4);
+    ASSERT_TRUE(window.full());
+    ASSERT_EQ(window.oldest(), 2);
+    ASSERT_EQ(window.newest(), 4);
+    const auto range = window.range();
+    ASSERT_EQ(std::vector<int>(range.begin(), range.end()), (std::vector<int>{2, 3, 4}));
+}
+
+TEST(RollingMeanVariance, SlidingWindow)
+{
+    RollingMeanVariance<int, 4> stats;
+    for (int sample : {2, 4, 4, 4})
+    {
+        stats.push(sample);
+    }
+    ASSERT_DOUBLE_EQ(stats.mean(), 3.5);
+    ASSERT_DOUBLE_EQ(stats.variance(), 0.75);
+    ASSERT_DOUBLE_EQ(stats.sampleVariance(), 1.0);
+
+    // 2 drops out of the window
+    stats.push(8);
+    ASSERT_DOUBLE_EQ(stats.mean(), 5.0);
+    ASSERT_DOUBLE_EQ(stats.variance(), 3.0);
+}
+
+TEST(RollingMeanVariance, ReanchoringKeepsLargeOffsetsPrecise)
+{
+    // samples with a large offset and a small spread, where the sliding updates lose most digits
+    constexpr size_t WINDOW = 16;
+    RollingMeanVariance<double, WINDOW> stats;
+    std::mt19937 rng(42);  // NOLINT (cert-msc51-cpp) deterministic on purpose
+    std::uniform_real_distribution<double> noise(-1.0, 1.0);
+    std::vector<double> samples;
+    for (size_t idx = 0; idx < 100'000; ++idx)
+    {
+        samples.push_back(1e9 + noise(rng));
+        stats.push(samples.back());
+    }
+
+    const auto first = samples.end() - WINDOW;
+    const double mean = std::accumulate(first, samples.end(), 0.0) / WINDOW;
+    double squares = 0.0;
+    std::for_each(first, samples.end(), [&](double sample) { squares += (sample - mean) * (sample - mean); });
+    ASSERT_NEAR(stats.mean(), mean, 1e-6);
+    ASSERT_NEAR(stats.variance(), squares / WINDOW, 1e-3);
+}
+
+TEST(RollingMinMax, DropsExtremaOutOfTheWindow)
+{
+    RollingMinMax<int, 3> minMax;
+    minMax.push(5);
+    ASSERT_EQ(minMax.min(), 5);
+    ASSERT_EQ(minMax.max(), 5);
+    minMax.push(1);
+    minMax.push(3);
+    ASSERT_EQ(minMax.min(), 1);
+    ASSERT_EQ(minMax.max(), 5);
+
+    minMax.push(2);  // 5 drops out
+    ASSERT_EQ(minMax.max(), 3);
+    minMax.push(2);  // 1 drops out
+    ASSERT_EQ(minMax.min(), 2);
+    minMax.push(4);  // 3 drops out
+    ASSERT_EQ(minMax.min(), 2);
+    ASSERT_EQ(minMax.max(), 4);
+}
+
+TEST(RollingMedian, OddAndEvenWindows)
+{
+    RollingMedian<int, 4> median;
+    median.push(5);
+    ASSERT_DOUBLE_EQ(median.median(), 5.0);
+    median.push(1);
+    ASSERT_DOUBLE_EQ(median.median(), 3.0);
+    median.push(9);
+    ASSERT_DOUBLE_EQ(median.median(), 5.0);
+    median.push(7);
+    ASSERT_DOUBLE_EQ(median.median(), 6.0);
+
+    // 5 and 1 drop out
+    median.push(2);
+    median.push(2);
+    ASSERT_DOUBLE_EQ(median.median(), 4.5);
+}
+
+template <size_t windowSize>
+void checkAgainstRecompute()
+{
+    auto stats = std::make_unique<RollingStats<int, windowSize>>();
+    std::mt19937 rng(42);  // NOLINT (cert-msc51-cpp) deterministic on purpose
+    std::uniform_int_distribution<int> values(-50, 50);
+    std::vector<int> samples;
+    for (size_t idx = 0; idx < 3 * windowSize + 7; ++idx)
+    {
+        samples.push_back(values(rng));
+        stats->push(samples.back());
+
+        std::vector<int> window(samples.end() - std::min(samples.size(), windowSize), samples.end());
+        ASSERT_EQ(stats->size(), window.size());
+        ASSERT_EQ(stats->min(), *std::min_element(window.begin(), window.end()));
+        ASSERT_EQ(stats->max(), *std::max_element(window.begin(), window.end()));
+
+        const double mean = std::accumulate(window.begin(), window.end(), 0.0) / window.size();
+        double squares = 0.0;
+        std::for_each(window.begin(), window.end(), [&](int sample) { squares += (sample - mean) * (sample - mean); });
+        ASSERT_NEAR(stats->mean(), mean, 1e-9);
+        ASSERT_NEAR(stats->variance(), squares / window.size(), 1e-9);
+
+        std::sort(window.begin(), window.end());
+        const size_t middle = window.size() / 2;
+        const double median =
+            window.size() % 2 == 1 ? window[middle] : (window[middle - 1] + window[middle]) / 2.0;
+        ASSERT_DOUBLE_EQ(stats->median(), median);
+    }
+}
+
+TEST(RollingStats, MatchesRecompute)
+{
+    checkAgainstRecompute<1>();
+    checkAgainstRecompute<2>();
+    checkAgainstRecompute<5>();
+    checkAgainstRecompute<64>();
+}
+
+TEST(RollingStats, Clear)
+{
+    RollingStats<int, 4> stats;
+    stats.push(3);
+    stats.push(7);
+    stats.clear();
+    ASSERT_EQ(stats.size(), 0);
+    stats.push(1);
+    ASSERT_EQ(stats.min(), 1);
+    ASSERT_EQ(stats.max(), 1);
+    ASSERT_DOUBLE_EQ(stats.mean(), 1.0);
+    ASSERT_DOUBLE_EQ(stats.median(), 1.0);
+}
+
+}  // namespace zbo::test
@@ -0,0 +1,319 @@
+// MIT License
+//
+// Copyright (c) 2020 Lenzebo
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#pragma once
+
+#include "contracts.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cerrno>
+#include <charconv>
+#include <csignal>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <thread>
+#include <unordered_map>
+
+#include <cxxabi.h>
+#include <dlfcn.h>
+#include <execinfo.h>
+#include <sys/time.h>
+
+namespace zbo {
+
+/**
+ * @brief Sampling cpu profiler that collects stack traces of the running threads at a fixed rate and aggregates them
+ *        into folded stacks for flame graphs.
+ *
+ * A profiling timer (setitimer with ITIMER_PROF) sends SIGPROF for every interval of cpu time the process consumes.
+ * The signal handler captures the stack of the interrupted thread with backtrace() into a preallocated buffer, where
+ * every sample claims its slot with an atomic increment, so sampling neither allocates nor locks. Samples that do not
+ * fit into the buffer anymore are dropped and counted. The stacks are only symbolized when reading the result, which
+ * needs functions in the dynamic symbol table, so link with -rdynamic (ENABLE_EXPORTS in CMake) to see all names.
+ *
+ * The kernel checks cpu timers on its scheduler tick, so the effective rate is limited to CONFIG_HZ, e.g. 250 or
+ * 1000 samples per second of cpu time. The SIGPROF handler stays installed after the first start.
+ *
+ * Setting the environment variable ZBO_PROFILE to a file profiles the whole run of a program that includes this
+ * header and writes the folded stacks to that file at exit, ZBO_PROFILE_HZ sets the frequency (default 1000, which is
+ * also used for invalid values).
+ *
+ * Usage:
+ *   SamplingProfiler::start(1000);
+ *   timeFunction(simulateTick);
+ *   SamplingProfiler::stop();
+ *   SamplingProfiler::writeFoldedStacks(std::ofstream("tick.folded"));
+ *
+ *   $ flamegraph.pl tick.folded > tick.svg
+ */
+class SamplingProfiler
+{
+  public:
+    static constexpr int MAX_DEPTH = 64;
+    static constexpr int DEFAULT_FREQUENCY = 1000;
+    static constexpr int MAX_FREQUENCY = 1'000'000;
+
+    /// starts sampling at frequency per second of cpu time and discards the samples of a previous run
+    static bool start(int frequency = DEFAULT_FREQUENCY, size_t maxSamples = size_t{1} << 16U)
+    {
+        ZBO_PRECONDITION(frequency > 0 && frequency <= MAX_FREQUENCY)
+        if (running_.load())
+        {
+            return false;
+        }
+        if (maxSamples != capacity_)
+        {
+            delete[] samples_;  // NOLINT (cppcoreguidelines-owning-memory)
+            samples_ = new Sample[maxSamples];  // NOLINT (cppcoreguidelines-owning-memory)
+            capacity_ = maxSamples;
+        }
+        for (size_t idx = 0; idx < capacity_; ++idx)
+        {
+            samples_[idx].ready.store(false, std::memory_order_relaxed);
+        }
+        next_.store(0);
+        installHandler();
+
+        running_.store(true);
+        // setitimer rejects 1'000'000 microseconds, so full seconds go into tv_sec
+        constexpr int MICROSECONDS = 1'000'000;
+        itimerval timer{};
+        timer.it_interval.tv_sec = (MICROSECONDS / frequency) / MICROSECONDS;
+        timer.it_interval.tv_usec = (MICROSECONDS / frequency) % MICROSECONDS;
+        timer.it_value = timer.it_interval;
+        if (setitimer(ITIMER_PROF, &timer, nullptr) != 0)
+        {
+            running_.store(false);
+            return false;
+        }
+        return true;
+    }
+
+    /// stops sampling and waits for signal handlers that are still running
+    static void stop()
+    {
+        const itimerval disarm{};
+        setitimer(ITIMER_PROF, &disarm, nullptr);
+        running_.store(false);
+        while (activeHandlers_.load() != 0)
+        {
+            std::this_thread::yield();
+        }
+    }
+
+    [[nodiscard]] static bool isRunning() noexcept { return running_.load(); }
+
+    /// number of samples in the buffer
+    [[nodiscard]] static size_t numSamples() noexcept { return std::min(next_.load(), capacity_); }
+    /// number of samples that did not fit into the buffer
+    [[nodiscard]] static size_t droppedSamples() noexcept { return next_.load() - numSamples(); }
+
+    /**
+     * @brief symbolizes the samples taken so far and returns how often each stack has been seen
+     *
+     * A stack is the list of functions from the outermost to the innermost one, separated by ';', e.g.
+     * "main;zbo::simulateTick();std::sort<...>". Call it after stop(), as symbolizing allocates.
+     */
+    [[nodiscard]] static std::map<std::string, size_t> foldedStacks()
+    {
+        std::map<std::string, size_t> stacks;
+        std::unordered_map<void*, std::string> symbols;
+        for (size_t idx = 0; idx < numSamples(); ++idx)
+        {
+            const Sample& sample = samples_[idx];
+            if (!sample.ready.load(std::memory_order_acquire))
+            {
+                continue;
+            }
+            std::string stack;
+            // backtrace() starts with the leaf, the first frames are the signal handler and the signal trampoline
+            for (int frame = sample.depth - 1; frame >= SKIPPED_FRAMES; --frame)
+            {
+                // the innermost frame is the interrupted instruction, all others are return addresses, which point
+                // behind the call and might already be in the next function
+                void* address = static_cast<char*>(sample.frames[frame]) - (frame > SKIPPED_FRAMES ? 1 : 0);
+                auto it = symbols.find(address);
+                if (it == symbols.end())
+                {
+                    it = symbols.emplace(address, symbolize(address)).first;
+                }
+                stack += stack.empty() ? "" : ";";
+                stack += it->second;
+            }
+            if (!stack.empty())
+            {
+                ++stacks[stack];
+            }
+        }
+        return stacks;
+    }
+
+    /// writes foldedStacks() in the format of flamegraph.pl, one "stack count" per line
+    static void writeFoldedStacks(std::ostream& output)
+    {
+        for (const auto& [stack, count] : foldedStacks())
+        {
+            output << stack << ' ' << count << '\n';
+        }
+    }
+    static void writeFoldedStacks(std::ostream&& output) { writeFoldedStacks(output); }
+
+  private:
+    static constexpr int SKIPPED_FRAMES = 2;
+
+    struct Sample
+    {
+        std::atomic<bool> ready{false};
+        int depth = 0;
+        std::array<void*, MAX_DEPTH> frames{};
+    };
+
+    static void installHandler()
+    {
+        if (handlerInstalled_)
+        {
+            return;
+        }
+        // loads the unwinder now, as backtrace() allocates on its first call, which is not allowed in a signal handler
+        std::array<void*, 1> warmup{};
+        backtrace(warmup.data(), warmup.size());
+
+        struct sigaction action = {};
+        action.sa_handler = &onSignal;
+        sigemptyset(&action.sa_mask);
+        action.sa_flags = SA_RESTART;
+        sigaction(SIGPROF, &action, nullptr);
+        handlerInstalled_ = true;
+    }
+
+    static void onSignal(int /*signal*/) noexcept
+    {
+        const int savedErrno = errno;
+        // pairs with stop(), so either stop() waits for this handler or the handler sees that sampling has stopped
+        activeHandlers_.fetch_add(1);
+        if (running_.load())
+        {
+            const size_t idx = next_.fetch_add(1, std::memory_order_relaxed);
+            if (idx < capacity_)
+            {
+                Sample& sample = samples_[idx];
+                sample.depth = backtrace(sample.frames.data(), MAX_DEPTH);
+                sample.ready.store(true, std::memory_order_release);
+            }
+        }
+        activeHandlers_.fetch_sub(1);
+        errno = savedErrno;
+    }
+
+    /// demangled name of the function containing address or module+offset if it is not exported
+    static std::string symbolize(void* address)
+    {
+        Dl_info info{};
+        if (dladdr(address, &info) == 0)
+        {
+            return "??";
+        }
+        if (info.dli_sname != nullptr)
+        {
+            int status = 0;
+            std::unique_ptr<char, decltype(&std::free)> demangled(
+                abi::__cxa_demangle(info.dli_sname, nullptr, nullptr, &status), &std::free);
+            return status == 0 ? demangled.get() : info.dli_sname;
+        }
+        const char* module = info.dli_fname != nullptr ? std::strrchr(info.dli_fname, '/') : nullptr;
+        std::array<char, 32> offset{};
+        std::snprintf(offset.data(), offset.size(), "+0x%zx",
+                      static_cast<size_t>(static_cast<char*>(address) - static_cast<char*>(info.dli_fbase)));
+        return std::string(module != nullptr ? module + 1 : "??") + offset.data();
+    }
+
+    static inline Sample* samples_ = nullptr;
+    static inline size_t capacity_ = 0;
+    static inline std::atomic<size_t> next_{0};
+    static inline std::atomic<bool> running_{false};
+    static inline std::atomic<int> activeHandlers_{0};
+    static inline bool handlerInstalled_ = false;
+};
+
+namespace detail {
+
+/// the frequency of ZBO_PROFILE_HZ, or the default if it is not set or not a valid frequency
+inline int profileFrequency(const char* text)
+{
+    int frequency = 0;
+    const std::string_view view = text != nullptr ? text : "";
+    const auto [end, error] = std::from_chars(view.data(), view.data() + view.size(), frequency);
+    if (error != std::errc() || end != view.data() + view.size() || frequency <= 0 ||
+        frequency > SamplingProfiler::MAX_FREQUENCY)
+    {
+        return SamplingProfiler::DEFAULT_FREQUENCY;
+    }
+    return frequency;
+}
+
+/// profiles the whole program if the environment variable ZBO_PROFILE names an output file
+class ProfileFromEnvironment
+{
+  public:
+    ProfileFromEnvironment()
+    {
+        const char* path = std::getenv("ZBO_PROFILE");  // NOLINT (concurrency-mt-unsafe) before main
+        const char* frequency = std::getenv("ZBO_PROFILE_HZ");  // NOLINT (concurrency-mt-unsafe)
+        if (path != nullptr && *path != '\0')
+        {
+            path_ = path;
+            active_ = SamplingProfiler::start(profileFrequency(frequency));
+        }
+    }
+    ProfileFromEnvironment(const ProfileFromEnvironment&) = delete;
+    ProfileFromEnvironment& operator=(const ProfileFromEnvironment&) = delete;
+    ~ProfileFromEnvironment()
+    {
+        if (active_)
+        {
+            SamplingProfiler::stop();
+            SamplingProfiler::writeFoldedStacks(std::ofstream(path_));
+        }
+    }
+
+  private:
+    std::string path_;
+    bool active_ = false;
+};
+
+inline ProfileFromEnvironment profileFromEnvironment;
+
+}  // namespace detail
+
+}  // namespace zbo
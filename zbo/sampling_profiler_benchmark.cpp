@@ -0,0 +1,70 @@
+#include "sampling_profiler.h"
+
+#include <benchmark/benchmark.h>
+
+#include <chrono>
+#include <cmath>
+#include <csignal>
+
+namespace zbo::bench {
+
+constexpr int ITERATIONS = 1'000'000;
+
+[[gnu::noinline]] double work(double value)
+{
+    for (int idx = 0; idx < ITERATIONS; ++idx)
+    {
+        value = std::sqrt(value + 1.0);
+    }
+    return value;
+}
+
+/// the same work without the profiler, at 1 kHz and at 10 kHz, the difference is the overhead of sampling
+void profiledWork(benchmark::State& state)
+{
+    const auto frequency = static_cast<int>(state.range(0));
+    if (frequency > 0)
+    {
+        SamplingProfiler::start(frequency, size_t{1} << 20U);
+    }
+    double value = 1.0;
+    for (auto _ : state)
+    {
+        value = work(value);
+    }
+    benchmark::DoNotOptimize(value);
+    if (frequency > 0)
+    {
+        SamplingProfiler::stop();
+    }
+    state.SetItemsProcessed(state.iterations() * ITERATIONS);
+    // the kernel might deliver fewer samples than asked for, see SamplingProfiler
+    state.counters["samples"] = static_cast<double>(SamplingProfiler::numSamples() * (frequency > 0 ? 1 : 0));
+    state.counters["samplesPerSecond"] = benchmark::Counter(state.counters["samples"], benchmark::Counter::kIsRate);
+}
+
+/// the cost of one sample, signal delivery included, which gives the overhead at rates the kernel does not deliver
+void sample(benchmark::State& state)
+{
+    constexpr size_t MAX_SAMPLES = 1'000'000;
+    SamplingProfiler::start(1, MAX_SAMPLES);
+    const auto start = std::chrono::steady_clock::now();
+    for (auto _ : state)
+    {
+        std::raise(SIGPROF);
+    }
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    SamplingProfiler::stop();
+    state.SetItemsProcessed(state.iterations());
+    // fraction of the cpu time spent on sampling
+    const double secondsPerSample = elapsed.count() / static_cast<double>(state.iterations());
+    state.counters["overheadAt1kHz"] = secondsPerSample * 1e3;
+    state.counters["overheadAt10kHz"] = secondsPerSample * 1e4;
+}
+
+BENCHMARK(profiledWork)->Arg(0)->Arg(1000)->Arg(10'000);
+BENCHMARK(sample)->Iterations(100'000);
+
+}  // namespace zbo::bench
+
+BENCHMARK_MAIN();
@@ -0,0 +1,169 @@
+#include "sampling_profiler.h"
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+#if defined(__SANITIZE_THREAD__) || defined(__SANITIZE_ADDRESS__)
+#define ZBO_SANITIZER 1
+#elif defined(__has_feature)
+#if __has_feature(thread_sanitizer) || __has_feature(address_sanitizer)
+#define ZBO_SANITIZER 1
+#endif
+#endif
+
+namespace zbo::test {
+
+#if defined(ZBO_SANITIZER)
+// ThreadSanitizer defers signals until the thread calls an intercepted function, so hot loops are never sampled, and
+// AddressSanitizer adds frames of its runtime to the stacks
+#define SKIP_WITHOUT_ASYNC_SIGNALS() GTEST_SKIP() << "signals are not sampled reliably with sanitizers"
+#else
+#define SKIP_WITHOUT_ASYNC_SIGNALS() (void)0
+#endif
+
+constexpr int ITERATIONS = 50'000'000;
+
+/// burns cpu time in a dependency chain the compiler cannot shorten, written out as integer arithmetic so that nothing
+/// is called at any optimization level (e.g. sqrt at -O0) and the hot functions are the innermost frames
+[[gnu::noinline]] uint64_t hotFunctionA(uint64_t value)
+{
+    for (int idx = 0; idx < ITERATIONS; ++idx)
+    {
+        value = value * 6364136223846793005ULL + 1442695040888963407ULL;
+        value ^= value >> 29U;
+    }
+    return value;
+}
+
+/// takes twice as long as hotFunctionA
+[[gnu::noinline]] uint64_t hotFunctionB(uint64_t value)
+{
+    for (int idx = 0; idx < 2 * ITERATIONS; ++idx)
+    {
+        value = value * 6364136223846793005ULL + 1442695040888963407ULL;
+        value ^= value >> 29U;
+    }
+    return value;
+}
+
+/// number of samples with function anywhere on the stack
+size_t samplesIn(const std::map<std::string, size_t>& stacks, const std::string& function)
+{
+    size_t count = 0;
+    for (const auto& [stack, samples] : stacks)
+    {
+        count += stack.find(function) != std::string::npos ? samples : 0;
+    }
+    return count;
+}
+
+TEST(SamplingProfiler, AttributesSamplesToHotFunctions)
+{
+    SKIP_WITHOUT_ASYNC_SIGNALS();
+    ASSERT_TRUE(SamplingProfiler::start(1000));
+    ASSERT_TRUE(SamplingProfiler::isRunning());
+    uint64_t value = hotFunctionA(1);
+    value = hotFunctionB(value);
+    SamplingProfiler::stop();
+    ASSERT_FALSE(SamplingProfiler::isRunning());
+    ASSERT_NE(value, 1U);
+
+    const auto stacks = SamplingProfiler::foldedStacks();
+    const size_t samplesA = samplesIn(stacks, "zbo::test::hotFunctionA(");
+    const size_t samplesB = samplesIn(stacks, "zbo::test::hotFunctionB(");
+    ASSERT_GT(samplesA, 10U);
+    ASSERT_GT(samplesA + samplesB, SamplingProfiler::numSamples() * 9 / 10);
+    ASSERT_GT(samplesB, samplesA * 13 / 10);
+    ASSERT_LT(samplesB, samplesA * 3);
+}
+
+TEST(SamplingProfiler, StacksGoFromCallerToCallee)
+{
+    SKIP_WITHOUT_ASYNC_SIGNALS();
+    ASSERT_TRUE(SamplingProfiler::start(1000));
+    const uint64_t value = hotFunctionA(1);
+    SamplingProfiler::stop();
+    ASSERT_NE(value, 1U);
+
+    size_t checked = 0;
+    for (const auto& [stack, count] : SamplingProfiler::foldedStacks())
+    {
+        const auto hot = stack.find("hotFunctionA");
+        if (hot != std::string::npos)
+        {
+            ASSERT_LT(stack.find("StacksGoFromCallerToCallee"), hot) << stack;
+            ASSERT_EQ(stack.find(';', hot), std::string::npos) << stack;
+            checked += count;
+        }
+    }
+    ASSERT_GT(checked, 10U);
+}
+
+TEST(SamplingProfiler, DropsSamplesThatDoNotFit)
+{
+    SKIP_WITHOUT_ASYNC_SIGNALS();
+    ASSERT_TRUE(SamplingProfiler::start(1000, 4));
+    ASSERT_FALSE(SamplingProfiler::start(1000));
+    const uint64_t value = hotFunctionA(1);
+    SamplingProfiler::stop();
+    ASSERT_NE(value, 1U);
+    ASSERT_EQ(SamplingProfiler::numSamples(), 4);
+    ASSERT_GT(SamplingProfiler::droppedSamples(), 0);
+
+    // a restart discards the samples of the previous run
+    ASSERT_TRUE(SamplingProfiler::start(1000, 4));
+    SamplingProfiler::stop();
+    ASSERT_EQ(SamplingProfiler::numSamples(), 0);
+}
+
+TEST(SamplingProfiler, ProfilesFromEnvironment)
+{
+    SKIP_WITHOUT_ASYNC_SIGNALS();
+    const std::string path = testing::TempDir() + "sampling_profiler_test.folded";
+    setenv("ZBO_PROFILE", path.c_str(), 1);  // NOLINT (concurrency-mt-unsafe)
+    setenv("ZBO_PROFILE_HZ", "500", 1);      // NOLINT (concurrency-mt-unsafe)
+    {
+        const detail::ProfileFromEnvironment profile;
+        ASSERT_TRUE(SamplingProfiler::isRunning());
+        ASSERT_NE(hotFunctionA(1), 1U);
+    }
+    unsetenv("ZBO_PROFILE");  // NOLINT (concurrency-mt-unsafe)
+    ASSERT_FALSE(SamplingProfiler::isRunning());
+
+    std::ifstream input(path);
+    std::stringstream text;
+    text << input.rdbuf();
+    ASSERT_NE(text.str().find("zbo::test::hotFunctionA("), std::string::npos) << text.str();
+}
+
+TEST(SamplingProfiler, StartsWithAllValidFrequencies)
+{
+    for (int frequency : {1, 2, 999, SamplingProfiler::MAX_FREQUENCY})
+    {
+        ASSERT_TRUE(SamplingProfiler::start(frequency)) << frequency;
+        SamplingProfiler::stop();
+    }
+}
+
+TEST(SamplingProfiler, UsesDefaultFrequencyForInvalidEnvironment)
+{
+    ASSERT_EQ(detail::profileFrequency("500"), 500);
+    ASSERT_EQ(detail::profileFrequency("1000000"), 1'000'000);
+    ASSERT_EQ(detail::profileFrequency(nullptr), SamplingProfiler::DEFAULT_FREQUENCY);
+    for (const char* text : {"", "abc", "0", "-5", "12abc", "1000001", "99999999999"})
+    {
+        ASSERT_EQ(detail::profileFrequency(text), SamplingProfiler::DEFAULT_FREQUENCY) << text;
+    }
+}
+
+TEST(SamplingProfilerDeathTest, FrequencyMustBePositive)
+{
+    ASSERT_DEATH((void)SamplingProfiler::start(0), "");
+}
+
+}  // namespace zbo::test
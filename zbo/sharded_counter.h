@@ -0,0 +1,150 @@
+// MIT License
+//
+// Copyright (c) 2020 Lenzebo
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include "cache_line.h"
+#include "named_type.h"
+
+#include <array>
+#include <atomic>
+#include <type_traits>
+
+#if defined(__linux__)
+#include <sched.h>
+#endif
+
+namespace zbo {
+
+namespace detail {
+/// returns a small, unique index per thread, assigned in order of first usage
+inline size_t threadIndex() noexcept
+{
+    static std::atomic<size_t> nextIndex{0};
+    thread_local const size_t index = nextIndex.fetch_add(1, std::memory_order_relaxed);
+    return index;
+}
+}  // namespace detail
+
+/// Selects the shard by the order in which threads first touched any ShardedCounter (no contention for up to N threads)
+struct PerThreadShard
+{
+    [[nodiscard]] static size_t index() noexcept { return detail::threadIndex(); }
+};
+
+/// Selects the shard by the CPU the calling thread currently runs on (useful for many short-lived threads)
+struct PerCpuShard
+{
+    [[nodiscard]] static size_t index() noexcept
+    {
+#if defined(__linux__)
+        const int cpu = sched_getcpu();
+        return cpu < 0 ? detail::threadIndex() : static_cast<size_t>(cpu);
+#else
+        return detail::threadIndex();
+#endif
+    }
+};
+
+/**
+ * @brief Counter of a NamedType that can be incremented from many threads concurrently without bouncing one cache
+ *        line between the cores
+ *
+ * The counter consists of numShards atomics, each on its own cache line. Additions go to the shard of the calling
+ * thread (or CPU) with a relaxed atomic add, reading the counter sums up all shards. Reads are therefore more expensive
+ * than writes and not a consistent snapshot with respect to concurrent writers, which is fine for statistics.
+ *
+ * Usage:
+ *  struct Bytes : public NamedType<uint64_t, Bytes>, Addition<Bytes>
+ *  {
+ *      using NamedType::NamedType;
+ *  };
+ *
+ *  ShardedCounter<Bytes> received;
+ *  received += Bytes{message.size()};  // any thread
+ *  Bytes total = received.load();
+ *
+ * @tparam NamedTypeT NamedType with an integral underlying type and the Addition<> behavior
+ * @tparam numShards number of shards, needs to be a power of two. Each shard occupies CACHE_LINE_SIZE bytes
+ * @tparam ShardSelector PerThreadShard or PerCpuShard
+ */
+template <typename NamedTypeT, size_t numShards = 64, typename ShardSelector = PerThreadShard>
+class ShardedCounter
+{
+    using T = UnderlyingType<NamedTypeT>;
+    static_assert(std::is_integral_v<T>, "Sharded counters need an integral underlying type");
+    static_assert(std::is_base_of_v<Addition<NamedTypeT>, NamedTypeT>, "NamedTypeT needs to define Addition<>");
+    static_assert(numShards > 0 && (numShards & (numShards - 1)) == 0, "numShards needs to be a power of two");
+
+    struct alignas(CACHE_LINE_SIZE) Shard
+    {
+        std::atomic<T> value{0};
+    };
+
+  public:
+    ShardedCounter() = default;
+    ShardedCounter(const ShardedCounter&) = delete;
+    ShardedCounter& operator=(const ShardedCounter&) = delete;
+
+    /// adds value to the shard of the calling thread
+    ShardedCounter& operator+=(const NamedTypeT& value) noexcept
+    {
+        shards_[ShardSelector::index() & (numShards - 1)].value.fetch_add(value.get(), std::memory_order_relaxed);
+        return *this;
+    }
+
+    /// returns the sum over all shards
+    [[nodiscard]] NamedTypeT load() const noexcept
+    {
+        T sum{};
+        for (const auto& shard : shards_)
+        {
+            sum += shard.value.load(std::memory_order_relaxed);
+        }
+        return NamedTypeT(sum);
+    }
+
+    /// sets all shards to zero. Additions that happen concurrently may or may not be lost
+    void reset() noexcept
+    {
+        for (auto& shard : shards_)
+        {
+            shard.value.store(T{}, std::memory_order_relaxed);
+        }
+    }
+
+    /// returns the sum over all shards and resets them. Concurrent additions are counted exactly once
+    NamedTypeT exchange() noexcept
+    {
+        T sum{};
+        for (auto& shard : shards_)
+        {
+            sum += shard.value.exchange(T{}, std::memory_order_relaxed);
+        }
+        return NamedTypeT(sum);
+    }
+
+  private:
+    std::array<Shard, numShards> shards_{};
+};
+
+}  // namespace zbo
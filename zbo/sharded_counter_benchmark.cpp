@@ -0,0 +1,60 @@
+#include "sharded_counter.h"
+
+#include <benchmark/benchmark.h>
+
+namespace zbo::bench {
+
+struct Bytes : public NamedType<uint64_t, Bytes>, Addition<Bytes>
+{
+    using NamedType::NamedType;
+};
+
+constexpr int MAX_THREADS = 64;
+
+std::atomic<uint64_t> atomicCounter{0};
+ShardedCounter<Bytes> perThreadCounter;
+ShardedCounter<Bytes, 64, PerCpuShard> perCpuCounter;
+
+void singleAtomic(benchmark::State& state)
+{
+    for (auto _ : state)
+    {
+        atomicCounter.fetch_add(1, std::memory_order_relaxed);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+void shardedPerThread(benchmark::State& state)
+{
+    for (auto _ : state)
+    {
+        perThreadCounter += Bytes{1};
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+void shardedPerCpu(benchmark::State& state)
+{
+    for (auto _ : state)
+    {
+        perCpuCounter += Bytes{1};
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+void shardedLoad(benchmark::State& state)
+{
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(perThreadCounter.load());
+    }
+}
+
+BENCHMARK(singleAtomic)->ThreadRange(1, MAX_THREADS)->UseRealTime();
+BENCHMARK(shardedPerThread)->ThreadRange(1, MAX_THREADS)->UseRealTime();
+BENCHMARK(shardedPerCpu)->ThreadRange(1, MAX_THREADS)->UseRealTime();
+BENCHMARK(shardedLoad);
+
+}  // namespace zbo::bench
+
+BENCHMARK_MAIN();
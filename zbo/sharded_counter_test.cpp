@@ -0,0 +1,69 @@
+#include "sharded_counter.h"
+
+#include <gtest/gtest.h>
+
+#include <thread>
+#include <vector>
+
+namespace zbo::test {
+
+struct Bytes : public NamedType<uint64_t, Bytes>, Addition<Bytes>, EqualityComparable<Bytes>
+{
+    using NamedType::NamedType;
+};
+
+static_assert(sizeof(ShardedCounter<Bytes, 4>) == 4 * CACHE_LINE_SIZE, "Every shard occupies one cache line");
+static_assert(alignof(ShardedCounter<Bytes, 4>) == CACHE_LINE_SIZE, "Shards are aligned to cache lines");
+
+TEST(ShardedCounter, AddLoad)
+{
+    ShardedCounter<Bytes> counter;
+    ASSERT_EQ(counter.load(), Bytes{0});
+    counter += Bytes{5};
+    counter += Bytes{7};
+    ASSERT_EQ(counter.load(), Bytes{12});
+
+    counter.reset();
+    ASSERT_EQ(counter.load(), Bytes{0});
+}
+
+template <typename Counter>
+void addFromThreads(Counter& counter, size_t numThreads, size_t addsPerThread)
+{
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < numThreads; ++i)
+    {
+        threads.emplace_back([&counter, addsPerThread]() {
+            for (size_t j = 0; j < addsPerThread; ++j)
+            {
+                counter += Bytes{2};
+            }
+        });
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+}
+
+TEST(ShardedCounter, ConcurrentAdds)
+{
+    // more threads than shards, so some threads share a shard
+    constexpr size_t NUM_THREADS = 12;
+    constexpr size_t ADDS_PER_THREAD = 10000;
+    ShardedCounter<Bytes, 8> counter;
+    addFromThreads(counter, NUM_THREADS, ADDS_PER_THREAD);
+    ASSERT_EQ(counter.load(), Bytes{2 * NUM_THREADS * ADDS_PER_THREAD});
+}
+
+TEST(ShardedCounter, ConcurrentAddsPerCpu)
+{
+    constexpr size_t NUM_THREADS = 4;
+    constexpr size_t ADDS_PER_THREAD = 10000;
+    ShardedCounter<Bytes, 16, PerCpuShard> counter;
+    addFromThreads(counter, NUM_THREADS, ADDS_PER_THREAD);
+    ASSERT_EQ(counter.exchange(), Bytes{2 * NUM_THREADS * ADDS_PER_THREAD});
+    ASSERT_EQ(counter.load(), Bytes{0});
+}
+
+}  // namespace zbo::test
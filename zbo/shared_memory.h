@@ -0,0 +1,735 @@
+// MIT License
+//
+// Copyright (c) 2020 Lenzebo
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#pragma once
+
+#include "cache_line.h"
+#include "contracts.h"
+#include "id_map.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <initializer_list>
+#include <limits>
+#include <memory>
+#include <new>
+#include <optional>
+#include <span>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace zbo {
+
+/**
+ * @brief Pointer that stores the distance to its target relative to its own address, so it stays valid when the
+ *        memory holding both is mapped at different addresses, e.g. in a SharedMemorySegment of another process
+ *
+ * Copies point to the same target, as the distance is recomputed. Only point to objects in the same mapping.
+ */
+template <typename T>
+class OffsetPtr
+{
+  public:
+    OffsetPtr() = default;
+    OffsetPtr(T* target) noexcept { set(target); }  // NOLINT (hicpp-explicit-conversions) like a raw pointer
+    OffsetPtr(const OffsetPtr& other) noexcept { set(other.get()); }
+    OffsetPtr& operator=(const OffsetPtr& other) noexcept
+    {
+        set(other.get());
+        return *this;
+    }
+    OffsetPtr& operator=(T* target) noexcept
+    {
+        set(target);
+        return *this;
+    }
+    ~OffsetPtr() = default;
+
+    [[nodiscard]] T* get() const noexcept
+    {
+        // NOLINTNEXTLINE (cppcoreguidelines-pro-type-reinterpret-cast, performance-no-int-to-ptr)
+        return offset_ == NULL_OFFSET ? nullptr : reinterpret_cast<T*>(reinterpret_cast<intptr_t>(this) + offset_);
+    }
+    [[nodiscard]] T* operator->() const noexcept { return get(); }
+    [[nodiscard]] T& operator*() const noexcept { return *get(); }
+    [[nodiscard]] T& operator[](size_t idx) const noexcept { return get()[idx]; }
+    [[nodiscard]] explicit operator bool() const noexcept { return offset_ != NULL_OFFSET; }
+
+  private:
+    /// pointing to itself is never useful, so the offset 0 is used for nullptr
+    static constexpr intptr_t NULL_OFFSET = 0;
+
+    void set(T* target) noexcept
+    {
+        // NOLINTNEXTLINE (cppcoreguidelines-pro-type-reinterpret-cast)
+        const intptr_t self = reinterpret_cast<intptr_t>(this);
+        // NOLINTNEXTLINE (cppcoreguidelines-pro-type-reinterpret-cast)
+        offset_ = target == nullptr ? NULL_OFFSET : reinterpret_cast<intptr_t>(target) - self;
+    }
+
+    intptr_t offset_ = NULL_OFFSET;
+};
+
+/// layout of the header at the start of every SharedMemorySegment
+namespace shared_segment {
+
+constexpr std::array<char, 8> MAGIC{'Z', 'B', 'O', 'S', 'H', 'M', 'E', 'M'};
+/// incremented on every change of the header below
+constexpr uint32_t VERSION = 1;
+constexpr size_t NAME_SIZE = 48;
+constexpr size_t MAX_OBJECTS = 32;
+
+struct Object
+{
+    std::array<char, NAME_SIZE> name{};
+    uint64_t offset = 0;
+    uint64_t layout = 0;
+    std::atomic<uint32_t> ready{0};
+};
+
+struct Header
+{
+    std::array<char, 8> magic = MAGIC;
+    uint32_t version = VERSION;
+    uint32_t headerSize = sizeof(Header);
+    uint64_t size = 0;
+    std::atomic<uint64_t> used{0};
+    std::atomic<uint32_t> numObjects{0};
+    std::array<Object, MAX_OBJECTS> objects{};
+};
+
+}  // namespace shared_segment
+
+namespace detail {
+
+constexpr uint64_t FNV_OFFSET = 0xcbf29ce484222325ULL;
+constexpr uint64_t FNV_PRIME = 0x100000001b3ULL;
+
+/// FNV-1a over the values, to combine sizes and versions into a layout fingerprint
+constexpr uint64_t layoutHash(std::initializer_list<uint64_t> values) noexcept
+{
+    uint64_t hash = FNV_OFFSET;
+    for (uint64_t value : values)
+    {
+        for (int byte = 0; byte < 8; ++byte)
+        {
+            hash = (hash ^ ((value >> (8 * byte)) & 0xffU)) * FNV_PRIME;
+        }
+    }
+    return hash;
+}
+
+/// FNV-1a over the name of T as spelled by the compiler, so processes need to be built with the same compiler
+template <typename T>
+constexpr uint64_t typeHash() noexcept
+{
+#if defined(_MSC_VER)
+    constexpr std::string_view NAME = __FUNCSIG__;
+#else
+    constexpr std::string_view NAME = __PRETTY_FUNCTION__;
+#endif
+    uint64_t hash = FNV_OFFSET;
+    for (char c : NAME)
+    {
+        hash = (hash ^ static_cast<uint8_t>(c)) * FNV_PRIME;
+    }
+    return hash;
+}
+
+/// shared containers define their layout and allocate their storage from the segment they are constructed in
+template <typename T>
+concept SharedContainer = requires {
+    {
+        T::sharedLayout()
+    } -> std::same_as<uint64_t>;
+};
+
+/// types can define a SHARED_LAYOUT_VERSION to change when their members change, but neither their name nor size
+template <typename T>
+constexpr uint64_t sharedLayoutVersion() noexcept
+{
+    if constexpr (requires { T::SHARED_LAYOUT_VERSION; })
+    {
+        return static_cast<uint64_t>(T::SHARED_LAYOUT_VERSION);
+    }
+    else
+    {
+        return 0;
+    }
+}
+
+/**
+ * @brief Fingerprint of the type of an object in shared memory: its name (including the element types of
+ *        containers), its size and alignment, and the layout of shared containers or a SHARED_LAYOUT_VERSION
+ */
+template <typename T>
+constexpr uint64_t sharedLayout() noexcept
+{
+    if constexpr (SharedContainer<T>)
+    {
+        return layoutHash({typeHash<T>(), sharedLayoutVersion<T>(), T::sharedLayout()});
+    }
+    else
+    {
+        static_assert(std::is_trivially_copyable_v<T>, "objects in shared memory need to be trivially copyable");
+        return layoutHash({typeHash<T>(), sharedLayoutVersion<T>(), sizeof(T), alignof(T)});
+    }
+}
+
+}  // namespace detail
+
+/**
+ * @brief Shared memory that processes map to use the same objects in place, without serializing them
+ *
+ * A segment is either named (shm_open) and opened by name in other processes, or anonymous (memfd_create on Linux)
+ * and shared by passing its file descriptor, e.g. to a forked child or over a unix socket. It starts with a versioned
+ * header holding a directory of named objects. construct() places an object into the segment and find() looks it up
+ * in any process, which checks that the object has the type the caller expects: the same type name, including the
+ * element types of containers, the same sizes and container versions, and the same SHARED_LAYOUT_VERSION if the type
+ * defines one. Changes to the members of a struct that keep its name and size are only detected through the latter.
+ *
+ * Objects are mapped at different addresses in every process, so they must not contain pointers. Trivially copyable
+ * objects, e.g. a MaxSizeVector of trivially copyable elements, can be placed as they are. SharedVector, SharedIdMap
+ * and SharedSpscRing use OffsetPtr to size their storage at runtime. Objects in a segment are never destroyed.
+ *
+ * Usage:
+ *   auto segment = SharedMemorySegment::create("/book", 1 << 20);
+ *   auto* levels = segment->construct<SharedVector<Level>>("levels", 64);
+ *
+ *   // other process
+ *   auto segment = SharedMemorySegment::open("/book");
+ *   const auto* levels = segment->find<SharedVector<Level>>("levels");
+ */
+class SharedMemorySegment
+{
+  public:
+    /// creates a new named segment of size bytes, returns nothing if it exists already or cannot be created
+    static std::optional<SharedMemorySegment> create(const char* name, size_t size)
+    {
+        // NOLINTNEXTLINE (hicpp-signed-bitwise)
+        const int file = ::shm_open(name, O_RDWR | O_CREAT | O_EXCL, 0600);
+        if (file < 0)
+        {
+            return std::nullopt;
+        }
+        auto segment = initialize(file, size);
+        if (!segment)
+        {
+            ::shm_unlink(name);
+        }
+        return segment;
+    }
+
+    /// opens a named segment, returns nothing if it does not exist or has an incompatible header
+    static std::optional<SharedMemorySegment> open(const char* name)
+    {
+        const int file = ::shm_open(name, O_RDWR, 0);
+        return file < 0 ? std::nullopt : attach(file);
+    }
+
+    /// removes the name of a segment, mappings stay valid until they are unmapped
+    static bool remove(const char* name) { return ::shm_unlink(name) == 0; }
+
+    /// creates an anonymous segment, which is shared by passing file() to other processes
+    static std::optional<SharedMemorySegment> createAnonymous(size_t size)
+    {
+#ifdef __linux__
+        const int file = ::memfd_create("zbo_shared_memory", 0);
+        return file < 0 ? std::nullopt : initialize(file, size);
+#else
+        (void)size;
+        return std::nullopt;
+#endif
+    }
+
+    /// maps the segment of a file descriptor, e.g. of createAnonymous() in the parent process, and takes ownership
+    static std::optional<SharedMemorySegment> openFile(int file) { return attach(file); }
+
+    SharedMemorySegment(const SharedMemorySegment&) = delete;
+    SharedMemorySegment& operator=(const SharedMemorySegment&) = delete;
+    SharedMemorySegment(SharedMemorySegment&& other) noexcept
+        : file_(std::exchange(other.file_, -1)), header_(std::exchange(other.header_, nullptr))
+    {
+    }
+    SharedMemorySegment& operator=(SharedMemorySegment&& other) noexcept
+    {
+        std::swap(file_, other.file_);
+        std::swap(header_, other.header_);
+        return *this;
+    }
+    ~SharedMemorySegment()
+    {
+        if (header_ != nullptr)
+        {
+            ::munmap(header_, header_->size);
+        }
+        if (file_ >= 0)
+        {
+            ::close(file_);
+        }
+    }
+
+    [[nodiscard]] int file() const noexcept { return file_; }
+    [[nodiscard]] size_t size() const noexcept { return header_->size; }
+    [[nodiscard]] std::byte* data() const noexcept { return reinterpret_cast<std::byte*>(header_); }  // NOLINT
+    /// bytes used by the header and all objects
+    [[nodiscard]] size_t used() const noexcept { return header_->used.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief creates an object under name, which needs to be unique in the segment
+     *
+     * Passes the segment as first argument to the constructor of shared containers, which allocate their storage from
+     * it.
+     */
+    template <typename T, typename... Args>
+    T* construct(std::string_view name, Args&&... args)
+    {
+        ZBO_PRECONDITION(name.size() < shared_segment::NAME_SIZE)
+        ZBO_PRECONDITION(findObject(name) == nullptr)
+        const uint32_t idx = header_->numObjects.fetch_add(1, std::memory_order_relaxed);
+        ZBO_PRECONDITION(idx < shared_segment::MAX_OBJECTS)
+
+        T* object = allocate<T>(1);
+        if constexpr (detail::SharedContainer<T>)
+        {
+            new (object) T(*this, std::forward<Args>(args)...);
+        }
+        else
+        {
+            new (object) T(std::forward<Args>(args)...);
+        }
+        auto& entry = header_->objects[idx];
+        std::copy(name.begin(), name.end(), entry.name.begin());
+        entry.offset = static_cast<uint64_t>(reinterpret_cast<std::byte*>(object) - data());  // NOLINT
+        entry.layout = detail::sharedLayout<T>();
+        entry.ready.store(1, std::memory_order_release);
+        return object;
+    }
+
+    /// returns the object with name, or nullptr if there is none or it has a different layout than T
+    template <typename T>
+    [[nodiscard]] T* find(std::string_view name) const noexcept
+    {
+        const shared_segment::Object* entry = findObject(name);
+        if (entry == nullptr || entry->layout != detail::sharedLayout<T>())
+        {
+            return nullptr;
+        }
+        return reinterpret_cast<T*>(data() + entry->offset);  // NOLINT (cppcoreguidelines-pro-type-reinterpret-cast)
+    }
+
+    /// storage for count objects of T, for containers that live in the segment
+    template <typename T>
+    T* allocate(size_t count)
+    {
+        uint64_t used = header_->used.load(std::memory_order_relaxed);
+        uint64_t begin = 0;
+        do
+        {
+            begin = (used + alignof(T) - 1) & ~(uint64_t{alignof(T)} - 1);
+            // divides instead of multiplying count, which would wrap for huge counts and write past the mapping
+            ZBO_PRECONDITION(begin <= header_->size && count <= (header_->size - begin) / sizeof(T))
+        } while (!header_->used.compare_exchange_weak(used, begin + count * sizeof(T), std::memory_order_relaxed));
+        return reinterpret_cast<T*>(data() + begin);  // NOLINT (cppcoreguidelines-pro-type-reinterpret-cast)
+    }
+
+  private:
+    SharedMemorySegment(int file, shared_segment::Header* header) : file_(file), header_(header) {}
+
+    static void* map(int file, size_t size)
+    {
+        void* memory = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, file, 0);  // NOLINT
+        return memory == MAP_FAILED ? nullptr : memory;  // NOLINT (cppcoreguidelines-pro-type-cstyle-cast)
+    }
+
+    static std::optional<SharedMemorySegment> initialize(int file, size_t size)
+    {
+        // rejects undersized segments before mapping them, as there is no failure after a successful map
+        const bool fits = size >= sizeof(shared_segment::Header);
+        void* memory = fits && ::ftruncate(file, static_cast<off_t>(size)) == 0 ? map(file, size) : nullptr;
+        if (memory == nullptr)
+        {
+            ::close(file);
+            return std::nullopt;
+        }
+        auto* header = new (memory) shared_segment::Header();
+        header->size = size;
+        header->used.store(sizeof(shared_segment::Header), std::memory_order_release);
+        return SharedMemorySegment(file, header);
+    }
+
+    static std::optional<SharedMemorySegment> attach(int file)
+    {
+        struct stat status = {};
+        const bool hasHeader = ::fstat(file, &status) == 0 &&
+                               static_cast<size_t>(status.st_size) >= sizeof(shared_segment::Header);
+        void* memory = hasHeader ? map(file, static_cast<size_t>(status.st_size)) : nullptr;
+        auto* header = static_cast<shared_segment::Header*>(memory);
+        if (header == nullptr || header->magic != shared_segment::MAGIC || header->version != shared_segment::VERSION ||
+            header->headerSize != sizeof(shared_segment::Header) || header->size != static_cast<size_t>(status.st_size))
+        {
+            if (memory != nullptr)
+            {
+                ::munmap(memory, static_cast<size_t>(status.st_size));
+            }
+            ::close(file);
+            return std::nullopt;
+        }
+        return SharedMemorySegment(file, header);
+    }
+
+    [[nodiscard]] const shared_segment::Object* findObject(std::string_view name) const noexcept
+    {
+        const uint32_t numObjects = std::min<uint32_t>(header_->numObjects.load(std::memory_order_relaxed),
+                                                       shared_segment::MAX_OBJECTS);
+        for (uint32_t idx = 0; idx < numObjects; ++idx)
+        {
+            const auto& entry = header_->objects[idx];
+            if (entry.ready.load(std::memory_order_acquire) != 0 && std::string_view(entry.name.data()) == name)
+            {
+                return &entry;
+            }
+        }
+        return nullptr;
+    }
+
+    int file_ = -1;
+    shared_segment::Header* header_ = nullptr;
+};
+
+/**
+ * @brief MaxSizeVector whose capacity is chosen when it is created in a SharedMemorySegment
+ *
+ * Processes need to synchronize their accesses, e.g. by handing over the vector through a SharedSpscRing.
+ */
+template <typename T>
+class SharedVector
+{
+    static_assert(std::is_trivially_copyable_v<T>, "elements in shared memory need to be trivially copyable");
+
+  public:
+    using value_type = T;  // NOLINT (readability-identifier-naming)
+
+    static constexpr uint64_t sharedLayout() noexcept
+    {
+        constexpr uint64_t LAYOUT_VERSION = 1;
+        return detail::layoutHash({LAYOUT_VERSION, sizeof(SharedVector), sizeof(T), alignof(T)});
+    }
+
+    SharedVector(SharedMemorySegment& segment, size_t capacity)
+        : data_(segment.allocate<T>(capacity)), capacity_(capacity)
+    {
+    }
+    SharedVector(const SharedVector&) = delete;
+    SharedVector& operator=(const SharedVector&) = delete;
+    ~SharedVector() = default;
+
+    [[nodiscard]] T* begin() noexcept { return data(); }
+    [[nodiscard]] T* end() noexcept { return data() + size_; }
+    [[nodiscard]] const T* begin() const noexcept { return data(); }
+    [[nodiscard]] const T* end() const noexcept { return data() + size_; }
+    [[nodiscard]] T* data() noexcept { return data_.get(); }
+    [[nodiscard]] const T* data() const noexcept { return data_.get(); }
+
+    [[nodiscard]] bool empty() const noexcept { return size_ == 0; }
+    [[nodiscard]] size_t size() const noexcept { return size_; }
+    [[nodiscard]] size_t capacity() const noexcept { return capacity_; }
+
+    [[nodiscard]] T& operator[](size_t idx)
+    {
+        ZBO_PRECONDITION(idx < size_)
+        return data_[idx];
+    }
+    [[nodiscard]] const T& operator[](size_t idx) const
+    {
+        ZBO_PRECONDITION(idx < size_)
+        return data_[idx];
+    }
+
+    void push_back(const T& value)  // NOLINT (readability-identifier-naming)
+    {
+        ZBO_PRECONDITION(size_ < capacity_)
+        data_[size_++] = value;
+    }
+    void pop_back()  // NOLINT (readability-identifier-naming)
+    {
+        ZBO_PRECONDITION(size_ > 0)
+        --size_;
+    }
+    void clear() noexcept { size_ = 0; }
+
+    /// replaces the contents with values, e.g. to publish a snapshot
+    void assign(std::span<const T> values)
+    {
+        ZBO_PRECONDITION(values.size() <= capacity_)
+        std::copy(values.begin(), values.end(), data());
+        size_ = values.size();
+    }
+
+  private:
+    OffsetPtr<T> data_;
+    uint64_t capacity_ = 0;
+    uint64_t size_ = 0;
+};
+
+/**
+ * @brief IdMap with a fixed capacity that is chosen when it is created in a SharedMemorySegment
+ *
+ * Uses the same open addressing with linear probing and backward shift erasure as IdMap, but never grows. All
+ * processes need to use the same Hash. Processes need to synchronize their accesses.
+ */
+template <typename Id, typename T, typename Hash = detail::UnderlyingHash<Id>>
+class SharedIdMap
+{
+    static_assert(std::is_trivially_copyable_v<Id> && std::is_trivially_copyable_v<T>,
+                  "keys and values in shared memory need to be trivially copyable");
+
+    static constexpr uint64_t EMPTY = 0;
+
+    struct Slot
+    {
+        uint64_t hash = EMPTY;
+        Id id{};
+        T value{};
+    };
+
+  public:
+    using key_type = Id;     // NOLINT (readability-identifier-naming)
+    using mapped_type = T;   // NOLINT (readability-identifier-naming)
+
+    static constexpr uint64_t sharedLayout() noexcept
+    {
+        constexpr uint64_t LAYOUT_VERSION = 1;
+        return detail::layoutHash(
+            {LAYOUT_VERSION, sizeof(SharedIdMap), sizeof(Slot), alignof(Slot), sizeof(Id), sizeof(T), alignof(T)});
+    }
+
+    /// reserves enough slots to keep the load below 3/4 with maxSize elements
+    SharedIdMap(SharedMemorySegment& segment, size_t maxSize)
+        : maxSize_(maxSize), numSlots_(slotsFor(maxSize))
+    {
+        Slot* slots = segment.allocate<Slot>(numSlots_);
+        std::uninitialized_fill_n(slots, numSlots_, Slot{});
+        slots_ = slots;
+        shift_ = 64 - static_cast<unsigned>(std::countr_zero(numSlots_));
+    }
+    SharedIdMap(const SharedIdMap&) = delete;
+    SharedIdMap& operator=(const SharedIdMap&) = delete;
+    ~SharedIdMap() = default;
+
+    [[nodiscard]] bool empty() const noexcept { return size_ == 0; }
+    [[nodiscard]] size_t size() const noexcept { return size_; }
+    [[nodiscard]] size_t maxSize() const noexcept { return maxSize_; }
+
+    /// inserts value under id if the id is not yet part of the map, exceeding maxSize is a precondition violation
+    std::pair<T*, bool> insert(const Id& id, const T& value)
+    {
+        const uint64_t hash = hashOf(id);
+        size_t idx = homeIndex(hash);
+        while (slots_[idx].hash != EMPTY)
+        {
+            if (slots_[idx].hash == hash && slots_[idx].id.get() == id.get())
+            {
+                return {&slots_[idx].value, false};
+            }
+            idx = nextIndex(idx);
+        }
+        ZBO_PRECONDITION(size_ < maxSize_)
+        slots_[idx] = Slot{hash, id, value};
+        ++size_;
+        return {&slots_[idx].value, true};
+    }
+
+    [[nodiscard]] T* find(const Id& id) noexcept
+    {
+        const size_t idx = findIndex(id);
+        return idx == numSlots_ ? nullptr : &slots_[idx].value;
+    }
+    [[nodiscard]] const T* find(const Id& id) const noexcept
+    {
+        const size_t idx = findIndex(id);
+        return idx == numSlots_ ? nullptr : &slots_[idx].value;
+    }
+    [[nodiscard]] bool contains(const Id& id) const noexcept { return findIndex(id) != numSlots_; }
+
+    /// removes id from the map and returns the number of removed elements (0 or 1)
+    size_t erase(const Id& id)
+    {
+        size_t hole = findIndex(id);
+        if (hole == numSlots_)
+        {
+            return 0;
+        }
+        // shift back all following entries of the probe sequence that may be moved into the hole
+        for (size_t idx = nextIndex(hole); slots_[idx].hash != EMPTY; idx = nextIndex(idx))
+        {
+            const size_t home = homeIndex(slots_[idx].hash);
+            if (((hole - home) & mask()) < ((idx - home) & mask()))
+            {
+                slots_[hole] = slots_[idx];
+                hole = idx;
+            }
+        }
+        slots_[hole] = Slot{};
+        --size_;
+        return 1;
+    }
+
+    void clear() noexcept
+    {
+        std::fill_n(slots_.get(), numSlots_, Slot{});
+        size_ = 0;
+    }
+
+  private:
+    [[nodiscard]] static uint64_t hashOf(const Id& id) noexcept
+    {
+        constexpr uint64_t FIBONACCI = 0x9E3779B97F4A7C15ULL;
+        return (static_cast<uint64_t>(Hash{}(id)) * FIBONACCI) | 1U;
+    }
+
+    /// bit_ceil is undefined if the result does not fit into size_t, and the load factor overflows before that
+    [[nodiscard]] static size_t slotsFor(size_t maxSize)
+    {
+        ZBO_PRECONDITION(maxSize <= std::numeric_limits<size_t>::max() / 8)
+        return std::bit_ceil(std::max<size_t>(maxSize * 4 / 3 + 1, 2));
+    }
+
+    [[nodiscard]] size_t mask() const noexcept { return numSlots_ - 1; }
+    [[nodiscard]] size_t nextIndex(size_t idx) const noexcept { return (idx + 1) & mask(); }
+    [[nodiscard]] size_t homeIndex(uint64_t hash) const noexcept { return static_cast<size_t>(hash >> shift_); }
+
+    [[nodiscard]] size_t findIndex(const Id& id) const noexcept
+    {
+        const uint64_t hash = hashOf(id);
+        for (size_t idx = homeIndex(hash); slots_[idx].hash != EMPTY; idx = nextIndex(idx))
+        {
+            if (slots_[idx].hash == hash && slots_[idx].id.get() == id.get())
+            {
+                return idx;
+            }
+        }
+        return numSlots_;
+    }
+
+    OffsetPtr<Slot> slots_;
+    uint64_t maxSize_ = 0;
+    uint64_t numSlots_ = 0;
+    uint64_t size_ = 0;
+    uint32_t shift_ = 64;
+};
+
+/**
+ * @brief Single producer, single consumer ring of trivially copyable messages between two processes
+ *
+ * The indices live on separate cache lines, next to a copy of the other index that the producer respectively the
+ * consumer only refreshes when the ring looks full respectively empty.
+ */
+template <typename T>
+class SharedSpscRing
+{
+    static_assert(std::is_trivially_copyable_v<T>, "messages in shared memory need to be trivially copyable");
+    static_assert(std::atomic<uint64_t>::is_always_lock_free, "atomics need to be lock free to work across processes");
+
+  public:
+    static constexpr uint64_t sharedLayout() noexcept
+    {
+        constexpr uint64_t LAYOUT_VERSION = 1;
+        return detail::layoutHash({LAYOUT_VERSION, sizeof(SharedSpscRing), sizeof(T), alignof(T), CACHE_LINE_SIZE});
+    }
+
+    /// capacity is rounded up to a power of two
+    SharedSpscRing(SharedMemorySegment& segment, size_t capacity)
+        : buffer_(segment.allocate<T>(ringCapacity(capacity))), capacity_(std::bit_ceil(capacity))
+    {
+    }
+    SharedSpscRing(const SharedSpscRing&) = delete;
+    SharedSpscRing& operator=(const SharedSpscRing&) = delete;
+    ~SharedSpscRing() = default;
+
+    [[nodiscard]] size_t capacity() const noexcept { return capacity_; }
+
+    /// producer only, returns false if the ring is full
+    bool tryPush(const T& value) noexcept
+    {
+        const uint64_t tail = tail_.load(std::memory_order_relaxed);
+        if (tail - cachedHead_ == capacity_)
+        {
+            cachedHead_ = head_.load(std::memory_order_acquire);
+            if (tail - cachedHead_ == capacity_)
+            {
+                return false;
+            }
+        }
+        buffer_[tail & (capacity_ - 1)] = value;
+        tail_.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    /// consumer only, returns nothing if the ring is empty
+    std::optional<T> tryPop() noexcept
+    {
+        const uint64_t head = head_.load(std::memory_order_relaxed);
+        if (head == cachedTail_)
+        {
+            cachedTail_ = tail_.load(std::memory_order_acquire);
+            if (head == cachedTail_)
+            {
+                return std::nullopt;
+            }
+        }
+        T value = buffer_[head & (capacity_ - 1)];
+        head_.store(head + 1, std::memory_order_release);
+        return value;
+    }
+
+  private:
+    /// bit_ceil is undefined if the result does not fit into size_t
+    [[nodiscard]] static size_t ringCapacity(size_t capacity)
+    {
+        ZBO_PRECONDITION(capacity <= size_t{1} << (std::numeric_limits<size_t>::digits - 1))
+        return std::bit_ceil(capacity);
+    }
+
+    alignas(CACHE_LINE_SIZE) std::atomic<uint64_t> tail_{0};
+    uint64_t cachedHead_ = 0;
+    alignas(CACHE_LINE_SIZE) std::atomic<uint64_t> head_{0};
+    uint64_t cachedTail_ = 0;
+    alignas(CACHE_LINE_SIZE) OffsetPtr<T> buffer_;
+    uint64_t capacity_ = 0;
+};
+
+}  // namespace zbo
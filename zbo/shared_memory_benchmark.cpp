@@ -0,0 +1,166 @@
+#include "shared_memory.h"
+
+#include <benchmark/benchmark.h>
+
+#include <array>
+
+#include <sched.h>
+#include <sys/socket.h>
+#include <sys/wait.h>
+
+namespace zbo::bench {
+
+/// a small message, e.g. an order or a quote
+struct Message
+{
+    int64_t sequence;
+    std::array<int64_t, 7> payload;
+};
+static_assert(sizeof(Message) == 64);
+
+constexpr int64_t STOP = -1;
+
+template <typename F>
+pid_t forkChild(F&& child)
+{
+    const pid_t pid = ::fork();
+    if (pid == 0)
+    {
+        child();
+        ::_exit(0);
+    }
+    return pid;
+}
+
+/// spins while the other process has not answered, yields as the processes may share a core
+template <typename F>
+void spinUntil(F&& done)
+{
+    while (!done())
+    {
+        ::sched_yield();
+    }
+}
+
+void readFully(int file, Message& message)
+{
+    auto* data = reinterpret_cast<char*>(&message);  // NOLINT (cppcoreguidelines-pro-type-reinterpret-cast)
+    for (size_t done = 0; done < sizeof(Message);)
+    {
+        const ssize_t bytes = ::read(file, data + done, sizeof(Message) - done);
+        if (bytes <= 0)
+        {
+            ::_exit(1);
+        }
+        done += static_cast<size_t>(bytes);
+    }
+}
+
+void writeFully(int file, const Message& message)
+{
+    if (::write(file, &message, sizeof(Message)) != static_cast<ssize_t>(sizeof(Message)))
+    {
+        ::_exit(1);
+    }
+}
+
+/// round trip of a message to another process and back through two SharedSpscRing in shared memory
+void sharedMemoryRoundTrip(benchmark::State& state)
+{
+    auto segment = SharedMemorySegment::createAnonymous(1 << 20);
+    auto* requests = segment->construct<SharedSpscRing<Message>>("requests", 64);
+    auto* responses = segment->construct<SharedSpscRing<Message>>("responses", 64);
+    const pid_t child = forkChild([&] {
+        auto attached = SharedMemorySegment::openFile(::dup(segment->file()));
+        auto* childRequests = attached->find<SharedSpscRing<Message>>("requests");
+        auto* childResponses = attached->find<SharedSpscRing<Message>>("responses");
+        std::optional<Message> message;
+        do
+        {
+            spinUntil([&] { return (message = childRequests->tryPop()).has_value(); });
+            spinUntil([&] { return childResponses->tryPush(*message); });
+        } while (message->sequence != STOP);
+    });
+
+    Message message{};
+    for (auto _ : state)
+    {
+        ++message.sequence;
+        spinUntil([&] { return requests->tryPush(message); });
+        std::optional<Message> response;
+        spinUntil([&] { return (response = responses->tryPop()).has_value(); });
+        benchmark::DoNotOptimize(response);
+    }
+    message.sequence = STOP;
+    spinUntil([&] { return requests->tryPush(message); });
+    ::waitpid(child, nullptr, 0);
+    state.SetItemsProcessed(state.iterations());
+}
+
+/// round trip of a message through a pair of files, e.g. pipes or a socket
+template <typename F>
+void fileRoundTrip(benchmark::State& state, int toChild, int fromParent, int toParent, int fromChild, F&& closeAll)
+{
+    const pid_t child = forkChild([&] {
+        Message message{};
+        do
+        {
+            readFully(fromParent, message);
+            writeFully(toParent, message);
+        } while (message.sequence != STOP);
+    });
+
+    Message message{};
+    for (auto _ : state)
+    {
+        ++message.sequence;
+        writeFully(toChild, message);
+        readFully(fromChild, message);
+        benchmark::DoNotOptimize(message);
+    }
+    message.sequence = STOP;
+    writeFully(toChild, message);
+    readFully(fromChild, message);
+    ::waitpid(child, nullptr, 0);
+    closeAll();
+    state.SetItemsProcessed(state.iterations());
+}
+
+void pipeRoundTrip(benchmark::State& state)
+{
+    std::array<int, 2> requests{};
+    std::array<int, 2> responses{};
+    if (::pipe(requests.data()) != 0 || ::pipe(responses.data()) != 0)
+    {
+        state.SkipWithError("cannot create pipes");
+        return;
+    }
+    fileRoundTrip(state, requests[1], requests[0], responses[1], responses[0], [&] {
+        for (int file : {requests[0], requests[1], responses[0], responses[1]})
+        {
+            ::close(file);
+        }
+    });
+}
+
+void socketRoundTrip(benchmark::State& state)
+{
+    std::array<int, 2> sockets{};
+    if (::socketpair(AF_UNIX, SOCK_STREAM, 0, sockets.data()) != 0)
+    {
+        state.SkipWithError("cannot create sockets");
+        return;
+    }
+    fileRoundTrip(state, sockets[0], sockets[1], sockets[1], sockets[0], [&] {
+        ::close(sockets[0]);
+        ::close(sockets[1]);
+    });
+}
+
+BENCHMARK(sharedMemoryRoundTrip)->UseRealTime();
+BENCHMARK(pipeRoundTrip)->UseRealTime();
+BENCHMARK(socketRoundTrip)->UseRealTime();
+
+}  // namespace zbo::bench
+
+BENCHMARK_MAIN();
@@ -0,0 +1,332 @@
+#include "shared_memory.h"
+
+#include "max_size_vector.h"
+
+#include <gtest/gtest.h>
+
+#include <limits>
+#include <string>
+#include <vector>
+
+#include <sys/wait.h>
+
+namespace zbo::test {
+
+using OrderId = NamedType<int64_t, struct OrderIdTag>;
+
+struct Level
+{
+    double price;
+    int64_t quantity;
+};
+
+/// unique per test and process, as shared memory names are global
+std::string segmentName(const char* test)
+{
+    return "/zbo_shared_memory_test_" + std::string(test) + "_" + std::to_string(::getpid());
+}
+
+/// removes the name of the segment at the end of a test, mappings stay valid
+struct RemoveSegment
+{
+    std::string name;
+    ~RemoveSegment() { SharedMemorySegment::remove(name.c_str()); }
+};
+
+TEST(OffsetPtr, PointsToTheSameTargetAfterCopies)
+{
+    std::array<int, 4> values{1, 2, 3, 4};
+    OffsetPtr<int> ptr;
+    ASSERT_FALSE(ptr);
+    ASSERT_EQ(ptr.get(), nullptr);
+    ptr = &values[1];
+    ASSERT_TRUE(ptr);
+    ASSERT_EQ(*ptr, 2);
+    ASSERT_EQ(ptr[2], 4);
+
+    std::vector<OffsetPtr<int>> copies(3, ptr);
+    copies.emplace_back(ptr);
+    for (const auto& copy : copies)
+    {
+        ASSERT_EQ(copy.get(), &values[1]);
+    }
+    ptr = nullptr;
+    ASSERT_FALSE(ptr);
+}
+
+TEST(SharedMemorySegment, ContainersWorkThroughAnotherMapping)
+{
+    const RemoveSegment remove{segmentName("mapping")};
+    auto segment = SharedMemorySegment::create(remove.name.c_str(), 1 << 16);
+    ASSERT_TRUE(segment);
+    auto* levels = segment->construct<SharedVector<Level>>("levels", 8);
+    auto* orders = segment->construct<SharedIdMap<OrderId, Level>>("orders", 100);
+    auto* ring = segment->construct<SharedSpscRing<int>>("ring", 3);
+    auto* fixed = segment->construct<MaxSizeVector<int, 4>>("fixed");
+    ASSERT_EQ(ring->capacity(), 4);
+    levels->push_back(Level{100.5, 3});
+    levels->push_back(Level{100.0, 7});
+    orders->insert(OrderId(17), Level{99.5, 1});
+    fixed->push_back(42);
+
+    // the second mapping of the same segment is at another address, like in another process
+    auto other = SharedMemorySegment::open(remove.name.c_str());
+    ASSERT_TRUE(other);
+    ASSERT_NE(other->data(), segment->data());
+    ASSERT_EQ(other->size(), segment->size());
+    auto* otherLevels = other->find<SharedVector<Level>>("levels");
+    auto* otherOrders = other->find<SharedIdMap<OrderId, Level>>("orders");
+    auto* otherRing = other->find<SharedSpscRing<int>>("ring");
+    auto* otherFixed = other->find<MaxSizeVector<int, 4>>("fixed");
+    ASSERT_NE(otherLevels, nullptr);
+    ASSERT_NE(otherOrders, nullptr);
+    ASSERT_NE(otherRing, nullptr);
+    ASSERT_NE(otherFixed, nullptr);
+
+    ASSERT_EQ(otherLevels->size(), 2);
+    ASSERT_EQ((*otherLevels)[1].quantity, 7);
+    ASSERT_EQ(otherOrders->find(OrderId(17))->price, 99.5);
+    ASSERT_EQ(otherFixed->back(), 42);
+    otherLevels->pop_back();
+    ASSERT_EQ(levels->size(), 1);
+
+    for (int idx = 0; idx < 10; ++idx)
+    {
+        ASSERT_TRUE(ring->tryPush(idx));
+        ASSERT_EQ(otherRing->tryPop(), idx);
+    }
+    for (int idx = 0; idx < 4; ++idx)
+    {
+        ASSERT_TRUE(ring->tryPush(idx));
+    }
+    ASSERT_FALSE(ring->tryPush(4));
+    ASSERT_EQ(otherRing->tryPop(), 0);
+    ASSERT_TRUE(ring->tryPush(4));
+}
+
+TEST(SharedMemorySegment, FindChecksNameAndLayout)
+{
+    auto segment = SharedMemorySegment::createAnonymous(1 << 16);
+    ASSERT_TRUE(segment);
+    segment->construct<SharedVector<int64_t>>("values", 4);
+    segment->construct<SharedIdMap<OrderId, int>>("orders", 4);
+    ASSERT_NE(segment->find<SharedVector<int64_t>>("values"), nullptr);
+    ASSERT_EQ(segment->find<SharedVector<int64_t>>("value"), nullptr);
+    ASSERT_EQ(segment->find<SharedVector<int32_t>>("values"), nullptr);
+    ASSERT_EQ(segment->find<SharedSpscRing<int64_t>>("values"), nullptr);
+    ASSERT_EQ((segment->find<SharedIdMap<OrderId, int64_t>>("orders")), nullptr);
+    ASSERT_EQ((segment->find<MaxSizeVector<int64_t, 4>>("values")), nullptr);
+}
+
+struct Quote
+{
+    int32_t bid;
+    int32_t ask;
+};
+
+struct Trade
+{
+    int32_t price;
+    int32_t quantity;
+};
+
+struct VersionedTrade
+{
+    static constexpr uint32_t SHARED_LAYOUT_VERSION = 2;
+    int32_t price;
+    int32_t quantity;
+};
+
+TEST(SharedMemorySegment, FindChecksTypesOfTheSameSize)
+{
+    auto segment = SharedMemorySegment::createAnonymous(1 << 16);
+    ASSERT_TRUE(segment);
+    segment->construct<SharedVector<int32_t>>("values", 4);
+    segment->construct<Quote>("quote");
+    segment->construct<SharedSpscRing<Trade>>("trades", 4);
+    ASSERT_NE(segment->find<SharedVector<int32_t>>("values"), nullptr);
+    ASSERT_EQ(segment->find<SharedVector<float>>("values"), nullptr);
+    ASSERT_EQ(segment->find<SharedVector<uint32_t>>("values"), nullptr);
+    ASSERT_NE(segment->find<Quote>("quote"), nullptr);
+    ASSERT_EQ(segment->find<Trade>("quote"), nullptr);
+    ASSERT_NE(segment->find<SharedSpscRing<Trade>>("trades"), nullptr);
+    ASSERT_EQ(segment->find<SharedSpscRing<Quote>>("trades"), nullptr);
+
+    static_assert(detail::sharedLayoutVersion<Trade>() == 0);
+    static_assert(detail::sharedLayoutVersion<VersionedTrade>() == 2);
+    static_assert(detail::sharedLayout<Trade>() == detail::sharedLayout<Trade>());
+    static_assert(detail::sharedLayout<Trade>() != detail::sharedLayout<Quote>());
+}
+
+TEST(SharedMemorySegment, RejectsIncompatibleSegments)
+{
+    const RemoveSegment remove{segmentName("incompatible")};
+    ASSERT_FALSE(SharedMemorySegment::open(remove.name.c_str()));
+    auto segment = SharedMemorySegment::create(remove.name.c_str(), 1 << 12);
+    ASSERT_TRUE(segment);
+    ASSERT_FALSE(SharedMemorySegment::create(remove.name.c_str(), 1 << 12));
+    ASSERT_TRUE(SharedMemorySegment::open(remove.name.c_str()));
+
+    auto* header = reinterpret_cast<shared_segment::Header*>(segment->data());  // NOLINT
+    header->version = shared_segment::VERSION + 1;
+    ASSERT_FALSE(SharedMemorySegment::open(remove.name.c_str()));
+    header->version = shared_segment::VERSION;
+    header->magic[0] = 'X';
+    ASSERT_FALSE(SharedMemorySegment::open(remove.name.c_str()));
+    header->magic = shared_segment::MAGIC;
+    ASSERT_TRUE(SharedMemorySegment::open(remove.name.c_str()));
+
+    ASSERT_FALSE(SharedMemorySegment::createAnonymous(sizeof(shared_segment::Header) - 1));
+}
+
+TEST(SharedMemorySegment, ExchangesDataWithAnotherProcess)
+{
+    constexpr int NUM_MESSAGES = 10000;
+    const RemoveSegment remove{segmentName("process")};
+    auto segment = SharedMemorySegment::create(remove.name.c_str(), 1 << 20);
+    ASSERT_TRUE(segment);
+    auto* requests = segment->construct<SharedSpscRing<Level>>("requests", 64);
+    auto* responses = segment->construct<SharedSpscRing<int64_t>>("responses", 64);
+    auto* orders = segment->construct<SharedIdMap<OrderId, Level>>("orders", NUM_MESSAGES);
+
+    const pid_t child = ::fork();
+    ASSERT_GE(child, 0);
+    if (child == 0)
+    {
+        // the child maps the segment again by its name and only uses what it finds there
+        auto attached = SharedMemorySegment::open(remove.name.c_str());
+        auto* childRequests = attached ? attached->find<SharedSpscRing<Level>>("requests") : nullptr;
+        auto* childResponses = attached ? attached->find<SharedSpscRing<int64_t>>("responses") : nullptr;
+        auto* childOrders = attached ? attached->find<SharedIdMap<OrderId, Level>>("orders") : nullptr;
+        if (childRequests == nullptr || childResponses == nullptr || childOrders == nullptr)
+        {
+            ::_exit(1);
+        }
+        for (int64_t idx = 0; idx < NUM_MESSAGES; ++idx)
+        {
+            std::optional<Level> request;
+            while (!(request = childRequests->tryPop()))
+            {
+                ::sched_yield();
+            }
+            childOrders->insert(OrderId(idx), *request);
+            while (!childResponses->tryPush(request->quantity * 2))
+            {
+                ::sched_yield();
+            }
+        }
+        ::_exit(0);
+    }
+
+    int64_t sum = 0;
+    int64_t sent = 0;
+    for (int64_t received = 0; received < NUM_MESSAGES;)
+    {
+        if (sent < NUM_MESSAGES && requests->tryPush(Level{static_cast<double>(sent), sent}))
+        {
+            ++sent;
+        }
+        else if (auto response = responses->tryPop())
+        {
+            ASSERT_EQ(*response, received * 2);
+            sum += *response;
+            ++received;
+        }
+        else
+        {
+            ::sched_yield();
+        }
+    }
+    int status = 0;
+    ASSERT_EQ(::waitpid(child, &status, 0), child);
+    ASSERT_TRUE(WIFEXITED(status));
+    ASSERT_EQ(WEXITSTATUS(status), 0);
+    ASSERT_EQ(sum, int64_t{NUM_MESSAGES} * (NUM_MESSAGES - 1));
+    ASSERT_EQ(orders->size(), NUM_MESSAGES);
+    ASSERT_EQ(orders->find(OrderId(1234))->price, 1234.0);
+}
+
+TEST(SharedMemorySegment, SharesAnonymousSegmentsByFile)
+{
+    auto segment = SharedMemorySegment::createAnonymous(1 << 16);
+    ASSERT_TRUE(segment);
+    auto* values = segment->construct<SharedVector<int>>("values", 16);
+
+    const pid_t child = ::fork();
+    ASSERT_GE(child, 0);
+    if (child == 0)
+    {
+        // maps the inherited file again, as a process would that received it over a unix socket
+        auto attached = SharedMemorySegment::openFile(::dup(segment->file()));
+        auto* childValues = attached ? attached->find<SharedVector<int>>("values") : nullptr;
+        if (childValues == nullptr || attached->data() == segment->data())
+        {
+            ::_exit(1);
+        }
+        const std::array<int, 3> primes{2, 3, 5};
+        childValues->assign(primes);
+        ::_exit(0);
+    }
+    int status = 0;
+    ASSERT_EQ(::waitpid(child, &status, 0), child);
+    ASSERT_TRUE(WIFEXITED(status));
+    ASSERT_EQ(WEXITSTATUS(status), 0);
+    ASSERT_EQ(std::vector<int>(values->begin(), values->end()), (std::vector<int>{2, 3, 5}));
+}
+
+TEST(SharedIdMap, InsertsFindsAndErases)
+{
+    auto segment = SharedMemorySegment::createAnonymous(1 << 20);
+    ASSERT_TRUE(segment);
+    auto* map = segment->construct<SharedIdMap<OrderId, int>>("map", 1000);
+    ASSERT_TRUE(map->empty());
+    ASSERT_EQ(map->maxSize(), 1000);
+    for (int idx = 0; idx < 1000; ++idx)
+    {
+        ASSERT_TRUE(map->insert(OrderId(idx * 7), idx).second);
+    }
+    ASSERT_FALSE(map->insert(OrderId(7), 5).second);
+    ASSERT_EQ(*map->find(OrderId(7)), 1);
+    for (int idx = 0; idx < 1000; idx += 2)
+    {
+        ASSERT_EQ(map->erase(OrderId(idx * 7)), 1);
+    }
+    ASSERT_EQ(map->erase(OrderId(0)), 0);
+    ASSERT_EQ(map->size(), 500);
+    for (int idx = 0; idx < 1000; ++idx)
+    {
+        ASSERT_EQ(map->contains(OrderId(idx * 7)), idx % 2 == 1) << idx;
+    }
+    map->clear();
+    ASSERT_TRUE(map->empty());
+    ASSERT_FALSE(map->contains(OrderId(7)));
+}
+
+TEST(SharedMemorySegmentDeathTest, ViolatesPreconditions)
+{
+    auto segment = SharedMemorySegment::createAnonymous(1 << 12);
+    ASSERT_TRUE(segment);
+    auto* values = segment->construct<SharedVector<int>>("values", 1);
+    values->push_back(1);
+    ASSERT_DEATH(values->push_back(2), "");
+    ASSERT_DEATH((void)(*values)[1], "");
+    ASSERT_DEATH((void)segment->construct<SharedVector<int>>("values", 1), "");
+    ASSERT_DEATH((void)segment->construct<SharedVector<int>>("large", 1 << 12), "");
+    auto* map = segment->construct<SharedIdMap<OrderId, int>>("map", 1);
+    map->insert(OrderId(1), 1);
+    ASSERT_DEATH(map->insert(OrderId(2), 2), "");
+}
+
+TEST(SharedMemorySegmentDeathTest, RejectsCapacitiesThatOverflow)
+{
+    constexpr size_t MAX = std::numeric_limits<size_t>::max();
+    using Map = SharedIdMap<OrderId, int>;
+    auto segment = SharedMemorySegment::createAnonymous(1 << 16);
+    ASSERT_TRUE(segment);
+    ASSERT_DEATH((void)segment->construct<SharedVector<uint64_t>>("vector", MAX / 8 + 2), "");
+    ASSERT_DEATH((void)segment->construct<SharedSpscRing<uint64_t>>("ring", MAX / 2 + 2), "");
+    ASSERT_DEATH((void)segment->construct<SharedSpscRing<uint64_t>>("ring", MAX / 16 + 2), "");
+    ASSERT_DEATH((void)segment->construct<Map>("map", MAX / 4), "");
+}
+
+}  // namespace zbo::test
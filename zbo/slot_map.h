@@ -0,0 +1,226 @@
+// MIT License
+//
+// Copyright (c) 2020 Lenzebo
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#pragma once
+
+#include "contracts.h"
+#include "max_size_vector.h"
+#include "named_type.h"
+
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+#include <utility>
+
+namespace zbo {
+
+/**
+ * @brief Pool with a fixed capacity that hands out stable handles to its elements, while keeping the elements densely
+ *        packed in a MaxSizeVector, so it never allocates.
+ *
+ * Insert, erase and lookup by handle are O(1). Erasing moves the last element into the gap, so iterating over the
+ * elements never skips holes, but the order of the elements is not stable. A handle consists of the index of a slot
+ * and the generation of that slot, which is increased whenever the element in the slot is erased. This way, a handle
+ * of an erased element is detected as stale, even if its slot has been reused by a later insert.
+ *
+ * Usage:
+ *   SlotMap<Connection, 1024> connections;
+ *   const auto handle = connections.insert(Connection{socket});
+ *   if (Connection* connection = connections.find(handle)) { connection->send(data); }
+ *   connections.erase(handle);
+ *   for (Connection& connection : connections) { connection.poll(); }
+ *
+ * @tparam T element type, needs to be default constructible
+ * @tparam maxSize maximum number of elements
+ */
+template <typename T, size_t maxSize>
+class SlotMap
+{
+  public:
+    using value_type = T;             // NOLINT (readability-identifier-naming)
+    using size_type = size_t;         // NOLINT (readability-identifier-naming)
+    using iterator = T*;              // NOLINT (readability-identifier-naming)
+    using const_iterator = const T*;  // NOLINT (readability-identifier-naming)
+    /// slot index in the lower and generation of the slot in the upper 32 bits
+    struct Handle : NamedType<uint64_t, Handle>, EqualityComparable<Handle>
+    {
+        using NamedType<uint64_t, Handle>::NamedType;
+    };
+
+    static_assert(maxSize < std::numeric_limits<uint32_t>::max(), "slot indices need to fit into 32 bits");
+
+    constexpr SlotMap() = default;
+
+    [[nodiscard]] constexpr size_t size() const noexcept { return values_.size(); }
+    [[nodiscard]] constexpr bool empty() const noexcept { return values_.empty(); }
+    [[nodiscard]] constexpr bool full() const noexcept { return size() == capacity(); }
+    [[nodiscard]] static constexpr size_t capacity() noexcept { return maxSize; }
+
+    /// returns whether handle refers to an element in the map, i.e. is neither stale nor default constructed
+    [[nodiscard]] constexpr bool contains(Handle handle) const noexcept
+    {
+        const uint32_t slot = slotOf(handle);
+        return slot < nextSlot_ && slots_[slot].generation == generationOf(handle) && isOccupied(slots_[slot]);
+    }
+
+    /// returns the element referred to by handle or nullptr if the handle is stale
+    [[nodiscard]] constexpr T* find(Handle handle) noexcept
+    {
+        return contains(handle) ? &values_.data()[slots_[slotOf(handle)].index] : nullptr;
+    }
+    [[nodiscard]] constexpr const T* find(Handle handle) const noexcept
+    {
+        return contains(handle) ? &values_.data()[slots_[slotOf(handle)].index] : nullptr;
+    }
+
+    [[nodiscard]] constexpr T& operator[](Handle handle)
+    {
+        ZBO_PRECONDITION(contains(handle))
+        return values_.data()[slots_[slotOf(handle)].index];
+    }
+    [[nodiscard]] constexpr const T& operator[](Handle handle) const
+    {
+        ZBO_PRECONDITION(contains(handle))
+        return values_.data()[slots_[slotOf(handle)].index];
+    }
+
+    constexpr Handle insert(const T& value) { return emplace(value); }
+    constexpr Handle insert(T&& value) { return emplace(std::move(value)); }
+
+    template <typename... Args>
+    constexpr Handle emplace(Args&&... args)
+    {
+        ZBO_PRECONDITION(!full())
+        const uint32_t slotIdx = allocateSlot();
+        Slot& slot = slots_[slotIdx];
+        ++slot.generation;
+        slot.index = static_cast<uint32_t>(values_.size());
+        values_.push_back(T(std::forward<Args>(args)...));
+        denseToSlot_[slot.index] = slotIdx;
+        return makeHandle(slotIdx, slot.generation);
+    }
+
+    /// removes the element referred to by handle and returns false if the handle is stale
+    constexpr bool erase(Handle handle)
+    {
+        if (!contains(handle))
+        {
+            return false;
+        }
+        const uint32_t slotIdx = slotOf(handle);
+        Slot& slot = slots_[slotIdx];
+        const uint32_t last = static_cast<uint32_t>(values_.size() - 1);
+        if (slot.index != last)
+        {
+            values_.data()[slot.index] = std::move(values_.back());
+            denseToSlot_[slot.index] = denseToSlot_[last];
+            slots_[denseToSlot_[last]].index = slot.index;
+        }
+        if constexpr (!std::is_trivially_destructible_v<T>)
+        {
+            // release resources held by the moved from element now instead of when its place is reused
+            values_.back() = T();
+        }
+        values_.pop_back();
+        freeSlot(slotIdx);
+        return true;
+    }
+
+    /// removes all elements and invalidates all handles
+    constexpr void clear()
+    {
+        while (!empty())
+        {
+            erase(handleAt(size() - 1));
+        }
+    }
+
+    /// handle of the element at position idx of the dense storage, e.g. to erase elements while iterating
+    [[nodiscard]] constexpr Handle handleAt(size_t idx) const
+    {
+        ZBO_PRECONDITION(idx < size())
+        const uint32_t slotIdx = denseToSlot_[idx];
+        return makeHandle(slotIdx, slots_[slotIdx].generation);
+    }
+
+    [[nodiscard]] constexpr T* data() noexcept { return values_.data(); }
+    [[nodiscard]] constexpr const T* data() const noexcept { return values_.data(); }
+    [[nodiscard]] constexpr iterator begin() noexcept { return values_.begin(); }
+    [[nodiscard]] constexpr iterator end() noexcept { return values_.end(); }
+    [[nodiscard]] constexpr const_iterator begin() const noexcept { return values_.begin(); }
+    [[nodiscard]] constexpr const_iterator end() const noexcept { return values_.end(); }
+
+  private:
+    struct Slot
+    {
+        /// index into values_ while occupied, next free slot otherwise
+        uint32_t index = 0;
+        /// odd while occupied, increased on every insert and erase
+        uint32_t generation = 0;
+    };
+
+    static constexpr uint32_t NO_SLOT = std::numeric_limits<uint32_t>::max();
+
+    [[nodiscard]] static constexpr uint32_t slotOf(Handle handle) noexcept
+    {
+        return static_cast<uint32_t>(handle.get() & std::numeric_limits<uint32_t>::max());
+    }
+    [[nodiscard]] static constexpr uint32_t generationOf(Handle handle) noexcept
+    {
+        return static_cast<uint32_t>(handle.get() >> 32U);
+    }
+    [[nodiscard]] static constexpr Handle makeHandle(uint32_t slot, uint32_t generation) noexcept
+    {
+        return Handle((uint64_t{generation} << 32U) | slot);
+    }
+    [[nodiscard]] static constexpr bool isOccupied(const Slot& slot) noexcept { return (slot.generation & 1U) != 0; }
+
+    constexpr uint32_t allocateSlot() noexcept
+    {
+        if (freeHead_ != NO_SLOT)
+        {
+            const uint32_t slot = freeHead_;
+            freeHead_ = slots_[slot].index;
+            return slot;
+        }
+        return nextSlot_++;
+    }
+
+    constexpr void freeSlot(uint32_t slotIdx) noexcept
+    {
+        Slot& slot = slots_[slotIdx];
+        ++slot.generation;
+        slot.index = freeHead_;
+        freeHead_ = slotIdx;
+    }
+
+    MaxSizeVector<T, maxSize> values_;
+    std::array<uint32_t, maxSize> denseToSlot_{};
+    std::array<Slot, maxSize> slots_{};
+    /// slots up to nextSlot_ have been used before, the ones after are untouched
+    uint32_t nextSlot_ = 0;
+    uint32_t freeHead_ = NO_SLOT;
+};
+
+}  // namespace zbo
@@ -0,0 +1,206 @@
+#include "slot_map.h"
+
+#include <benchmark/benchmark.h>
+
+#include <memory>
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+namespace zbo::bench {
+
+struct Particle
+{
+    double x = 0.0;
+    double y = 0.0;
+    double vx = 1.0;
+    double vy = 1.0;
+};
+
+template <size_t capacity>
+struct SlotMapPool
+{
+    using Handle = typename SlotMap<Particle, capacity>::Handle;
+
+    Handle insert(const Particle& particle) { return map.insert(particle); }
+    void erase(Handle handle) { map.erase(handle); }
+    Particle* find(Handle handle) { return map.find(handle); }
+
+    template <typename Callback>
+    void forEach(Callback&& callback)
+    {
+        for (Particle& particle : map)
+        {
+            callback(particle);
+        }
+    }
+
+    SlotMap<Particle, capacity> map;
+};
+
+template <size_t capacity>
+struct UnorderedMapPool
+{
+    using Handle = uint64_t;
+
+    Handle insert(const Particle& particle)
+    {
+        map.emplace(nextId, particle);
+        return nextId++;
+    }
+    void erase(Handle handle) { map.erase(handle); }
+    Particle* find(Handle handle)
+    {
+        auto it = map.find(handle);
+        return it == map.end() ? nullptr : &it->second;
+    }
+
+    template <typename Callback>
+    void forEach(Callback&& callback)
+    {
+        for (auto& [id, particle] : map)
+        {
+            callback(particle);
+        }
+    }
+
+    std::unordered_map<uint64_t, Particle> map;
+    uint64_t nextId = 0;
+};
+
+/// the index into the vector is the handle, erased elements leave a nullptr behind that is reused by the next insert
+template <size_t capacity>
+struct UniquePtrPool
+{
+    using Handle = size_t;
+
+    UniquePtrPool() { particles.reserve(capacity); }
+
+    Handle insert(const Particle& particle)
+    {
+        if (freeList.empty())
+        {
+            particles.push_back(std::make_unique<Particle>(particle));
+            return particles.size() - 1;
+        }
+        const Handle handle = freeList.back();
+        freeList.pop_back();
+        particles[handle] = std::make_unique<Particle>(particle);
+        return handle;
+    }
+    void erase(Handle handle)
+    {
+        particles[handle].reset();
+        freeList.push_back(handle);
+    }
+    Particle* find(Handle handle) { return particles[handle].get(); }
+
+    template <typename Callback>
+    void forEach(Callback&& callback)
+    {
+        for (auto& particle : particles)
+        {
+            if (particle)
+            {
+                callback(*particle);
+            }
+        }
+    }
+
+    std::vector<std::unique_ptr<Particle>> particles;
+    std::vector<Handle> freeList;
+};
+
+/// fills the pool to 75% of its capacity and erases and inserts random elements for a while to shuffle the memory
+template <typename Pool, size_t capacity>
+std::vector<typename Pool::Handle> fill(Pool& pool, std::mt19937_64& gen)
+{
+    std::vector<typename Pool::Handle> handles;
+    for (size_t idx = 0; idx < capacity * 3 / 4; ++idx)
+    {
+        handles.push_back(pool.insert(Particle{}));
+    }
+    for (size_t idx = 0; idx < capacity; ++idx)
+    {
+        auto& handle = handles[gen() % handles.size()];
+        pool.erase(handle);
+        handle = pool.insert(Particle{});
+    }
+    return handles;
+}
+
+/// replaces a random element with a new one, like entities that are spawned and destroyed all the time
+template <template <size_t> class Pool, size_t capacity>
+void churn(benchmark::State& state)
+{
+    std::mt19937_64 gen{42};
+    auto pool = std::make_unique<Pool<capacity>>();
+    auto handles = fill<Pool<capacity>, capacity>(*pool, gen);
+    for (auto _ : state)
+    {
+        auto& handle = handles[gen() % handles.size()];
+        pool->erase(handle);
+        handle = pool->insert(Particle{});
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+template <template <size_t> class Pool, size_t capacity>
+void lookup(benchmark::State& state)
+{
+    std::mt19937_64 gen{42};
+    auto pool = std::make_unique<Pool<capacity>>();
+    const auto handles = fill<Pool<capacity>, capacity>(*pool, gen);
+    for (auto _ : state)
+    {
+        Particle* particle = pool->find(handles[gen() % handles.size()]);
+        particle->x += particle->vx;
+        benchmark::DoNotOptimize(particle);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+template <template <size_t> class Pool, size_t capacity>
+void iterate(benchmark::State& state)
+{
+    std::mt19937_64 gen{42};
+    auto pool = std::make_unique<Pool<capacity>>();
+    const auto handles = fill<Pool<capacity>, capacity>(*pool, gen);
+    for (auto _ : state)
+    {
+        pool->forEach([](Particle& particle) {
+            particle.x += particle.vx;
+            particle.y += particle.vy;
+        });
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * handles.size());
+}
+
+constexpr size_t SMALL = 1024;
+constexpr size_t LARGE = 65536;
+
+BENCHMARK_TEMPLATE(churn, SlotMapPool, SMALL);
+BENCHMARK_TEMPLATE(churn, UnorderedMapPool, SMALL);
+BENCHMARK_TEMPLATE(churn, UniquePtrPool, SMALL);
+BENCHMARK_TEMPLATE(churn, SlotMapPool, LARGE);
+BENCHMARK_TEMPLATE(churn, UnorderedMapPool, LARGE);
+BENCHMARK_TEMPLATE(churn, UniquePtrPool, LARGE);
+
+BENCHMARK_TEMPLATE(lookup, SlotMapPool, SMALL);
+BENCHMARK_TEMPLATE(lookup, UnorderedMapPool, SMALL);
+BENCHMARK_TEMPLATE(lookup, UniquePtrPool, SMALL);
+BENCHMARK_TEMPLATE(lookup, SlotMapPool, LARGE);
+BENCHMARK_TEMPLATE(lookup, UnorderedMapPool, LARGE);
+BENCHMARK_TEMPLATE(lookup, UniquePtrPool, LARGE);
+
+BENCHMARK_TEMPLATE(iterate, SlotMapPool, SMALL);
+BENCHMARK_TEMPLATE(iterate, UnorderedMapPool, SMALL);
+BENCHMARK_TEMPLATE(iterate, UniquePtrPool, SMALL);
+BENCHMARK_TEMPLATE(iterate, SlotMapPool, LARGE);
+BENCHMARK_TEMPLATE(iterate, UnorderedMapPool, LARGE);
+BENCHMARK_TEMPLATE(iterate, UniquePtrPool, LARGE);
+
+}  // namespace zbo::bench
+
+BENCHMARK_MAIN();
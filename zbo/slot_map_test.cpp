@@ -0,0 +1,147 @@
+#include "slot_map.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <map>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace zbo::test {
+
+TEST(SlotMap, InsertFindErase)
+{
+    SlotMap<std::string, 4> map;
+    ASSERT_TRUE(map.empty());
+    const auto first = map.insert("first");
+    const auto second = map.emplace(3, 'x');
+    ASSERT_EQ(map.size(), 2);
+    ASSERT_EQ(map[first], "first");
+    ASSERT_EQ(map[second], "xxx");
+    ASSERT_NE(first, second);
+
+    map[first] += "!";
+    ASSERT_EQ(*map.find(first), "first!");
+
+    ASSERT_TRUE(map.erase(first));
+    ASSERT_FALSE(map.contains(first));
+    ASSERT_EQ(map.find(first), nullptr);
+    ASSERT_FALSE(map.erase(first));
+    ASSERT_EQ(map.size(), 1);
+    ASSERT_EQ(map[second], "xxx");
+}
+
+TEST(SlotMap, StaleHandlesAreDetectedAfterSlotReuse)
+{
+    SlotMap<int, 2> map;
+    const auto old = map.insert(1);
+    map.erase(old);
+    const auto reused = map.insert(2);
+    // same slot, different generation
+    ASSERT_EQ(reused.get() & 0xFFFFFFFFU, old.get() & 0xFFFFFFFFU);
+    ASSERT_FALSE(map.contains(old));
+    ASSERT_TRUE(map.contains(reused));
+    ASSERT_FALSE(map.erase(old));
+    ASSERT_EQ(map[reused], 2);
+
+    ASSERT_FALSE(map.contains(SlotMap<int, 2>::Handle(0)));
+    ASSERT_FALSE(map.contains(SlotMap<int, 2>::Handle(12345)));
+}
+
+TEST(SlotMap, ValuesStayDense)
+{
+    SlotMap<int, 8> map;
+    std::vector<SlotMap<int, 8>::Handle> handles;
+    for (int idx = 0; idx < 8; ++idx)
+    {
+        handles.push_back(map.insert(idx));
+    }
+    ASSERT_TRUE(map.full());
+    map.erase(handles[2]);
+    map.erase(handles[5]);
+
+    std::vector<int> values(map.begin(), map.end());
+    std::sort(values.begin(), values.end());
+    ASSERT_EQ(values, (std::vector<int>{0, 1, 3, 4, 6, 7}));
+    for (size_t idx = 0; idx < map.size(); ++idx)
+    {
+        ASSERT_EQ(map[map.handleAt(idx)], map.data()[idx]);
+    }
+}
+
+TEST(SlotMap, ErasingReleasesResources)
+{
+    SlotMap<std::shared_ptr<int>, 4> map;
+    auto value = std::make_shared<int>(1);
+    const auto first = map.insert(value);
+    map.insert(std::make_shared<int>(2));
+    ASSERT_EQ(value.use_count(), 2);
+    map.erase(first);
+    ASSERT_EQ(value.use_count(), 1);
+}
+
+TEST(SlotMap, Clear)
+{
+    SlotMap<int, 4> map;
+    const auto first = map.insert(1);
+    map.insert(2);
+    map.clear();
+    ASSERT_TRUE(map.empty());
+    ASSERT_FALSE(map.contains(first));
+    const auto again = map.insert(3);
+    ASSERT_TRUE(map.contains(again));
+    ASSERT_EQ(map.size(), 1);
+}
+
+TEST(SlotMap, RandomOperationsMatchStdMap)
+{
+    constexpr size_t CAPACITY = 64;
+    using Map = SlotMap<int, CAPACITY>;
+    auto map = std::make_unique<Map>();
+    std::map<uint64_t, int> expected;
+    std::vector<Map::Handle> erased;
+    std::mt19937 rng(42);  // NOLINT (cert-msc51-cpp) deterministic on purpose
+    for (int value = 0; value < 100'000; ++value)
+    {
+        if (!map->full() && (expected.empty() || rng() % 2 == 0))
+        {
+            expected[map->insert(value).get()] = value;
+        }
+        else
+        {
+            auto it = std::next(expected.begin(), static_cast<long>(rng() % expected.size()));
+            const Map::Handle handle(it->first);
+            ASSERT_TRUE(map->erase(handle));
+            erased.push_back(handle);
+            expected.erase(it);
+        }
+        ASSERT_EQ(map->size(), expected.size());
+    }
+    for (const auto& [handle, value] : expected)
+    {
+        ASSERT_EQ((*map)[Map::Handle(handle)], value);
+    }
+    for (const auto handle : erased)
+    {
+        ASSERT_FALSE(map->contains(handle));
+    }
+}
+
+TEST(SlotMapDeathTest, AccessWithStaleHandle)
+{
+    SlotMap<int, 2> map;
+    const auto handle = map.insert(1);
+    map.erase(handle);
+    ASSERT_DEATH((void)map[handle], "");
+}
+
+TEST(SlotMapDeathTest, InsertIntoFullMap)
+{
+    SlotMap<int, 1> map;
+    map.insert(1);
+    ASSERT_DEATH((void)map.insert(2), "");
+}
+
+}  // namespace zbo::test
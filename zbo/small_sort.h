@@ -0,0 +1,248 @@
+// MIT License
+//
+// Copyright (c) 2020 Lenzebo
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#pragma once
+
+#include "max_size_vector.h"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <span>
+#include <type_traits>
+#include <utility>
+
+namespace zbo {
+
+/// up to this size arithmetic values that are sorted with std::less are sorted with branchless networks
+constexpr size_t SMALL_SORT_MIN_MAX_NETWORK_SIZE = 32;
+/// up to this size other values, or values sorted by a projection, are sorted with networks of compares and exchanges
+constexpr size_t SMALL_SORT_NETWORK_SIZE = 8;
+/// up to this size smallSort uses insertion sort when no network is used, and std::sort above
+constexpr size_t SMALL_SORT_INSERTION_SIZE = 16;
+
+namespace detail {
+
+struct Comparator
+{
+    uint8_t lhs = 0;
+    uint8_t rhs = 0;
+};
+
+/**
+ * @brief Batcher's odd-even merge sort network for size elements
+ *
+ * The network is built for the next power of two and all comparators that touch an index behind size are dropped,
+ * which is the same as padding the input with elements that are larger than all others.
+ */
+template <size_t size>
+constexpr auto sortingNetwork()
+{
+    constexpr size_t PADDED = std::bit_ceil(size);
+    // Batcher's network for 2^k elements has (k^2 - k + 4) * 2^(k-2) - 1 comparators
+    constexpr size_t K = std::bit_width(PADDED) - 1;
+    MaxSizeVector<Comparator, (K * K - K + 4) * PADDED / 4> network;
+    for (size_t p = 1; p < PADDED; p *= 2)
+    {
+        for (size_t k = p; k >= 1; k /= 2)
+        {
+            for (size_t j = k % p; j + k < PADDED; j += 2 * k)
+            {
+                for (size_t i = 0; i < std::min(k, PADDED - j - k); ++i)
+                {
+                    if ((i + j) / (2 * p) == (i + j + k) / (2 * p) && i + j + k < size)
+                    {
+                        network.push_back(Comparator{static_cast<uint8_t>(i + j), static_cast<uint8_t>(i + j + k)});
+                    }
+                }
+            }
+        }
+    }
+    return network;
+}
+
+template <size_t size>
+inline constexpr auto SORTING_NETWORK = sortingNetwork<size>();
+
+/// std::less on arithmetic values, which is done with branchless selects
+template <typename T, typename Compare, typename Projection>
+constexpr bool IS_MIN_MAX_SORTABLE =
+    std::is_arithmetic_v<T> && std::is_same_v<Projection, std::identity> &&
+    (std::is_same_v<Compare, std::ranges::less> || std::is_same_v<Compare, std::less<>> ||
+     std::is_same_v<Compare, std::less<T>>);
+
+/// branchless selects are cheaper than compares and exchanges, which pays off for larger networks
+template <typename T, typename Compare, typename Projection>
+constexpr size_t NETWORK_SIZE =
+    IS_MIN_MAX_SORTABLE<T, Compare, Projection> ? SMALL_SORT_MIN_MAX_NETWORK_SIZE : SMALL_SORT_NETWORK_SIZE;
+
+template <typename T, typename Compare, typename Projection>
+void compareExchange(T& lhs, T& rhs, Compare& comp, Projection& proj)
+{
+    if constexpr (IS_MIN_MAX_SORTABLE<T, Compare, Projection>)
+    {
+        // selects on copies from a single comparison, so that values that compare equal (-0.0 and 0.0) or unordered
+        // (NaN) are kept as they are, compilers turn references into branches otherwise
+        const T first = lhs;
+        const T second = rhs;
+        const bool swap = second < first;
+        lhs = swap ? second : first;
+        rhs = swap ? first : second;
+    }
+    else if constexpr (std::is_trivially_copyable_v<T>)
+    {
+        // selects instead of swapping, which compilers turn into conditional moves more often
+        const bool swap = std::invoke(comp, std::invoke(proj, rhs), std::invoke(proj, lhs));
+        const T low = swap ? rhs : lhs;
+        rhs = swap ? lhs : rhs;
+        lhs = low;
+    }
+    else if (std::invoke(comp, std::invoke(proj, rhs), std::invoke(proj, lhs)))
+    {
+        std::swap(lhs, rhs);
+    }
+}
+
+template <size_t size, typename T, typename Compare, typename Projection>
+void networkSort(T* data, Compare& comp, Projection& proj)
+{
+    [&]<size_t... index>(std::index_sequence<index...>)
+    {
+        constexpr const auto& NETWORK = SORTING_NETWORK<size>;
+        (compareExchange(data[NETWORK[index].lhs], data[NETWORK[index].rhs], comp, proj), ...);
+    }
+    (std::make_index_sequence<SORTING_NETWORK<size>.size()>{});
+}
+
+template <typename T, typename Compare, typename Projection>
+void insertionSort(T* data, size_t size, Compare& comp, Projection& proj)
+{
+    for (size_t idx = 1; idx < size; ++idx)
+    {
+        T value = std::move(data[idx]);
+        size_t pos = idx;
+        for (; pos > 0 && std::invoke(comp, std::invoke(proj, value), std::invoke(proj, data[pos - 1])); --pos)
+        {
+            data[pos] = std::move(data[pos - 1]);
+        }
+        data[pos] = std::move(value);
+    }
+}
+
+template <typename T, typename Compare, typename Projection>
+void fallbackSort(T* data, size_t size, Compare& comp, Projection& proj)
+{
+    if (size <= SMALL_SORT_INSERTION_SIZE)
+    {
+        insertionSort(data, size, comp, proj);
+    }
+    else
+    {
+        std::sort(data, data + size, [&comp, &proj](const T& lhs, const T& rhs) {
+            return std::invoke(comp, std::invoke(proj, lhs), std::invoke(proj, rhs));
+        });
+    }
+}
+
+/// sorts size elements, at most maxSize, with the network for exactly size elements if there is one
+template <size_t maxSize, typename T, typename Compare, typename Projection>
+void smallSort(T* data, size_t size, Compare& comp, Projection& proj)
+{
+    constexpr size_t MAX_NETWORK = std::min(maxSize, NETWORK_SIZE<T, Compare, Projection>);
+    if (size <= MAX_NETWORK)
+    {
+        [&]<size_t... networkSize>(std::index_sequence<networkSize...>)
+        {
+            (void)((size == networkSize && (networkSort<networkSize>(data, comp, proj), true)) || ...);
+        }
+        (std::make_index_sequence<MAX_NETWORK + 1>{});
+    }
+    else
+    {
+        fallbackSort(data, size, comp, proj);
+    }
+}
+
+/// sorts exactly size elements, which only instantiates the network for that size
+template <size_t size, typename T, typename Compare, typename Projection>
+void fixedSizeSort(T* data, Compare& comp, Projection& proj)
+{
+    if constexpr (size <= NETWORK_SIZE<T, Compare, Projection>)
+    {
+        networkSort<size>(data, comp, proj);
+    }
+    else
+    {
+        fallbackSort(data, size, comp, proj);
+    }
+}
+
+}  // namespace detail
+
+/**
+ * @brief Sorts containers of a few elements faster than std::sort, by using the compile time maximum size
+ *
+ * Small sizes are sorted with a sorting network, i.e. a fixed sequence of compare and exchange steps without data
+ * dependent branches, so there are no mispredictions. Arithmetic values that are sorted with std::less are exchanged
+ * with selects, which compile to conditional moves or SIMD blends, up to SMALL_SORT_MIN_MAX_NETWORK_SIZE elements.
+ * Other values, or values sorted by a projection, use networks up to SMALL_SORT_NETWORK_SIZE elements. Only the
+ * networks up to the maximum size of the container are instantiated, and only the one for the actual size runs.
+ * Larger sizes fall back to insertion sort up to SMALL_SORT_INSERTION_SIZE and std::sort above. Like std::sort, the
+ * sort is not stable, but the result is always a permutation of the input, also with signed zeros or NaN.
+ *
+ * Takes a comparison and a projection like std::ranges::sort.
+ *
+ * Usage:
+ *   MaxSizeVector<Level, 32> levels = ...;
+ *   smallSort(levels, std::greater<>(), &Level::price);
+ */
+template <typename T, size_t maxSize, typename Compare = std::ranges::less, typename Projection = std::identity>
+void smallSort(MaxSizeVector<T, maxSize>& values, Compare comp = {}, Projection proj = {})
+{
+    detail::smallSort<maxSize>(values.data(), values.size(), comp, proj);
+}
+
+template <typename T, size_t size, typename Compare = std::ranges::less, typename Projection = std::identity>
+void smallSort(std::array<T, size>& values, Compare comp = {}, Projection proj = {})
+{
+    detail::fixedSizeSort<size>(values.data(), comp, proj);
+}
+
+/// spans with a dynamic extent instantiate the networks for all sizes
+template <typename T, size_t extent, typename Compare = std::ranges::less, typename Projection = std::identity>
+void smallSort(std::span<T, extent> values, Compare comp = {}, Projection proj = {})
+{
+    if constexpr (extent == std::dynamic_extent)
+    {
+        detail::smallSort<SMALL_SORT_MIN_MAX_NETWORK_SIZE>(values.data(), values.size(), comp, proj);
+    }
+    else
+    {
+        detail::fixedSizeSort<extent>(values.data(), comp, proj);
+    }
+}
+
+}  // namespace zbo
@@ -0,0 +1,140 @@
+#include "small_sort.h"
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+namespace zbo::bench {
+
+constexpr size_t MAX_SIZE = 64;
+constexpr size_t NUM_INPUTS = 1024;
+
+enum Distribution : int64_t
+{
+    RANDOM,
+    SORTED,
+    REVERSED,
+    FEW_UNIQUE
+};
+
+template <typename T>
+std::vector<MaxSizeVector<T, MAX_SIZE>> makeInputs(size_t size, int64_t distribution)
+{
+    std::mt19937 random(42);
+    std::uniform_int_distribution<int> values(distribution == FEW_UNIQUE ? 0 : -1'000'000,
+                                              distribution == FEW_UNIQUE ? 3 : 1'000'000);
+    std::vector<MaxSizeVector<T, MAX_SIZE>> inputs(NUM_INPUTS);
+    for (auto& input : inputs)
+    {
+        for (size_t idx = 0; idx < size; ++idx)
+        {
+            input.push_back(static_cast<T>(values(random)));
+        }
+        if (distribution == SORTED)
+        {
+            std::sort(input.begin(), input.end());
+        }
+        else if (distribution == REVERSED)
+        {
+            std::sort(input.begin(), input.end(), std::greater<>());
+        }
+    }
+    return inputs;
+}
+
+void setLabel(benchmark::State& state)
+{
+    constexpr std::array<const char*, 4> NAMES{"random", "sorted", "reversed", "few unique"};
+    state.SetLabel(NAMES.at(static_cast<size_t>(state.range(1))));
+}
+
+/// every iteration sorts a copy of another input, so the branch predictor cannot learn the input
+template <typename T>
+void stdSort(benchmark::State& state)
+{
+    const auto inputs = makeInputs<T>(static_cast<size_t>(state.range(0)), state.range(1));
+    size_t idx = 0;
+    for (auto _ : state)
+    {
+        auto values = inputs[idx++ % NUM_INPUTS];
+        std::sort(values.begin(), values.end());
+        benchmark::DoNotOptimize(values.data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    setLabel(state);
+}
+
+template <typename T>
+void smallSort(benchmark::State& state)
+{
+    const auto inputs = makeInputs<T>(static_cast<size_t>(state.range(0)), state.range(1));
+    size_t idx = 0;
+    for (auto _ : state)
+    {
+        auto values = inputs[idx++ % NUM_INPUTS];
+        zbo::smallSort(values);
+        benchmark::DoNotOptimize(values.data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    setLabel(state);
+}
+
+struct Level
+{
+    double price;
+    int64_t quantity;
+};
+
+/// order book levels sorted by price, the projection exchanges whole elements
+template <bool useSmallSort>
+void levelsByPrice(benchmark::State& state)
+{
+    const auto prices = makeInputs<double>(static_cast<size_t>(state.range(0)), RANDOM);
+    std::vector<MaxSizeVector<Level, MAX_SIZE>> inputs(NUM_INPUTS);
+    for (size_t input = 0; input < NUM_INPUTS; ++input)
+    {
+        for (double price : prices[input])
+        {
+            inputs[input].push_back(Level{price, 1});
+        }
+    }
+    size_t idx = 0;
+    for (auto _ : state)
+    {
+        auto levels = inputs[idx++ % NUM_INPUTS];
+        if constexpr (useSmallSort)
+        {
+            zbo::smallSort(levels, std::greater<>(), &Level::price);
+        }
+        else
+        {
+            std::ranges::sort(levels, std::greater<>(), &Level::price);
+        }
+        benchmark::DoNotOptimize(levels.data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void bySizeAndDistribution(benchmark::internal::Benchmark* benchmark)
+{
+    for (int64_t distribution : {RANDOM, SORTED, REVERSED, FEW_UNIQUE})
+    {
+        for (int64_t size : {4, 8, 12, 16, 24, 32, 48, 64})
+        {
+            benchmark->Args({size, distribution});
+        }
+    }
+}
+
+BENCHMARK_TEMPLATE(stdSort, int)->Apply(bySizeAndDistribution);
+BENCHMARK_TEMPLATE(smallSort, int)->Apply(bySizeAndDistribution);
+BENCHMARK_TEMPLATE(stdSort, float)->Apply(bySizeAndDistribution);
+BENCHMARK_TEMPLATE(smallSort, float)->Apply(bySizeAndDistribution);
+BENCHMARK_TEMPLATE(levelsByPrice, false)->Arg(8)->Arg(16)->Arg(32);
+BENCHMARK_TEMPLATE(levelsByPrice, true)->Arg(8)->Arg(16)->Arg(32);
+
+}  // namespace zbo::bench
+
+BENCHMARK_MAIN();
@@ -0,0 +1,188 @@
+#include "small_sort.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <iterator>
+#include <limits>
+#include <numeric>
+#include <random>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace zbo::test {
+
+/// a network sorts all inputs if it sorts all inputs of zeros and ones (0-1 principle)
+template <size_t size>
+void expectSortsAllBinaryInputs()
+{
+    for (uint32_t bits = 0; bits < (1U << size); ++bits)
+    {
+        std::array<int, size> values{};
+        for (size_t idx = 0; idx < size; ++idx)
+        {
+            values[idx] = static_cast<int>((bits >> idx) & 1U);
+        }
+        smallSort(values);
+        ASSERT_TRUE(std::is_sorted(values.begin(), values.end())) << size << " " << bits;
+    }
+}
+
+TEST(SmallSort, NetworksSortAllBinaryInputs)
+{
+    // larger networks are only tested with random inputs, as there are too many binary ones
+    [&]<size_t... size>(std::index_sequence<size...>)
+    {
+        (expectSortsAllBinaryInputs<size>(), ...);
+    }
+    (std::make_index_sequence<17>{});
+}
+
+TEST(SmallSort, NetworksAreSmallerThanTheirPaddedSize)
+{
+    static_assert(detail::SORTING_NETWORK<0>.empty());
+    static_assert(detail::SORTING_NETWORK<1>.empty());
+    static_assert(detail::SORTING_NETWORK<2>.size() == 1);
+    static_assert(detail::SORTING_NETWORK<4>.size() == 5);
+    static_assert(detail::SORTING_NETWORK<8>.size() == 19);
+    static_assert(detail::SORTING_NETWORK<16>.size() == 63);
+    static_assert(detail::SORTING_NETWORK<32>.size() == 191);
+    ASSERT_LT(detail::SORTING_NETWORK<9>.size(), detail::SORTING_NETWORK<16>.size());
+}
+
+TEST(SmallSort, SortsMaxSizeVectorsOfAllSizes)
+{
+    std::mt19937 random(42);
+    std::uniform_int_distribution<int> distribution(-50, 50);
+    for (size_t size = 0; size <= 48; ++size)
+    {
+        for (int repetition = 0; repetition < 100; ++repetition)
+        {
+            MaxSizeVector<int, 48> values;
+            for (size_t idx = 0; idx < size; ++idx)
+            {
+                values.push_back(distribution(random));
+            }
+            std::vector<int> expected(values.begin(), values.end());
+            std::sort(expected.begin(), expected.end());
+            smallSort(values);
+            ASSERT_EQ(std::vector<int>(values.begin(), values.end()), expected) << size;
+        }
+    }
+}
+
+TEST(SmallSort, SortsArraysAndSpans)
+{
+    std::array<double, 7> array{3.5, -1.0, 2.0, 2.0, 0.0, 10.0, -7.25};
+    smallSort(array);
+    ASSERT_TRUE(std::is_sorted(array.begin(), array.end()));
+
+    std::vector<int> large(100);
+    std::iota(large.rbegin(), large.rend(), 0);
+    smallSort(std::span(large));
+    ASSERT_TRUE(std::is_sorted(large.begin(), large.end()));
+
+    std::vector<int> small{5, 4, 3, 2, 1, 0};
+    smallSort(std::span(small).first(4));
+    ASSERT_EQ(small, (std::vector<int>{2, 3, 4, 5, 1, 0}));
+    smallSort(std::span(small).last<3>());
+    ASSERT_EQ(small, (std::vector<int>{2, 3, 4, 0, 1, 5}));
+}
+
+TEST(SmallSort, KeepsValuesThatCompareEqualOrUnordered)
+{
+    std::array<double, 2> zeros{0.0, -0.0};
+    smallSort(zeros);
+    ASSERT_FALSE(std::signbit(zeros[0]));
+    ASSERT_TRUE(std::signbit(zeros[1]));
+
+    MaxSizeVector<double, 32> values;
+    for (int idx = 0; idx < 32; ++idx)
+    {
+        values.push_back(idx % 2 == 0 ? 0.0 : -0.0);
+    }
+    smallSort(values);
+    ASSERT_EQ(std::count_if(values.begin(), values.end(), [](double value) { return std::signbit(value); }), 16);
+
+    // the order with NaN is unspecified, but no value may be lost or duplicated
+    std::array<double, 4> withNan{3.0, std::numeric_limits<double>::quiet_NaN(), 1.0, 2.0};
+    smallSort(withNan);
+    ASSERT_EQ(std::count_if(withNan.begin(), withNan.end(), [](double value) { return std::isnan(value); }), 1);
+    std::vector<double> numbers;
+    std::copy_if(withNan.begin(), withNan.end(), std::back_inserter(numbers),
+                 [](double value) { return !std::isnan(value); });
+    std::sort(numbers.begin(), numbers.end());
+    ASSERT_EQ(numbers, (std::vector<double>{1.0, 2.0, 3.0}));
+}
+
+TEST(SmallSort, SortsByProjectedKey)
+{
+    struct Level
+    {
+        double price;
+        int quantity;
+    };
+    MaxSizeVector<Level, 8> levels{{99.0, 1}, {101.5, 2}, {100.0, 3}, {98.5, 4}, {101.0, 5}};
+    smallSort(levels, std::greater<>(), &Level::price);
+    std::vector<int> quantities;
+    for (const auto& level : levels)
+    {
+        quantities.push_back(level.quantity);
+    }
+    ASSERT_EQ(quantities, (std::vector<int>{2, 5, 3, 1, 4}));
+
+    std::array<int, 5> values{-3, 1, -4, 2, 0};
+    smallSort(values, {}, [](int value) { return value * value; });
+    ASSERT_EQ(values, (std::array<int, 5>{0, 1, 2, -3, -4}));
+}
+
+TEST(SmallSort, SortsAllSizesByProjectedKey)
+{
+    struct Pair
+    {
+        int key;
+        int value;
+    };
+    std::mt19937 random(42);
+    std::uniform_int_distribution<int> distribution(-50, 50);
+    for (size_t size = 0; size <= 24; ++size)
+    {
+        for (int repetition = 0; repetition < 100; ++repetition)
+        {
+            MaxSizeVector<Pair, 24> values;
+            for (size_t idx = 0; idx < size; ++idx)
+            {
+                values.push_back(Pair{distribution(random), static_cast<int>(idx)});
+            }
+            std::vector<int> expected;
+            for (const auto& pair : values)
+            {
+                expected.push_back(pair.key);
+            }
+            std::sort(expected.begin(), expected.end(), std::greater<>());
+            smallSort(values, std::greater<>(), &Pair::key);
+            std::vector<int> keys;
+            for (const auto& pair : values)
+            {
+                keys.push_back(pair.key);
+            }
+            ASSERT_EQ(keys, expected) << size;
+        }
+    }
+}
+
+TEST(SmallSort, SortsTypesThatAreNotTriviallyCopyable)
+{
+    MaxSizeVector<std::string, 12> words{"pear", "apple", "fig", "banana", "cherry", "kiwi"};
+    smallSort(words);
+    ASSERT_EQ(std::vector<std::string>(words.begin(), words.end()),
+              (std::vector<std::string>{"apple", "banana", "cherry", "fig", "kiwi", "pear"}));
+    smallSort(words, {}, [](const std::string& word) { return word.size(); });
+    ASSERT_EQ(words.front(), "fig");
+    ASSERT_EQ(words.back().size(), 6);
+}
+
+}  // namespace zbo::test
@@ -0,0 +1,303 @@
+// MIT License
+//
+// Copyright (c) 2020 Lenzebo
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include "contracts.h"
+#include "enum_containers.h"
+#include "meta_enum.h"
+#include "stop_watch.h"
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <initializer_list>
+#include <limits>
+#include <type_traits>
+#include <utility>
+
+namespace zbo {
+
+/**
+ * @brief Transitions of a StateMachine compiled into a dense matrix with one cell per (state, event) pair.
+ *
+ * Each cell stores the index of the next state and the index of the action to run. Events that are not handled in a
+ * state stay in that state and run no action, so dispatching an event does not need to branch on that. The table has
+ * to be constexpr to be used with StateMachine, which allows the machine to call the actions directly instead of
+ * through a function pointer. Declaring the same (from, event) pair twice is a contract violation and therefore a
+ * compile error.
+ *
+ * Usage:
+ *   constexpr TransitionTable<State, Event, Connection> TABLE{
+ *       {State::IDLE, Event::CONNECT, State::CONNECTING, &onConnect},
+ *       {State::CONNECTING, Event::ESTABLISHED, State::CONNECTED},
+ *   };
+ *
+ * @tparam State enum registered with ZBO_ENUM
+ * @tparam Event enum registered with ZBO_ENUM
+ * @tparam Context object passed to the actions
+ */
+template <typename State, typename Event, typename Context>
+class TransitionTable
+{
+  public:
+    using StateType = State;
+    using EventType = Event;
+    using ContextType = Context;
+    using Action = void (*)(Context&, Event);
+
+    struct Transition
+    {
+        State from;
+        Event event;
+        State to;
+        Action action = nullptr;
+    };
+
+    static constexpr size_t NUM_STATES = detail::enumSize<State>();
+    static constexpr size_t NUM_EVENTS = detail::enumSize<Event>();
+    static constexpr size_t NUM_CELLS = NUM_STATES * NUM_EVENTS;
+    /// action index of transitions without action
+    static constexpr uint32_t NO_ACTION = 0;
+
+    struct Cell
+    {
+        uint32_t next = 0;
+        uint16_t action = NO_ACTION;
+        bool handled = false;
+    };
+
+    constexpr TransitionTable(std::initializer_list<Transition> transitions)
+    {
+        for (size_t stateIdx = 0; stateIdx < NUM_STATES; ++stateIdx)
+        {
+            for (size_t eventIdx = 0; eventIdx < NUM_EVENTS; ++eventIdx)
+            {
+                cells_[cellIndex(stateIdx, eventIdx)].next = static_cast<uint32_t>(stateIdx);
+            }
+        }
+
+        for (const Transition& transition : transitions)
+        {
+            Cell& cell = cells_[cellIndex(detail::checkedEnumIndex(transition.from),
+                                          detail::checkedEnumIndex(transition.event))];
+            ZBO_PRECONDITION(!cell.handled)
+            cell.next = static_cast<uint32_t>(detail::checkedEnumIndex(transition.to));
+            cell.action = static_cast<uint16_t>(addAction(transition.action));
+            cell.handled = true;
+        }
+    }
+
+    [[nodiscard]] static constexpr size_t cellIndex(size_t stateIdx, size_t eventIdx) noexcept
+    {
+        return stateIdx * NUM_EVENTS + eventIdx;
+    }
+    [[nodiscard]] constexpr const Cell& cell(size_t idx) const noexcept { return cells_[idx]; }
+
+    /// number of distinct actions including NO_ACTION
+    [[nodiscard]] constexpr size_t numActions() const noexcept { return numActions_; }
+    [[nodiscard]] constexpr Action action(size_t idx) const noexcept { return actions_[idx]; }
+
+    /// returns whether event is handled in state
+    [[nodiscard]] constexpr bool handles(State state, Event event) const
+    {
+        return cells_[cellIndex(detail::checkedEnumIndex(state), detail::checkedEnumIndex(event))].handled;
+    }
+
+  private:
+    static_assert(NUM_STATES <= std::numeric_limits<uint32_t>::max(), "too many states");
+    static_assert(NUM_CELLS < std::numeric_limits<uint16_t>::max(), "too many transitions");
+
+    constexpr size_t addAction(Action action)
+    {
+        if (action == nullptr)
+        {
+            return NO_ACTION;
+        }
+        for (size_t idx = NO_ACTION + 1; idx < numActions_; ++idx)
+        {
+            if (actions_[idx] == action)
+            {
+                return idx;
+            }
+        }
+        actions_[numActions_] = action;
+        return numActions_++;
+    }
+
+    std::array<Cell, NUM_CELLS> cells_{};
+    std::array<Action, NUM_CELLS + 1> actions_{};
+    size_t numActions_ = NO_ACTION + 1;
+};
+
+/// StateMachine option that does not collect any statistics
+struct NoTransitionStats
+{
+};
+
+/// StateMachine option that counts how often every transition was taken
+struct CountTransitions
+{
+};
+
+/// StateMachine option that counts and times every transition (i.e. its action) with StopWatchT<Clock>
+template <typename Clock = std::chrono::steady_clock>
+struct TimeTransitions
+{
+};
+
+namespace detail {
+template <typename Stats, size_t NumCells>
+class TransitionStats;
+
+template <size_t NumCells>
+class TransitionStats<NoTransitionStats, NumCells>
+{
+  public:
+    template <typename Callable>
+    void record(size_t /*cell*/, bool /*handled*/, Callable&& call)
+    {
+        call();
+    }
+};
+
+template <size_t NumCells>
+class TransitionStats<CountTransitions, NumCells>
+{
+  public:
+    template <typename Callable>
+    void record(size_t cell, bool handled, Callable&& call)
+    {
+        counts_[cell] += handled ? 1U : 0U;
+        call();
+    }
+
+    [[nodiscard]] uint64_t count(size_t cell) const noexcept { return counts_[cell]; }
+
+  private:
+    std::array<uint64_t, NumCells> counts_{};
+};
+
+template <typename Clock, size_t NumCells>
+class TransitionStats<TimeTransitions<Clock>, NumCells>
+{
+  public:
+    template <typename Callable>
+    void record(size_t cell, bool handled, Callable&& call)
+    {
+        if (!handled)
+        {
+            return;
+        }
+        ++counts_[cell];
+        StopWatchT<Clock> watch;
+        watch.start();
+        call();
+        durations_[cell] += watch.stop();
+    }
+
+    [[nodiscard]] uint64_t count(size_t cell) const noexcept { return counts_[cell]; }
+    [[nodiscard]] std::chrono::duration<double> duration(size_t cell) const noexcept { return durations_[cell]; }
+
+  private:
+    std::array<uint64_t, NumCells> counts_{};
+    std::array<std::chrono::duration<double>, NumCells> durations_{};
+};
+}  // namespace detail
+
+/**
+ * @brief Finite state machine that dispatches events through a constexpr TransitionTable instead of nested switch
+ *        statements.
+ *
+ * The machine only stores the index of the current state. dispatch() looks up the cell of the current state and event,
+ * switches to the next state and then runs the action of the transition. As the table is a template argument, the
+ * actions are called directly (and can be inlined) through their index.
+ *
+ * Usage:
+ *   StateMachine<TABLE, CountTransitions> machine{State::IDLE};
+ *   machine.dispatch(connection, Event::CONNECT);
+ *   machine.transitionCount(State::IDLE, Event::CONNECT);
+ *
+ * @tparam TABLE constexpr TransitionTable with static storage duration
+ * @tparam Stats NoTransitionStats, CountTransitions or TimeTransitions<Clock>
+ */
+template <const auto& TABLE, typename Stats = NoTransitionStats>
+class StateMachine
+{
+    using Table = std::remove_cvref_t<decltype(TABLE)>;
+
+  public:
+    using State = typename Table::StateType;
+    using Event = typename Table::EventType;
+    using Context = typename Table::ContextType;
+
+    constexpr explicit StateMachine(State initial) : state_(static_cast<uint32_t>(detail::checkedEnumIndex(initial)))
+    {
+    }
+
+    [[nodiscard]] constexpr State state() const { return metaEnum<State>().values[state_]; }
+
+    /// sets the current state without running any action
+    constexpr void reset(State state) { state_ = static_cast<uint32_t>(detail::checkedEnumIndex(state)); }
+
+    /**
+     * @brief takes the transition for event out of the current state and runs its action
+     * @return false if the current state does not handle event, the state is unchanged in that case
+     */
+    bool dispatch(Context& context, Event event)
+    {
+        const size_t cellIdx = Table::cellIndex(state_, detail::checkedEnumIndex(event));
+        const auto& cell = TABLE.cell(cellIdx);
+        state_ = cell.next;
+        stats_.record(cellIdx, cell.handled, [&] {
+            callAction(cell.action, context, event, std::make_index_sequence<TABLE.numActions()>());
+        });
+        return cell.handled;
+    }
+
+    /// number of times the transition for event out of from has been taken
+    [[nodiscard]] uint64_t transitionCount(State from, Event event) const
+        requires(!std::is_same_v<Stats, NoTransitionStats>)
+    {
+        return stats_.count(Table::cellIndex(detail::checkedEnumIndex(from), detail::checkedEnumIndex(event)));
+    }
+
+    /// accumulated time spent in the action of the transition for event out of from
+    [[nodiscard]] std::chrono::duration<double> transitionTime(State from, Event event) const
+        requires(!std::is_same_v<Stats, NoTransitionStats> && !std::is_same_v<Stats, CountTransitions>)
+    {
+        return stats_.duration(Table::cellIndex(detail::checkedEnumIndex(from), detail::checkedEnumIndex(event)));
+    }
+
+  private:
+    template <size_t... I>
+    static void callAction(size_t action, Context& context, Event event, std::index_sequence<I...> /*unused*/)
+    {
+        // I == NO_ACTION is skipped as there is nothing to call
+        ((I != Table::NO_ACTION && action == I && (TABLE.action(I)(context, event), true)) || ...);
+    }
+
+    uint32_t state_;
+    [[no_unique_address]] detail::TransitionStats<Stats, Table::NUM_CELLS> stats_;
+};
+
+}  // namespace zbo
@@ -0,0 +1,169 @@
+#include "state_machine.h"
+
+#include <benchmark/benchmark.h>
+
+#include <random>
+#include <vector>
+
+ZBO_ENUM_CLASS(OrderState, uint8_t, NEW, PENDING, OPEN, PARTIALLY_FILLED, FILLED, CANCEL_PENDING, CANCELED, REJECTED)
+ZBO_ENUM_CLASS(OrderEvent, uint8_t, SUBMIT, ACK, REJECT, PARTIAL_FILL, FILL, CANCEL, CANCEL_ACK, RESET)
+
+namespace zbo::bench {
+
+struct Order
+{
+    int64_t fills = 0;
+    int64_t messages = 0;
+};
+
+void onMessage(Order& order, OrderEvent /*event*/)
+{
+    ++order.messages;
+}
+
+void onFill(Order& order, OrderEvent /*event*/)
+{
+    ++order.fills;
+}
+
+constexpr TransitionTable<OrderState, OrderEvent, Order> TABLE{
+    {OrderState::NEW, OrderEvent::SUBMIT, OrderState::PENDING, &onMessage},
+    {OrderState::PENDING, OrderEvent::ACK, OrderState::OPEN, &onMessage},
+    {OrderState::PENDING, OrderEvent::REJECT, OrderState::REJECTED, &onMessage},
+    {OrderState::OPEN, OrderEvent::PARTIAL_FILL, OrderState::PARTIALLY_FILLED, &onFill},
+    {OrderState::OPEN, OrderEvent::FILL, OrderState::FILLED, &onFill},
+    {OrderState::OPEN, OrderEvent::CANCEL, OrderState::CANCEL_PENDING, &onMessage},
+    {OrderState::PARTIALLY_FILLED, OrderEvent::PARTIAL_FILL, OrderState::PARTIALLY_FILLED, &onFill},
+    {OrderState::PARTIALLY_FILLED, OrderEvent::FILL, OrderState::FILLED, &onFill},
+    {OrderState::PARTIALLY_FILLED, OrderEvent::CANCEL, OrderState::CANCEL_PENDING, &onMessage},
+    {OrderState::CANCEL_PENDING, OrderEvent::FILL, OrderState::FILLED, &onFill},
+    {OrderState::CANCEL_PENDING, OrderEvent::CANCEL_ACK, OrderState::CANCELED, &onMessage},
+    {OrderState::FILLED, OrderEvent::RESET, OrderState::NEW},
+    {OrderState::CANCELED, OrderEvent::RESET, OrderState::NEW},
+    {OrderState::REJECTED, OrderEvent::RESET, OrderState::NEW},
+};
+
+/// the same state machine as it is typically written by hand
+class SwitchOrderMachine
+{
+  public:
+    bool dispatch(Order& order, OrderEvent event)
+    {
+        switch (state_)
+        {
+            case OrderState::NEW:
+                return event == OrderEvent::SUBMIT && message(order, OrderState::PENDING);
+            case OrderState::PENDING:
+                switch (event)
+                {
+                    case OrderEvent::ACK: return message(order, OrderState::OPEN);
+                    case OrderEvent::REJECT: return message(order, OrderState::REJECTED);
+                    default: return false;
+                }
+            case OrderState::OPEN:
+            case OrderState::PARTIALLY_FILLED:
+                switch (event)
+                {
+                    case OrderEvent::PARTIAL_FILL: return fill(order, OrderState::PARTIALLY_FILLED);
+                    case OrderEvent::FILL: return fill(order, OrderState::FILLED);
+                    case OrderEvent::CANCEL: return message(order, OrderState::CANCEL_PENDING);
+                    default: return false;
+                }
+            case OrderState::CANCEL_PENDING:
+                switch (event)
+                {
+                    case OrderEvent::FILL: return fill(order, OrderState::FILLED);
+                    case OrderEvent::CANCEL_ACK: return message(order, OrderState::CANCELED);
+                    default: return false;
+                }
+            case OrderState::FILLED:
+            case OrderState::CANCELED:
+            case OrderState::REJECTED:
+                if (event == OrderEvent::RESET)
+                {
+                    state_ = OrderState::NEW;
+                    return true;
+                }
+                return false;
+        }
+        return false;
+    }
+
+  private:
+    bool message(Order& order, OrderState next)
+    {
+        state_ = next;
+        ++order.messages;
+        return true;
+    }
+    bool fill(Order& order, OrderState next)
+    {
+        state_ = next;
+        ++order.fills;
+        return true;
+    }
+
+    OrderState state_ = OrderState::NEW;
+};
+
+std::vector<OrderEvent> randomEvents()
+{
+    constexpr size_t NUM_EVENTS = 1 << 16;
+    std::mt19937 gen{42};
+    std::uniform_int_distribution<size_t> dist{0, metaEnum<OrderEvent>().size() - 1};
+    std::vector<OrderEvent> events(NUM_EVENTS);
+    for (auto& event : events)
+    {
+        event = metaEnum<OrderEvent>().values[dist(gen)];
+    }
+    return events;
+}
+
+template <typename Machine>
+void runEvents(benchmark::State& state, Machine& machine)
+{
+    const auto events = randomEvents();
+    Order order;
+    for (auto _ : state)
+    {
+        for (auto event : events)
+        {
+            benchmark::DoNotOptimize(machine.dispatch(order, event));
+        }
+    }
+    benchmark::DoNotOptimize(order);
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(events.size()));
+}
+
+void switchMachine(benchmark::State& state)
+{
+    SwitchOrderMachine machine;
+    runEvents(state, machine);
+}
+
+void tableMachine(benchmark::State& state)
+{
+    StateMachine<TABLE> machine{OrderState::NEW};
+    runEvents(state, machine);
+}
+
+void tableMachineCounted(benchmark::State& state)
+{
+    StateMachine<TABLE, CountTransitions> machine{OrderState::NEW};
+    runEvents(state, machine);
+}
+
+void tableMachineTimed(benchmark::State& state)
+{
+    StateMachine<TABLE, TimeTransitions<>> machine{OrderState::NEW};
+    runEvents(state, machine);
+}
+
+BENCHMARK(switchMachine);
+BENCHMARK(tableMachine);
+BENCHMARK(tableMachineCounted);
+BENCHMARK(tableMachineTimed);
+
+}  // namespace zbo::bench
+
+BENCHMARK_MAIN();
@@ -0,0 +1,126 @@
+#include "state_machine.h"
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <vector>
+
+namespace zbo::test {
+
+ZBO_ENUM_CLASS(State, uint8_t, IDLE, CONNECTING, CONNECTED, CLOSED)
+ZBO_ENUM_CLASS(Event, uint8_t, CONNECT, ESTABLISHED, TIMEOUT, DISCONNECT)
+
+struct Connection
+{
+    std::vector<Event> log;
+    int attempts = 0;
+};
+
+void record(Connection& connection, Event event)
+{
+    connection.log.push_back(event);
+}
+
+void connect(Connection& connection, Event event)
+{
+    ++connection.attempts;
+    record(connection, event);
+}
+
+using Table = TransitionTable<State, Event, Connection>;
+
+constexpr Table TABLE{
+    {State::IDLE, Event::CONNECT, State::CONNECTING, &connect},
+    {State::CONNECTING, Event::ESTABLISHED, State::CONNECTED, &record},
+    {State::CONNECTING, Event::TIMEOUT, State::IDLE, &record},
+    {State::CONNECTED, Event::DISCONNECT, State::CLOSED},
+};
+
+static_assert(TABLE.handles(State::IDLE, Event::CONNECT));
+static_assert(!TABLE.handles(State::IDLE, Event::DISCONNECT));
+static_assert(!TABLE.handles(State::CLOSED, Event::CONNECT));
+static_assert(sizeof(StateMachine<TABLE>) == sizeof(uint32_t));
+
+TEST(StateMachine, Dispatch)
+{
+    Connection connection;
+    StateMachine<TABLE> machine{State::IDLE};
+    ASSERT_EQ(machine.state(), State::IDLE);
+
+    ASSERT_TRUE(machine.dispatch(connection, Event::CONNECT));
+    ASSERT_EQ(machine.state(), State::CONNECTING);
+    ASSERT_TRUE(machine.dispatch(connection, Event::TIMEOUT));
+    ASSERT_EQ(machine.state(), State::IDLE);
+    ASSERT_TRUE(machine.dispatch(connection, Event::CONNECT));
+    ASSERT_TRUE(machine.dispatch(connection, Event::ESTABLISHED));
+    ASSERT_EQ(machine.state(), State::CONNECTED);
+    ASSERT_TRUE(machine.dispatch(connection, Event::DISCONNECT));
+    ASSERT_EQ(machine.state(), State::CLOSED);
+
+    ASSERT_EQ(connection.attempts, 2);
+    ASSERT_EQ(connection.log,
+              (std::vector<Event>{Event::CONNECT, Event::TIMEOUT, Event::CONNECT, Event::ESTABLISHED}));
+}
+
+TEST(StateMachine, UnhandledEventKeepsState)
+{
+    Connection connection;
+    StateMachine<TABLE> machine{State::CONNECTED};
+    ASSERT_FALSE(machine.dispatch(connection, Event::CONNECT));
+    ASSERT_EQ(machine.state(), State::CONNECTED);
+    ASSERT_TRUE(connection.log.empty());
+
+    machine.reset(State::CLOSED);
+    for (auto event : {Event::CONNECT, Event::ESTABLISHED, Event::TIMEOUT, Event::DISCONNECT})
+    {
+        ASSERT_FALSE(machine.dispatch(connection, event));
+    }
+    ASSERT_EQ(machine.state(), State::CLOSED);
+}
+
+TEST(StateMachine, CountTransitions)
+{
+    Connection connection;
+    StateMachine<TABLE, CountTransitions> machine{State::IDLE};
+    for (int i = 0; i < 3; ++i)
+    {
+        machine.dispatch(connection, Event::CONNECT);
+        machine.dispatch(connection, Event::TIMEOUT);
+    }
+    machine.dispatch(connection, Event::DISCONNECT);
+
+    ASSERT_EQ(machine.transitionCount(State::IDLE, Event::CONNECT), 3);
+    ASSERT_EQ(machine.transitionCount(State::CONNECTING, Event::TIMEOUT), 3);
+    ASSERT_EQ(machine.transitionCount(State::CONNECTING, Event::ESTABLISHED), 0);
+    ASSERT_EQ(machine.transitionCount(State::IDLE, Event::DISCONNECT), 0);
+}
+
+struct ManualClock
+{
+    // NOLINTNEXTLINE (readability-identifier-naming)
+    using time_point = std::chrono::steady_clock::time_point;
+
+    static time_point now()
+    {
+        current += std::chrono::seconds(1);
+        return current;
+    }
+    static inline time_point current{};
+};
+
+TEST(StateMachine, TimeTransitions)
+{
+    Connection connection;
+    StateMachine<TABLE, TimeTransitions<ManualClock>> machine{State::IDLE};
+    machine.dispatch(connection, Event::CONNECT);
+    machine.dispatch(connection, Event::TIMEOUT);
+    machine.dispatch(connection, Event::CONNECT);
+
+    ASSERT_EQ(machine.transitionCount(State::IDLE, Event::CONNECT), 2);
+    // every action takes one tick of the manual clock
+    ASSERT_EQ(machine.transitionTime(State::IDLE, Event::CONNECT), std::chrono::seconds(2));
+    ASSERT_EQ(machine.transitionTime(State::CONNECTING, Event::TIMEOUT), std::chrono::seconds(1));
+    ASSERT_EQ(machine.transitionTime(State::CONNECTED, Event::DISCONNECT), std::chrono::seconds(0));
+}
+
+}  // namespace zbo::test
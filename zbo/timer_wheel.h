@@ -0,0 +1,383 @@
+// MIT License
+//
+// Copyright (c) 2020 Lenzebo
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include "contracts.h"
+#include "named_type.h"
+
+#include <array>
+#include <bit>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <utility>
+#include <vector>
+
+namespace zbo {
+
+/// identifies an armed timer of a TimerWheel, stays unique after the timer expired or got cancelled
+using TimerId = NamedType<uint64_t, struct TimerIdTag>;
+
+/**
+ * @brief Hierarchical timing wheel that arms, cancels and expires timers in O(1) without allocating.
+ *
+ * Time is divided into ticks of a fixed resolution. The wheel has 4 levels with 256 slots each, level l covering
+ * 256^(l + 1) ticks. Every slot holds an intrusive list of timers that expire in the range of ticks it covers, the slot
+ * index is the corresponding byte of the expiry tick, so the slots of a level are used circularly like a CircularRange
+ * whose offset is the current tick. Whenever the current tick enters a new range of a level, the timers of that slot
+ * are moved down to the lower levels (cascading). Timers further away than 2^32 ticks wait in an overflow list.
+ *
+ * All timer nodes come from a pool that is allocated once in the constructor. advance() expires all timers that are
+ * due in one call in the order of their expiry tick. It finds the next slot to cascade or expire with a bitmap of the
+ * occupied slots per level, so its cost does not depend on the number of ticks that passed.
+ *
+ * Usage:
+ *   TimerWheel<ConnectionId> timeouts(100'000, std::chrono::milliseconds(1));
+ *   const TimerId id = timeouts.armAfter(std::chrono::seconds(30), connection);
+ *   timeouts.cancel(id);
+ *   timeouts.advance([&](ConnectionId expired) { close(expired); });
+ *
+ * @tparam T payload of a timer, needs to be default constructible
+ * @tparam Clock clock with a static now() and a time_point type, e.g. any clock usable with StopWatchT
+ */
+template <typename T, typename Clock = std::chrono::steady_clock>
+class TimerWheel
+{
+  public:
+    using TimePoint = typename Clock::time_point;
+    using Duration = typename TimePoint::duration;
+
+    static constexpr size_t LEVELS = 4;
+    static constexpr size_t SLOT_BITS = 8;
+    static constexpr size_t SLOTS = size_t{1} << SLOT_BITS;
+
+    /**
+     * @param capacity maximum number of timers armed at the same time
+     * @param resolution length of a tick, timers expire at the first tick at or after their deadline
+     * @param start time of tick 0, deadlines before that expire with the next advance()
+     */
+    TimerWheel(size_t capacity, Duration resolution, TimePoint start = Clock::now())
+        : nodes_(capacity), resolution_(resolution), start_(start)
+    {
+        ZBO_PRECONDITION(capacity < NONE)
+        ZBO_PRECONDITION(resolution > Duration::zero())
+        heads_.fill(NONE);
+        // all nodes start in the free list
+        for (size_t idx = 0; idx < capacity; ++idx)
+        {
+            nodes_[idx].next = idx + 1 < capacity ? static_cast<uint32_t>(idx + 1) : NONE;
+        }
+        freeHead_ = capacity > 0 ? 0 : NONE;
+    }
+
+    [[nodiscard]] size_t size() const noexcept { return size_; }
+    [[nodiscard]] bool empty() const noexcept { return size_ == 0; }
+    [[nodiscard]] size_t capacity() const noexcept { return nodes_.size(); }
+    [[nodiscard]] Duration resolution() const noexcept { return resolution_; }
+    /// time up to which advance() has processed the timers
+    [[nodiscard]] TimePoint now() const noexcept
+    {
+        return start_ + resolution_ * static_cast<typename Duration::rep>(currentTick_);
+    }
+
+    /// arms a timer that expires with the first advance() at or after deadline
+    TimerId arm(TimePoint deadline, T payload)
+    {
+        ZBO_PRECONDITION(freeHead_ != NONE)
+        const uint32_t idx = freeHead_;
+        Node& node = nodes_[idx];
+        freeHead_ = node.next;
+
+        node.payload = std::move(payload);
+        // a tick that is already processed can only expire with the next one
+        node.expiry = std::max(deadlineTick(deadline), currentTick_ + 1);
+        link(idx);
+        ++size_;
+        return TimerId((uint64_t{node.generation} << 32U) | idx);
+    }
+
+    /// arms a timer that expires timeout after Clock::now()
+    TimerId armAfter(Duration timeout, T payload) { return arm(Clock::now() + timeout, std::move(payload)); }
+
+    /// returns whether the timer is neither expired nor cancelled yet
+    [[nodiscard]] bool isArmed(TimerId id) const noexcept
+    {
+        const auto idx = static_cast<uint32_t>(id.get());
+        return idx < nodes_.size() && nodes_[idx].list != FREE && nodes_[idx].generation == (id.get() >> 32U);
+    }
+
+    /// returns the payload of an armed timer
+    [[nodiscard]] const T& operator[](TimerId id) const
+    {
+        ZBO_PRECONDITION(isArmed(id))
+        return nodes_[static_cast<uint32_t>(id.get())].payload;
+    }
+
+    /// removes the timer without running the expiry callback, returns false if it was not armed (anymore)
+    bool cancel(TimerId id)
+    {
+        if (!isArmed(id))
+        {
+            return false;
+        }
+        const auto idx = static_cast<uint32_t>(id.get());
+        unlink(idx);
+        release(idx);
+        return true;
+    }
+
+    /**
+     * @brief expires all timers due until now in the order of their expiry tick
+     *
+     * onExpired is called with a reference to the payload of every expired timer. The timer is already released when
+     * it is called, so it may arm and cancel timers, including rearming the expired one.
+     *
+     * @return the number of expired timers
+     */
+    template <typename Callback>
+    size_t advance(TimePoint now, Callback&& onExpired)
+    {
+        const uint64_t target = nowTick(now);
+        size_t expired = 0;
+        while (currentTick_ < target)
+        {
+            // ticks without anything to cascade or to expire are skipped
+            const uint64_t next = nextEventTick();
+            if (next > target)
+            {
+                currentTick_ = target;
+                break;
+            }
+            currentTick_ = next;
+            cascade();
+            expired += expireSlot(onExpired);
+        }
+        return expired;
+    }
+
+    /// expires all timers due until Clock::now()
+    template <typename Callback>
+    size_t advance(Callback&& onExpired)
+    {
+        return advance(Clock::now(), std::forward<Callback>(onExpired));
+    }
+
+  private:
+    static constexpr uint32_t NONE = std::numeric_limits<uint32_t>::max();
+    /// list index of the timers further away than the top level covers
+    static constexpr uint16_t OVERFLOW_LIST = LEVELS * SLOTS;
+    /// list index of unused nodes
+    static constexpr uint16_t FREE = OVERFLOW_LIST + 1;
+    static constexpr size_t BITMAP_WORDS = SLOTS / 64;
+    static constexpr uint64_t NEVER = std::numeric_limits<uint64_t>::max();
+
+    struct Node
+    {
+        T payload{};
+        uint64_t expiry = 0;
+        uint32_t prev = NONE;
+        uint32_t next = NONE;
+        uint32_t generation = 0;
+        uint16_t list = FREE;
+    };
+
+    [[nodiscard]] uint64_t deadlineTick(TimePoint deadline) const noexcept
+    {
+        // rounds up, so a timer never expires before its deadline
+        const auto sinceStart = deadline - start_;
+        return sinceStart <= Duration::zero()
+                   ? 0
+                   : static_cast<uint64_t>((sinceStart + resolution_ - Duration(1)) / resolution_);
+    }
+
+    [[nodiscard]] uint64_t nowTick(TimePoint now) const noexcept
+    {
+        const auto sinceStart = now - start_;
+        return sinceStart <= Duration::zero() ? 0 : static_cast<uint64_t>(sinceStart / resolution_);
+    }
+
+    /// list a timer belongs to, which is given by the highest byte its expiry tick differs in from the current tick
+    [[nodiscard]] uint16_t listFor(uint64_t expiry) const noexcept
+    {
+        const uint64_t diff = expiry ^ currentTick_;
+        const size_t level = diff < SLOTS ? 0 : (std::bit_width(diff) - 1) / SLOT_BITS;
+        if (level >= LEVELS)
+        {
+            return OVERFLOW_LIST;
+        }
+        return static_cast<uint16_t>(level * SLOTS + ((expiry >> (level * SLOT_BITS)) & (SLOTS - 1)));
+    }
+
+    void link(uint32_t idx)
+    {
+        Node& node = nodes_[idx];
+        node.list = listFor(node.expiry);
+        node.prev = NONE;
+        node.next = heads_[node.list];
+        if (node.next != NONE)
+        {
+            nodes_[node.next].prev = idx;
+        }
+        heads_[node.list] = idx;
+        setOccupied(node.list, true);
+    }
+
+    void setOccupied(size_t list, bool occupied)
+    {
+        if (list == OVERFLOW_LIST)
+        {
+            return;
+        }
+        const uint64_t bit = uint64_t{1} << (list % 64);
+        occupied_[list / 64] = occupied ? (occupied_[list / 64] | bit) : (occupied_[list / 64] & ~bit);
+    }
+
+    void unlink(uint32_t idx)
+    {
+        Node& node = nodes_[idx];
+        if (node.prev != NONE)
+        {
+            nodes_[node.prev].next = node.next;
+        }
+        else
+        {
+            heads_[node.list] = node.next;
+            setOccupied(node.list, node.next != NONE);
+        }
+        if (node.next != NONE)
+        {
+            nodes_[node.next].prev = node.prev;
+        }
+    }
+
+    void release(uint32_t idx)
+    {
+        Node& node = nodes_[idx];
+        node.list = FREE;
+        ++node.generation;
+        node.next = freeHead_;
+        freeHead_ = idx;
+        --size_;
+    }
+
+    /// first occupied slot of level after slot or SLOTS if there is none
+    [[nodiscard]] size_t nextOccupiedSlot(size_t level, size_t slot) const noexcept
+    {
+        for (size_t next = slot + 1; next < SLOTS; next = (next / 64 + 1) * 64)
+        {
+            const uint64_t word = occupied_[(level * SLOTS + next) / 64] >> (next % 64);
+            if (word != 0)
+            {
+                return next + std::countr_zero(word);
+            }
+        }
+        return SLOTS;
+    }
+
+    /**
+     * @brief next tick at which a slot needs to be expired or cascaded or NEVER
+     *
+     * All timers of a level are in slots after the one of the current tick in the range of the level the current tick
+     * is in, as the slots before have been cascaded already. So for each level the next event is the start of the next
+     * occupied slot in that range.
+     */
+    [[nodiscard]] uint64_t nextEventTick() const noexcept
+    {
+        uint64_t next = NEVER;
+        for (size_t level = 0; level < LEVELS; ++level)
+        {
+            const size_t shift = level * SLOT_BITS;
+            const size_t slot = nextOccupiedSlot(level, (currentTick_ >> shift) & (SLOTS - 1));
+            if (slot < SLOTS)
+            {
+                const uint64_t rangeStart = currentTick_ & ~((uint64_t{1} << (shift + SLOT_BITS)) - 1);
+                next = std::min(next, rangeStart | (uint64_t{slot} << shift));
+            }
+        }
+        if (heads_[OVERFLOW_LIST] != NONE)
+        {
+            next = std::min(next, (currentTick_ | ((uint64_t{1} << (LEVELS * SLOT_BITS)) - 1)) + 1);
+        }
+        return next;
+    }
+
+    /// moves the timers of the slots the current tick just entered one or more levels down
+    void cascade()
+    {
+        if ((currentTick_ & ((uint64_t{1} << (LEVELS * SLOT_BITS)) - 1)) == 0)
+        {
+            relinkList(OVERFLOW_LIST);
+        }
+        // the higher levels first, as their timers may end up in the slots of the lower levels cascaded afterwards
+        for (size_t level = LEVELS - 1; level > 0; --level)
+        {
+            if ((currentTick_ & ((uint64_t{1} << (level * SLOT_BITS)) - 1)) == 0)
+            {
+                relinkList(level * SLOTS + ((currentTick_ >> (level * SLOT_BITS)) & (SLOTS - 1)));
+            }
+        }
+    }
+
+    void relinkList(size_t list)
+    {
+        uint32_t idx = std::exchange(heads_[list], NONE);
+        setOccupied(list, false);
+        while (idx != NONE)
+        {
+            const uint32_t next = nodes_[idx].next;
+            link(idx);
+            idx = next;
+        }
+    }
+
+    template <typename Callback>
+    size_t expireSlot(Callback& onExpired)
+    {
+        const size_t slot = currentTick_ & (SLOTS - 1);
+        size_t expired = 0;
+        // the head is taken one by one, as the callback may cancel other timers of the same slot
+        while (heads_[slot] != NONE)
+        {
+            const uint32_t idx = heads_[slot];
+            unlink(idx);
+            T payload = std::move(nodes_[idx].payload);
+            release(idx);
+            std::invoke(onExpired, payload);
+            ++expired;
+        }
+        return expired;
+    }
+
+    std::vector<Node> nodes_;
+    std::array<uint32_t, LEVELS * SLOTS + 1> heads_{};
+    /// one bit per slot of all levels, set if the slot holds timers
+    std::array<uint64_t, LEVELS * BITMAP_WORDS> occupied_{};
+    uint32_t freeHead_ = NONE;
+    size_t size_ = 0;
+    uint64_t currentTick_ = 0;
+    Duration resolution_;
+    TimePoint start_;
+};
+
+}  // namespace zbo
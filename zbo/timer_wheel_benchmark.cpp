@@ -0,0 +1,129 @@
+#include "timer_wheel.h"
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <map>
+#include <memory>
+#include <random>
+#include <type_traits>
+#include <vector>
+
+namespace zbo::bench {
+
+using Clock = std::chrono::steady_clock;
+using std::chrono::milliseconds;
+
+constexpr int64_t MIN_TIMERS = 1000;
+constexpr int64_t MAX_TIMERS = 1'000'000;
+constexpr int MULTIPLIER = 10;
+constexpr auto RESOLUTION = milliseconds(1);
+constexpr auto MAX_TIMEOUT = milliseconds(10'000);
+constexpr auto START = Clock::time_point{};
+
+/// the ordered timer set TimerWheel replaces, cancelling works through the iterator returned on arming
+class MultimapTimers
+{
+  public:
+    using Id = std::multimap<Clock::time_point, uint64_t>::iterator;
+
+    Id arm(Clock::time_point deadline, uint64_t payload) { return timers_.emplace(deadline, payload); }
+    void cancel(Id id) { timers_.erase(id); }
+
+    template <typename Callback>
+    size_t advance(Clock::time_point now, Callback&& onExpired)
+    {
+        size_t expired = 0;
+        // the callback may arm new timers, so the first one is checked again each time
+        while (!timers_.empty() && timers_.begin()->first <= now)
+        {
+            const uint64_t payload = timers_.begin()->second;
+            timers_.erase(timers_.begin());
+            onExpired(payload);
+            ++expired;
+        }
+        return expired;
+    }
+
+  private:
+    std::multimap<Clock::time_point, uint64_t> timers_;
+};
+
+using Wheel = TimerWheel<uint64_t, Clock>;
+
+std::vector<milliseconds> randomTimeouts(size_t size)
+{
+    std::mt19937_64 gen{42};
+    std::uniform_int_distribution<int64_t> dist(1, MAX_TIMEOUT.count());
+    std::vector<milliseconds> timeouts(size);
+    std::generate(timeouts.begin(), timeouts.end(), [&]() { return milliseconds(dist(gen)); });
+    return timeouts;
+}
+
+template <typename Timers>
+auto createTimers(size_t capacity)
+{
+    if constexpr (std::is_same_v<Timers, Wheel>)
+    {
+        return std::make_unique<Wheel>(capacity + 1, RESOLUTION, START);
+    }
+    else
+    {
+        return std::make_unique<Timers>();
+    }
+}
+
+/// connection timeouts that get reset on activity: range(0) timers are armed, one is cancelled and rearmed at a time
+template <typename Timers>
+void cancelRearm(benchmark::State& state)
+{
+    const auto timeouts = randomTimeouts(state.range(0));
+    auto timers = createTimers<Timers>(timeouts.size());
+    std::vector<decltype(timers->arm(START, 0))> ids;
+    ids.reserve(timeouts.size());
+    for (size_t idx = 0; idx < timeouts.size(); ++idx)
+    {
+        ids.push_back(timers->arm(START + timeouts[idx], idx));
+    }
+
+    std::mt19937 gen{42};
+    size_t timeoutIdx = 0;
+    for (auto _ : state)
+    {
+        const size_t idx = gen() % ids.size();
+        timers->cancel(ids[idx]);
+        ids[idx] = timers->arm(START + timeouts[timeoutIdx++ % timeouts.size()], idx);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+/// range(0) periodic timers: the time moves by one tick per iteration and all expired timers are rearmed
+template <typename Timers>
+void expireRearm(benchmark::State& state)
+{
+    const auto timeouts = randomTimeouts(state.range(0));
+    auto timers = createTimers<Timers>(timeouts.size());
+    for (size_t idx = 0; idx < timeouts.size(); ++idx)
+    {
+        timers->arm(START + timeouts[idx], idx);
+    }
+
+    auto now = START;
+    size_t expired = 0;
+    for (auto _ : state)
+    {
+        now += RESOLUTION;
+        expired += timers->advance(now, [&](uint64_t payload) { timers->arm(now + timeouts[payload], payload); });
+    }
+    // items are expired timers, the iterations are ticks
+    state.SetItemsProcessed(static_cast<int64_t>(expired));
+}
+
+BENCHMARK_TEMPLATE(cancelRearm, Wheel)->RangeMultiplier(MULTIPLIER)->Range(MIN_TIMERS, MAX_TIMERS);
+BENCHMARK_TEMPLATE(cancelRearm, MultimapTimers)->RangeMultiplier(MULTIPLIER)->Range(MIN_TIMERS, MAX_TIMERS);
+BENCHMARK_TEMPLATE(expireRearm, Wheel)->RangeMultiplier(MULTIPLIER)->Range(MIN_TIMERS, MAX_TIMERS);
+BENCHMARK_TEMPLATE(expireRearm, MultimapTimers)->RangeMultiplier(MULTIPLIER)->Range(MIN_TIMERS, MAX_TIMERS);
+
+}  // namespace zbo::bench
+
+BENCHMARK_MAIN();
@@ -0,0 +1,202 @@
+#include "timer_wheel.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <map>
+#include <random>
+#include <vector>
+
+namespace zbo::test {
+
+/// clock that only moves when the test says so
+class ManualClock
+{
+  public:
+    // NOLINTNEXTLINE (readability-identifier-naming)
+    using time_point = std::chrono::steady_clock::time_point;
+
+    static time_point now() { return current; }
+    static void set(std::chrono::nanoseconds sinceStart) { current = time_point{} + sinceStart; }
+
+  private:
+    static inline time_point current{};
+};
+
+using std::chrono::milliseconds;
+using std::chrono::nanoseconds;
+using std::chrono::seconds;
+using Wheel = TimerWheel<int, ManualClock>;
+
+constexpr auto START = ManualClock::time_point{};
+
+std::vector<int> advanceTo(Wheel& wheel, nanoseconds sinceStart)
+{
+    std::vector<int> expired;
+    const size_t count = wheel.advance(START + sinceStart, [&](int payload) { expired.push_back(payload); });
+    EXPECT_EQ(count, expired.size());
+    return expired;
+}
+
+TEST(TimerWheel, ExpiresInDeadlineOrder)
+{
+    Wheel wheel(16, milliseconds(1), START);
+    wheel.arm(START + milliseconds(300), 3);
+    wheel.arm(START + milliseconds(5), 1);
+    wheel.arm(START + seconds(100), 4);
+    wheel.arm(START + milliseconds(7), 2);
+    ASSERT_EQ(wheel.size(), 4);
+
+    ASSERT_TRUE(advanceTo(wheel, milliseconds(4)).empty());
+    ASSERT_EQ(advanceTo(wheel, milliseconds(5)), std::vector<int>{1});
+    ASSERT_EQ(advanceTo(wheel, milliseconds(1000)), (std::vector<int>{2, 3}));
+    ASSERT_EQ(wheel.now(), START + milliseconds(1000));
+    ASSERT_EQ(advanceTo(wheel, seconds(100)), std::vector<int>{4});
+    ASSERT_TRUE(wheel.empty());
+}
+
+TEST(TimerWheel, DeadlinesAreRoundedUp)
+{
+    Wheel wheel(4, milliseconds(10), START);
+    wheel.arm(START + milliseconds(15), 1);
+    ASSERT_TRUE(advanceTo(wheel, milliseconds(19)).empty());
+    ASSERT_EQ(advanceTo(wheel, milliseconds(20)), std::vector<int>{1});
+
+    // deadlines in the past expire with the next tick
+    wheel.arm(START, 2);
+    ASSERT_TRUE(advanceTo(wheel, milliseconds(29)).empty());
+    ASSERT_EQ(advanceTo(wheel, milliseconds(30)), std::vector<int>{2});
+}
+
+TEST(TimerWheel, Cancel)
+{
+    Wheel wheel(4, milliseconds(1), START);
+    const TimerId first = wheel.arm(START + milliseconds(10), 1);
+    const TimerId second = wheel.arm(START + milliseconds(10), 2);
+    ASSERT_TRUE(wheel.isArmed(first));
+    ASSERT_EQ(wheel[second], 2);
+
+    ASSERT_TRUE(wheel.cancel(first));
+    ASSERT_FALSE(wheel.cancel(first));
+    ASSERT_FALSE(wheel.isArmed(first));
+    ASSERT_EQ(wheel.size(), 1);
+    ASSERT_EQ(advanceTo(wheel, milliseconds(10)), std::vector<int>{2});
+
+    // the node of an expired timer is reused, but the old id stays invalid
+    ASSERT_FALSE(wheel.isArmed(second));
+    const TimerId third = wheel.arm(START + milliseconds(20), 3);
+    ASSERT_NE(third.get(), second.get());
+    ASSERT_FALSE(wheel.cancel(second));
+    ASSERT_TRUE(wheel.isArmed(third));
+}
+
+TEST(TimerWheel, CallbackMayArmAndCancel)
+{
+    Wheel wheel(4, milliseconds(1), START);
+    const TimerId other = wheel.arm(START + milliseconds(5), 2);
+    wheel.arm(START + milliseconds(5), 1);
+
+    std::vector<int> expired;
+    const auto onExpired = [&](int payload) {
+        expired.push_back(payload);
+        wheel.cancel(other);
+        if (payload < 3)
+        {
+            wheel.arm(wheel.now() + milliseconds(2), payload + 10);
+        }
+    };
+    wheel.advance(START + milliseconds(10), onExpired);
+    // the rearmed timer expires within the same advance
+    ASSERT_EQ(expired, (std::vector<int>{1, 11}));
+    ASSERT_TRUE(wheel.empty());
+}
+
+TEST(TimerWheel, ArmAfterUsesClock)
+{
+    ManualClock::set(milliseconds(100));
+    Wheel wheel(4, milliseconds(1));
+    wheel.armAfter(milliseconds(50), 1);
+
+    ManualClock::set(milliseconds(149));
+    ASSERT_EQ(wheel.advance([](int /*payload*/) {}), 0);
+    ManualClock::set(milliseconds(150));
+    ASSERT_EQ(wheel.advance([](int /*payload*/) {}), 1);
+    ManualClock::set(nanoseconds(0));
+}
+
+TEST(TimerWheel, BeyondTopLevel)
+{
+    // with nanosecond ticks the levels cover about 4.3 seconds
+    Wheel wheel(4, nanoseconds(1), START);
+    wheel.arm(START + seconds(10), 2);
+    wheel.arm(START + seconds(3), 1);
+    ASSERT_EQ(advanceTo(wheel, seconds(5)), std::vector<int>{1});
+    ASSERT_TRUE(advanceTo(wheel, seconds(10) - nanoseconds(1)).empty());
+    ASSERT_EQ(advanceTo(wheel, seconds(10)), std::vector<int>{2});
+}
+
+TEST(TimerWheel, MatchesMultimap)
+{
+    std::mt19937_64 rng(42);  // NOLINT (cert-msc51-cpp) deterministic on purpose
+    // with 2ns ticks the levels cover about 8.6 seconds, so this spans all levels and the overflow list
+    std::uniform_int_distribution<int64_t> timeouts(0, 20'000'000'000);
+    std::uniform_int_distribution<int64_t> steps(0, 50'000'000);
+
+    Wheel wheel(2000, nanoseconds(2), START);
+    std::multimap<int64_t, int> reference;
+    std::map<int, int64_t> deadlines;
+    std::vector<std::pair<TimerId, int64_t>> ids;
+    int64_t now = 0;
+    for (int payload = 0; payload < 20'000; ++payload)
+    {
+        if (rng() % 4 != 0 && wheel.size() < wheel.capacity())
+        {
+            const int64_t deadline = now + 1 + timeouts(rng) / (1 + static_cast<int64_t>(rng() % 1000));
+            ids.emplace_back(wheel.arm(START + nanoseconds(deadline), payload), deadline);
+            reference.emplace(deadline, payload);
+            deadlines[payload] = deadline;
+        }
+        else if (rng() % 2 == 0 && !ids.empty())
+        {
+            const auto [id, deadline] = ids[rng() % ids.size()];
+            if (wheel.isArmed(id))
+            {
+                const int payloadOfId = wheel[id];
+                ASSERT_TRUE(wheel.cancel(id));
+                const auto [first, last] = reference.equal_range(deadline);
+                reference.erase(std::find_if(first, last, [&](const auto& kv) { return kv.second == payloadOfId; }));
+            }
+        }
+        else
+        {
+            now += steps(rng);
+            const auto expired = advanceTo(wheel, nanoseconds(now));
+            // timers expire in the order of their deadlines rounded up to full ticks
+            for (size_t idx = 1; idx < expired.size(); ++idx)
+            {
+                ASSERT_LE((deadlines[expired[idx - 1]] + 1) / 2, (deadlines[expired[idx]] + 1) / 2);
+            }
+            const auto lastDue = reference.upper_bound(now / 2 * 2);
+            std::vector<int> due;
+            for (auto it = reference.begin(); it != lastDue; ++it)
+            {
+                due.push_back(it->second);
+            }
+            reference.erase(reference.begin(), lastDue);
+            std::sort(due.begin(), due.end());
+            auto sortedExpired = expired;
+            std::sort(sortedExpired.begin(), sortedExpired.end());
+            ASSERT_EQ(sortedExpired, due);
+        }
+        ASSERT_EQ(wheel.size(), reference.size());
+    }
+}
+
+TEST(TimerWheelDeathTest, PoolExhausted)
+{
+    Wheel wheel(1, milliseconds(1), START);
+    wheel.arm(START + milliseconds(1), 1);
+    ASSERT_DEATH(wheel.arm(START + milliseconds(1), 2), "");
+}
+
+}  // namespace zbo::test
@@ -0,0 +1,558 @@
+// MIT License
+//
+// Copyright (c) 2020 Lenzebo
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#pragma once
+
+#include "cache_line.h"
+#include "contracts.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <optional>
+#include <span>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
+
+namespace zbo {
+namespace detail {
+
+/// hints the cpu that we are busy waiting, which saves power and frees resources for the sibling hyper thread
+inline void cpuRelax() noexcept
+{
+#if defined(__x86_64__) || defined(__i386__)
+    _mm_pause();
+#elif defined(__aarch64__)
+    asm volatile("yield");
+#endif
+}
+
+/// xorshift generator per thread, good enough to pick victims for stealing
+inline uint64_t threadLocalRandom() noexcept
+{
+    thread_local uint64_t state = std::hash<std::thread::id>{}(std::this_thread::get_id()) | 1U;
+    state ^= state << 13U;
+    state ^= state >> 7U;
+    state ^= state << 17U;
+    return state;
+}
+
+/**
+ * @brief Move-only callable without arguments that is stored inline instead of on the heap like in std::function
+ *
+ * The callable is destroyed right after it has been run, so a task can only be run once. Exceptions escaping the
+ * callable terminate the program.
+ *
+ * @tparam bytes maximum size of the callable
+ */
+template <size_t bytes>
+class InlineTask
+{
+  public:
+    InlineTask() = default;
+
+    template <typename F, typename Fn = std::decay_t<F>, typename = std::enable_if_t<!std::is_same_v<Fn, InlineTask>>>
+    explicit InlineTask(F&& function) : manage_(&manage<Fn>)
+    {
+        static_assert(sizeof(Fn) <= bytes, "callable does not fit into the task, capture less or increase taskBytes");
+        static_assert(alignof(Fn) <= alignof(std::max_align_t), "over-aligned callables are not supported");
+        static_assert(std::is_nothrow_move_constructible_v<Fn>, "callable needs to be nothrow move constructible");
+        new (storage_.data()) Fn(std::forward<F>(function));
+    }
+
+    InlineTask(InlineTask&& other) noexcept { moveFrom(other); }
+    InlineTask& operator=(InlineTask&& other) noexcept
+    {
+        if (this != &other)
+        {
+            reset();
+            moveFrom(other);
+        }
+        return *this;
+    }
+    InlineTask(const InlineTask&) = delete;
+    InlineTask& operator=(const InlineTask&) = delete;
+    ~InlineTask() { reset(); }
+
+    [[nodiscard]] explicit operator bool() const noexcept { return manage_ != nullptr; }
+
+    /// runs and destroys the callable, the task is empty afterwards
+    void operator()() noexcept
+    {
+        ZBO_PRECONDITION(manage_ != nullptr)
+        std::exchange(manage_, nullptr)(Operation::RUN, storage_.data(), nullptr);
+    }
+
+  private:
+    enum class Operation
+    {
+        RUN,
+        MOVE,
+        DESTROY
+    };
+    using Manager = void (*)(Operation, std::byte*, std::byte*) noexcept;
+
+    template <typename Fn>
+    static void manage(Operation operation, std::byte* self, std::byte* other) noexcept
+    {
+        auto* function = std::launder(reinterpret_cast<Fn*>(self));  // NOLINT (cppcoreguidelines-pro-type-*)
+        switch (operation)
+        {
+            case Operation::RUN:
+                (*function)();
+                function->~Fn();
+                break;
+            case Operation::MOVE:
+                new (other) Fn(std::move(*function));
+                function->~Fn();
+                break;
+            case Operation::DESTROY:
+                function->~Fn();
+                break;
+        }
+    }
+
+    void moveFrom(InlineTask& other) noexcept
+    {
+        if (other.manage_ != nullptr)
+        {
+            other.manage_(Operation::MOVE, other.storage_.data(), storage_.data());
+            manage_ = std::exchange(other.manage_, nullptr);
+        }
+    }
+
+    void reset() noexcept
+    {
+        if (manage_ != nullptr)
+        {
+            std::exchange(manage_, nullptr)(Operation::DESTROY, storage_.data(), nullptr);
+        }
+    }
+
+    alignas(std::max_align_t) std::array<std::byte, bytes> storage_{};
+    Manager manage_ = nullptr;
+};
+
+/**
+ * @brief Chase-Lev work stealing deque with a fixed capacity: the owning thread pushes and pops at the bottom, any
+ *        other thread steals from the top.
+ *
+ * Values live in preallocated slots. A thief claims a slot by advancing top and moves the value out afterwards, so
+ * every slot has a flag that keeps the owner from overwriting a value that is still being moved out. A push fails if
+ * the deque is full or the slot is still taken.
+ */
+template <typename T, size_t capacity>
+class ChaseLevDeque
+{
+    static_assert(capacity > 0 && (capacity & (capacity - 1)) == 0, "capacity needs to be a power of two");
+    static constexpr int64_t MASK = static_cast<int64_t>(capacity) - 1;
+
+  public:
+    /// owner only, does not move from value if it fails
+    bool tryPush(T&& value) noexcept
+    {
+        const int64_t bottom = bottom_.load(std::memory_order_relaxed);
+        const int64_t top = top_.load(std::memory_order_acquire);
+        Slot& slot = slots_[bottom & MASK];
+        if (bottom - top >= static_cast<int64_t>(capacity) || slot.full.load(std::memory_order_acquire))
+        {
+            return false;
+        }
+        slot.value = std::move(value);
+        slot.full.store(true, std::memory_order_relaxed);
+        bottom_.store(bottom + 1, std::memory_order_release);
+        return true;
+    }
+
+    /// owner only, takes the most recently pushed value
+    bool tryPop(T& value) noexcept
+    {
+        // seq_cst instead of fences, which thread sanitizer does not understand, is just as fast on x86
+        const int64_t bottom = bottom_.load(std::memory_order_relaxed) - 1;
+        bottom_.store(bottom, std::memory_order_seq_cst);
+        int64_t top = top_.load(std::memory_order_seq_cst);
+        if (top > bottom)
+        {
+            bottom_.store(bottom + 1, std::memory_order_release);
+            return false;
+        }
+        if (top == bottom)
+        {
+            // the last value, which a thief might claim at the same time
+            const bool won =
+                top_.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+            bottom_.store(bottom + 1, std::memory_order_release);
+            if (!won)
+            {
+                return false;
+            }
+        }
+        take(slots_[bottom & MASK], value);
+        return true;
+    }
+
+    /// any thread, takes the least recently pushed value
+    bool trySteal(T& value) noexcept
+    {
+        int64_t top = top_.load(std::memory_order_seq_cst);
+        const int64_t bottom = bottom_.load(std::memory_order_seq_cst);
+        if (top >= bottom ||
+            !top_.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+        {
+            return false;
+        }
+        take(slots_[top & MASK], value);
+        return true;
+    }
+
+    /// a snapshot that may be outdated as soon as it is returned
+    [[nodiscard]] bool empty() const noexcept
+    {
+        return top_.load(std::memory_order_acquire) >= bottom_.load(std::memory_order_acquire);
+    }
+
+  private:
+    struct Slot
+    {
+        std::atomic<bool> full{false};
+        T value{};
+    };
+
+    static void take(Slot& slot, T& value) noexcept
+    {
+        value = std::move(slot.value);
+        slot.full.store(false, std::memory_order_release);
+    }
+
+    alignas(CACHE_LINE_SIZE) std::atomic<int64_t> top_{0};
+    alignas(CACHE_LINE_SIZE) std::atomic<int64_t> bottom_{0};
+    alignas(CACHE_LINE_SIZE) std::array<Slot, capacity> slots_{};
+};
+
+}  // namespace detail
+
+/**
+ * @brief Thread pool where every worker owns a deque of tasks and idle workers steal from the others, which keeps
+ *        contention low when fanning out many small tasks, e.g. per tick.
+ *
+ * Tasks submitted from a worker go to the bottom of its own deque and are run LIFO by the worker, while idle workers
+ * steal the oldest tasks from a random victim. Tasks submitted from other threads go through a shared queue. Callables
+ * are stored inline in preallocated slots, so submitting never allocates. If a queue is full, the submitting thread
+ * runs the task itself. Idle workers spin for a while before they go to sleep, to pick up new work without the
+ * latency of a wakeup.
+ *
+ * parallelFor and parallelReduce split their range recursively into tasks, so most of the splitting happens on the
+ * workers and the calling thread helps running tasks until all are done. Calling them from within a task is fine.
+ *
+ * Usage:
+ *   WorkStealingExecutor<> executor(4);
+ *   executor.parallelFor(std::span(particles), [](Particle& particle) { particle.move(); });
+ *   const double energy = executor.parallelReduce(
+ *       std::span(particles), 0.0, [](const Particle& particle) { return particle.energy(); }, std::plus<>());
+ *
+ * @tparam dequeCapacity number of tasks per worker deque, needs to be a power of two
+ * @tparam taskBytes maximum size of a submitted callable
+ */
+template <size_t dequeCapacity = 256, size_t taskBytes = 48>
+class WorkStealingExecutor
+{
+  public:
+    using Task = detail::InlineTask<taskBytes>;
+
+    explicit WorkStealingExecutor(size_t numThreads = std::max(1U, std::thread::hardware_concurrency()))
+    {
+        ZBO_PRECONDITION(numThreads > 0)
+        for (size_t idx = 0; idx < numThreads; ++idx)
+        {
+            workers_.push_back(std::make_unique<Worker>());
+        }
+        for (auto& worker : workers_)
+        {
+            worker->thread = std::thread([this, worker = worker.get()]() { run(*worker); });
+        }
+    }
+    WorkStealingExecutor(const WorkStealingExecutor&) = delete;
+    WorkStealingExecutor& operator=(const WorkStealingExecutor&) = delete;
+
+    /// runs all tasks that have been submitted before stopping the workers
+    ~WorkStealingExecutor()
+    {
+        stop_.store(true, std::memory_order_seq_cst);
+        wakeEpoch_.fetch_add(1, std::memory_order_seq_cst);
+        wakeEpoch_.notify_all();
+        for (auto& worker : workers_)
+        {
+            worker->thread.join();
+        }
+    }
+
+    [[nodiscard]] size_t numThreads() const noexcept { return workers_.size(); }
+
+    /// runs function() on one of the workers, or right away on the calling thread if the queue is full
+    template <typename F>
+    void submit(F&& function)
+    {
+        Task task(std::forward<F>(function));
+        Worker* worker = currentWorker();
+        bool pushed = false;
+        if (worker != nullptr)
+        {
+            pushed = worker->deque.tryPush(std::move(task));
+        }
+        else
+        {
+            const std::lock_guard lock(injectedMutex_);
+            pushed = injected_.tryPush(std::move(task));
+        }
+        if (!pushed)
+        {
+            task();
+            return;
+        }
+        wakeOne();
+    }
+
+    /**
+     * @brief calls body(value) for every value and returns when all calls are done
+     *
+     * @param grainSize number of values that are processed by a single task, 0 picks a size so that every worker gets
+     *        a couple of tasks
+     */
+    template <typename T, typename F>
+    void parallelFor(std::span<T> values, F&& body, size_t grainSize = 0)
+    {
+        forEachChunk(values.size(), grainOf(values.size(), grainSize), [&values, &body](size_t begin, size_t end) {
+            for (size_t idx = begin; idx < end; ++idx)
+            {
+                body(values[idx]);
+            }
+        });
+    }
+
+    /**
+     * @brief returns reduce(...reduce(reduce(init, map(values[0])), map(values[1]))..., map(values[n - 1]))
+     *
+     * The values are reduced in chunks of grainSize in parallel, whose results are reduced in order on the calling
+     * thread. So reduce needs to be associative, but not commutative, and the result does not depend on the
+     * scheduling. The results of the chunks are kept in a vector, which is the only allocation.
+     */
+    template <typename T, typename R, typename Map, typename Reduce>
+    R parallelReduce(std::span<T> values, R init, Map&& map, Reduce&& reduce, size_t grainSize = 0)
+    {
+        const size_t grain = grainOf(values.size(), grainSize);
+        std::vector<std::optional<R>> results((values.size() + grain - 1) / grain);
+        forEachChunk(results.size(), 1, [&](size_t first, size_t last) {
+            for (size_t chunk = first; chunk < last; ++chunk)
+            {
+                const size_t end = std::min((chunk + 1) * grain, values.size());
+                R result = map(values[chunk * grain]);
+                for (size_t idx = chunk * grain + 1; idx < end; ++idx)
+                {
+                    result = reduce(std::move(result), map(values[idx]));
+                }
+                results[chunk].emplace(std::move(result));
+            }
+        });
+        for (auto& result : results)
+        {
+            init = reduce(std::move(init), std::move(*result));
+        }
+        return init;
+    }
+
+  private:
+    static constexpr size_t TASKS_PER_THREAD = 8;
+    static constexpr int SPIN_ROUNDS = 256;
+
+    struct alignas(CACHE_LINE_SIZE) Worker
+    {
+        detail::ChaseLevDeque<Task, dequeCapacity> deque;
+        std::thread thread;
+    };
+
+    struct CurrentWorker
+    {
+        const WorkStealingExecutor* executor = nullptr;
+        Worker* worker = nullptr;
+    };
+
+    /// shared by all tasks of a parallelFor, lives on the stack of the calling thread
+    template <typename ChunkFn>
+    struct ForState
+    {
+        ChunkFn* chunk = nullptr;
+        size_t grain = 1;
+        std::atomic<size_t> pending{1};
+    };
+
+    static inline thread_local CurrentWorker current_;
+
+    [[nodiscard]] Worker* currentWorker() const noexcept
+    {
+        return current_.executor == this ? current_.worker : nullptr;
+    }
+
+    [[nodiscard]] size_t grainOf(size_t count, size_t grainSize) const noexcept
+    {
+        return grainSize > 0 ? grainSize : std::max<size_t>(1, count / (numThreads() * TASKS_PER_THREAD));
+    }
+
+    template <typename ChunkFn>
+    void forEachChunk(size_t count, size_t grain, ChunkFn&& chunk)
+    {
+        if (count <= grain)
+        {
+            if (count > 0)
+            {
+                chunk(size_t{0}, count);
+            }
+            return;
+        }
+        using State = ForState<std::remove_reference_t<ChunkFn>>;
+        State state{&chunk, grain};
+        runRange(&state, 0, count);
+        Worker* self = currentWorker();
+        for (int idle = 0; state.pending.load(std::memory_order_acquire) != 0;)
+        {
+            if (tryRunOne(self))
+            {
+                idle = 0;
+            }
+            else if (++idle < SPIN_ROUNDS)
+            {
+                detail::cpuRelax();
+            }
+            else
+            {
+                std::this_thread::yield();
+            }
+        }
+    }
+
+    /// splits off the upper half of the range as a new task, until the rest is small enough to process it right away
+    template <typename State>
+    void runRange(State* state, size_t begin, size_t end)
+    {
+        while (end - begin > state->grain)
+        {
+            const size_t middle = begin + (end - begin) / 2;
+            state->pending.fetch_add(1, std::memory_order_relaxed);
+            submit([this, state, middle, end]() { runRange(state, middle, end); });
+            end = middle;
+        }
+        (*state->chunk)(begin, end);
+        state->pending.fetch_sub(1, std::memory_order_release);
+    }
+
+    bool tryRunOne(Worker* self)
+    {
+        Task task;
+        if ((self != nullptr && self->deque.tryPop(task)) || injected_.trySteal(task) || trySteal(self, task))
+        {
+            task();
+            return true;
+        }
+        return false;
+    }
+
+    bool trySteal(const Worker* self, Task& task)
+    {
+        const size_t start = detail::threadLocalRandom() % workers_.size();
+        for (size_t offset = 0; offset < workers_.size(); ++offset)
+        {
+            Worker& victim = *workers_[(start + offset) % workers_.size()];
+            if (&victim != self && victim.deque.trySteal(task))
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void wakeOne()
+    {
+        // both sides use a read-modify-write of sleeping_, so either the worker going to sleep sees the new task or we
+        // see the sleeping worker
+        if (sleeping_.fetch_add(0, std::memory_order_seq_cst) > 0)
+        {
+            wakeEpoch_.fetch_add(1, std::memory_order_seq_cst);
+            wakeEpoch_.notify_one();
+        }
+    }
+
+    void run(Worker& self)
+    {
+        current_ = CurrentWorker{this, &self};
+        while (true)
+        {
+            bool found = tryRunOne(&self);
+            for (int spin = 0; !found && spin < SPIN_ROUNDS; ++spin)
+            {
+                detail::cpuRelax();
+                found = tryRunOne(&self);
+            }
+            if (found)
+            {
+                continue;
+            }
+
+            const uint32_t epoch = wakeEpoch_.load(std::memory_order_seq_cst);
+            sleeping_.fetch_add(1, std::memory_order_seq_cst);
+            if (tryRunOne(&self))
+            {
+                sleeping_.fetch_sub(1, std::memory_order_seq_cst);
+                continue;
+            }
+            if (stop_.load(std::memory_order_seq_cst))
+            {
+                sleeping_.fetch_sub(1, std::memory_order_seq_cst);
+                return;
+            }
+            wakeEpoch_.wait(epoch, std::memory_order_seq_cst);
+            sleeping_.fetch_sub(1, std::memory_order_seq_cst);
+        }
+    }
+
+    std::vector<std::unique_ptr<Worker>> workers_;
+    /// tasks submitted by threads that are not workers, the mutex makes them a single producer
+    std::mutex injectedMutex_;
+    detail::ChaseLevDeque<Task, dequeCapacity> injected_;
+
+    alignas(CACHE_LINE_SIZE) std::atomic<uint32_t> wakeEpoch_{0};
+    std::atomic<uint32_t> sleeping_{0};
+    std::atomic<bool> stop_{false};
+};
+
+}  // namespace zbo
@@ -0,0 +1,185 @@
+#include "work_stealing_executor.h"
+
+#include <benchmark/benchmark.h>
+
+#include <cmath>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <numeric>
+#include <thread>
+#include <vector>
+
+namespace zbo::bench {
+
+constexpr size_t NUM_VALUES = 1 << 16;
+constexpr size_t FINE_GRAIN = 64;
+
+void work(double& value)
+{
+    for (int idx = 0; idx < 8; ++idx)
+    {
+        value = std::sqrt(value * 1.0001 + 1.0);
+    }
+}
+
+/// the classic thread pool that work stealing replaces: one queue of std::function behind a mutex and a condvar
+class SingleQueuePool
+{
+  public:
+    explicit SingleQueuePool(size_t numThreads)
+    {
+        for (size_t idx = 0; idx < numThreads; ++idx)
+        {
+            threads_.emplace_back([this]() { run(); });
+        }
+    }
+    SingleQueuePool(const SingleQueuePool&) = delete;
+    SingleQueuePool& operator=(const SingleQueuePool&) = delete;
+    ~SingleQueuePool()
+    {
+        {
+            const std::lock_guard lock(mutex_);
+            stop_ = true;
+        }
+        wakeup_.notify_all();
+        for (auto& thread : threads_)
+        {
+            thread.join();
+        }
+    }
+
+    void parallelFor(std::span<double> values, size_t grain)
+    {
+        size_t pending = (values.size() + grain - 1) / grain;
+        std::mutex doneMutex;
+        std::condition_variable done;
+        {
+            const std::lock_guard lock(mutex_);
+            for (size_t begin = 0; begin < values.size(); begin += grain)
+            {
+                tasks_.emplace_back([&, begin]() {
+                    for (size_t idx = begin; idx < std::min(begin + grain, values.size()); ++idx)
+                    {
+                        work(values[idx]);
+                    }
+                    const std::lock_guard doneLock(doneMutex);
+                    if (--pending == 0)
+                    {
+                        done.notify_one();
+                    }
+                });
+            }
+        }
+        wakeup_.notify_all();
+        std::unique_lock lock(doneMutex);
+        done.wait(lock, [&pending]() { return pending == 0; });
+    }
+
+  private:
+    void run()
+    {
+        while (true)
+        {
+            std::function<void()> task;
+            {
+                std::unique_lock lock(mutex_);
+                wakeup_.wait(lock, [this]() { return stop_ || !tasks_.empty(); });
+                if (tasks_.empty())
+                {
+                    return;
+                }
+                task = std::move(tasks_.front());
+                tasks_.pop_front();
+            }
+            task();
+        }
+    }
+
+    std::mutex mutex_;
+    std::condition_variable wakeup_;
+    std::deque<std::function<void()>> tasks_;
+    bool stop_ = false;
+    std::vector<std::thread> threads_;
+};
+
+void stdAsync(benchmark::State& state)
+{
+    const auto numThreads = static_cast<size_t>(state.range(0));
+    std::vector<double> values(NUM_VALUES, 1.0);
+    for (auto _ : state)
+    {
+        // one chunk per thread, as starting a thread per fine grained chunk is out of question
+        std::vector<std::future<void>> futures;
+        const size_t chunk = (values.size() + numThreads - 1) / numThreads;
+        for (size_t begin = 0; begin < values.size(); begin += chunk)
+        {
+            futures.push_back(std::async(std::launch::async, [&values, begin, chunk]() {
+                for (size_t idx = begin; idx < std::min(begin + chunk, values.size()); ++idx)
+                {
+                    work(values[idx]);
+                }
+            }));
+        }
+        for (auto& future : futures)
+        {
+            future.wait();
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * NUM_VALUES);
+}
+
+template <size_t grain>
+void singleQueuePool(benchmark::State& state)
+{
+    SingleQueuePool pool(static_cast<size_t>(state.range(0)));
+    std::vector<double> values(NUM_VALUES, 1.0);
+    const size_t chunk = grain > 0 ? grain : NUM_VALUES / (state.range(0) * 8);
+    for (auto _ : state)
+    {
+        pool.parallelFor(std::span(values), chunk);
+    }
+    state.SetItemsProcessed(state.iterations() * NUM_VALUES);
+}
+
+template <size_t grain>
+void workStealing(benchmark::State& state)
+{
+    WorkStealingExecutor<> executor(static_cast<size_t>(state.range(0)));
+    std::vector<double> values(NUM_VALUES, 1.0);
+    for (auto _ : state)
+    {
+        executor.parallelFor(std::span(values), work, grain);
+    }
+    state.SetItemsProcessed(state.iterations() * NUM_VALUES);
+}
+
+void workStealingReduce(benchmark::State& state)
+{
+    WorkStealingExecutor<> executor(static_cast<size_t>(state.range(0)));
+    std::vector<double> values(NUM_VALUES, 1.0);
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(executor.parallelReduce(
+            std::span(values), 0.0, [](double value) { return std::sqrt(value); }, std::plus<>()));
+    }
+    state.SetItemsProcessed(state.iterations() * NUM_VALUES);
+}
+
+const auto MAX_THREADS = static_cast<int64_t>(std::max(1U, std::thread::hardware_concurrency()));
+
+BENCHMARK(stdAsync)->RangeMultiplier(2)->Range(1, MAX_THREADS)->UseRealTime();
+BENCHMARK_TEMPLATE(singleQueuePool, 0)->RangeMultiplier(2)->Range(1, MAX_THREADS)->UseRealTime();
+BENCHMARK_TEMPLATE(workStealing, 0)->RangeMultiplier(2)->Range(1, MAX_THREADS)->UseRealTime();
+
+// many small tasks, where the scheduling overhead dominates
+BENCHMARK_TEMPLATE(singleQueuePool, FINE_GRAIN)->RangeMultiplier(2)->Range(1, MAX_THREADS)->UseRealTime();
+BENCHMARK_TEMPLATE(workStealing, FINE_GRAIN)->RangeMultiplier(2)->Range(1, MAX_THREADS)->UseRealTime();
+
+BENCHMARK(workStealingReduce)->RangeMultiplier(2)->Range(1, MAX_THREADS)->UseRealTime();
+
+}  // namespace zbo::bench
+
+BENCHMARK_MAIN();
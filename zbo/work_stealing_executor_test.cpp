@@ -0,0 +1,237 @@
+#include "work_stealing_executor.h"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <memory>
+#include <numeric>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace zbo::test {
+
+TEST(InlineTask, RunsAndDestroysCallableOnce)
+{
+    auto counter = std::make_shared<int>(0);
+    detail::InlineTask<32> task([counter]() { ++*counter; });
+    ASSERT_TRUE(task);
+    ASSERT_EQ(counter.use_count(), 2);
+
+    detail::InlineTask<32> moved(std::move(task));
+    ASSERT_FALSE(task);  // NOLINT (bugprone-use-after-move) checks the moved from state
+    moved();
+    ASSERT_FALSE(moved);
+    ASSERT_EQ(*counter, 1);
+    ASSERT_EQ(counter.use_count(), 1);
+
+    {
+        detail::InlineTask<32> neverRun([counter]() { ++*counter; });
+        ASSERT_EQ(counter.use_count(), 2);
+    }
+    ASSERT_EQ(counter.use_count(), 1);
+}
+
+TEST(ChaseLevDeque, OwnerIsLifoThiefIsFifo)
+{
+    detail::ChaseLevDeque<int, 4> deque;
+    int value = 0;
+    ASSERT_FALSE(deque.tryPop(value));
+    ASSERT_FALSE(deque.trySteal(value));
+    for (int idx = 1; idx <= 4; ++idx)
+    {
+        int pushed = idx;
+        ASSERT_TRUE(deque.tryPush(std::move(pushed)));
+    }
+    int overflow = 5;
+    ASSERT_FALSE(deque.tryPush(std::move(overflow)));
+
+    ASSERT_TRUE(deque.tryPop(value));
+    ASSERT_EQ(value, 4);
+    ASSERT_TRUE(deque.trySteal(value));
+    ASSERT_EQ(value, 1);
+    ASSERT_TRUE(deque.tryPop(value));
+    ASSERT_EQ(value, 3);
+    ASSERT_TRUE(deque.trySteal(value));
+    ASSERT_EQ(value, 2);
+    ASSERT_TRUE(deque.empty());
+}
+
+TEST(ChaseLevDeque, StressOwnerAgainstThieves)
+{
+    // every value needs to be taken exactly once, no matter who wins the races for it
+    constexpr int NUM_VALUES = 100'000;
+    constexpr int NUM_THIEVES = 3;
+    detail::ChaseLevDeque<int, 64> deque;
+    std::vector<std::atomic<int>> taken(NUM_VALUES);
+    std::atomic<bool> done{false};
+
+    std::vector<std::thread> thieves;
+    for (int thief = 0; thief < NUM_THIEVES; ++thief)
+    {
+        thieves.emplace_back([&]() {
+            int value = 0;
+            while (!done.load() || !deque.empty())
+            {
+                if (deque.trySteal(value))
+                {
+                    taken[value].fetch_add(1);
+                }
+                else
+                {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+
+    int value = 0;
+    for (int next = 0; next < NUM_VALUES;)
+    {
+        int pushed = next;
+        const bool full = !deque.tryPush(std::move(pushed));
+        next += full ? 0 : 1;
+        if ((full || next % 3 == 0) && deque.tryPop(value))
+        {
+            taken[value].fetch_add(1);
+        }
+    }
+    while (deque.tryPop(value))
+    {
+        taken[value].fetch_add(1);
+    }
+    done = true;
+    for (auto& thief : thieves)
+    {
+        thief.join();
+    }
+    for (int idx = 0; idx < NUM_VALUES; ++idx)
+    {
+        ASSERT_EQ(taken[idx].load(), 1) << idx;
+    }
+}
+
+TEST(WorkStealingExecutor, SubmitFromOutside)
+{
+    std::atomic<int> counter{0};
+    {
+        WorkStealingExecutor<> executor(2);
+        for (int idx = 0; idx < 1000; ++idx)
+        {
+            executor.submit([&counter]() { counter.fetch_add(1); });
+        }
+    }
+    // the destructor runs all submitted tasks
+    ASSERT_EQ(counter.load(), 1000);
+}
+
+TEST(WorkStealingExecutor, TasksSubmitTasks)
+{
+    std::atomic<int> counter{0};
+    {
+        WorkStealingExecutor<16> executor(4);
+        for (int idx = 0; idx < 10; ++idx)
+        {
+            executor.submit([&]() {
+                // overflows the small deques, so some tasks run inline
+                for (int task = 0; task < 100; ++task)
+                {
+                    executor.submit([&counter]() { counter.fetch_add(1); });
+                }
+            });
+        }
+    }
+    ASSERT_EQ(counter.load(), 1000);
+}
+
+TEST(WorkStealingExecutor, ParallelForVisitsEveryValueOnce)
+{
+    WorkStealingExecutor<> executor(4);
+    for (size_t size : {0, 1, 7, 1000, 100'000})
+    {
+        for (size_t grain : {0, 1, 64})
+        {
+            std::vector<int> values(size, 0);
+            executor.parallelFor(std::span(values), [](int& value) { ++value; }, grain);
+            ASSERT_EQ(std::count(values.begin(), values.end(), 1), size) << size << " " << grain;
+        }
+    }
+}
+
+TEST(WorkStealingExecutor, ParallelReduceKeepsOrder)
+{
+    WorkStealingExecutor<> executor(3);
+    std::vector<int> values(10'000);
+    std::iota(values.begin(), values.end(), 0);
+
+    const int64_t sum = executor.parallelReduce(
+        std::span<const int>(values), int64_t{0}, [](int value) { return int64_t{value}; }, std::plus<>());
+    ASSERT_EQ(sum, int64_t{9999} * 10'000 / 2);
+
+    // concatenation is associative but not commutative
+    const std::string digits = executor.parallelReduce(
+        std::span(values), std::string("x"), [](int value) { return std::to_string(value % 10); }, std::plus<>(), 7);
+    std::string expected = "x";
+    for (int value : values)
+    {
+        expected += std::to_string(value % 10);
+    }
+    ASSERT_EQ(digits, expected);
+
+    ASSERT_EQ(executor.parallelReduce(
+                  std::span<int>(), 42, [](int value) { return value; }, std::plus<>()),
+              42);
+}
+
+TEST(WorkStealingExecutor, NestedParallelFor)
+{
+    WorkStealingExecutor<> executor(4);
+    std::vector<std::vector<int>> rows(64, std::vector<int>(1000, 0));
+    executor.parallelFor(std::span(rows), [&executor](std::vector<int>& row) {
+        executor.parallelFor(std::span(row), [](int& value) { value += 2; });
+    });
+    for (const auto& row : rows)
+    {
+        ASSERT_EQ(std::accumulate(row.begin(), row.end(), 0), 2000);
+    }
+}
+
+TEST(WorkStealingExecutor, StressManyProducers)
+{
+    // external threads and workers submit at the same time while workers go to sleep and wake up again
+    std::atomic<int> counter{0};
+    {
+        WorkStealingExecutor<64> executor(4);
+        std::vector<std::thread> producers;
+        for (int producer = 0; producer < 4; ++producer)
+        {
+            producers.emplace_back([&]() {
+                for (int idx = 0; idx < 2000; ++idx)
+                {
+                    executor.submit([&]() {
+                        counter.fetch_add(1);
+                        executor.submit([&counter]() { counter.fetch_add(1); });
+                    });
+                    if (idx % 500 == 0)
+                    {
+                        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                    }
+                }
+            });
+        }
+        std::vector<int> values(10'000, 1);
+        for (int round = 0; round < 20; ++round)
+        {
+            const int sum =
+                executor.parallelReduce(std::span(values), 0, [](int value) { return value; }, std::plus<>());
+            ASSERT_EQ(sum, 10'000);
+        }
+        for (auto& producer : producers)
+        {
+            producer.join();
+        }
+    }
+    ASSERT_EQ(counter.load(), 4 * 2000 * 2);
+}
+
+}  // namespace zbo::test